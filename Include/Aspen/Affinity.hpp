@@ -0,0 +1,316 @@
+#ifndef ASPEN_AFFINITY_HPP
+#define ASPEN_AFFINITY_HPP
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Aspen/Error.hpp"
+#if defined WIN32
+  #include <windows.h>
+#elif defined (__linux__)
+  #include <linux/mempolicy.h>
+  #include <pthread.h>
+  #include <sched.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace Aspen {
+
+  /** Stores a set of CPU indices. */
+  class CpuSet {
+    public:
+
+      /** Constructs an empty CpuSet. */
+      CpuSet() = default;
+
+      /**
+       * Constructs a CpuSet.
+       * @param cpus The indices of the CPUs in the set.
+       */
+      CpuSet(std::initializer_list<int> cpus);
+
+      /** Returns <code>true</code> iff no CPUs are in this set. */
+      bool is_empty() const noexcept;
+
+      /** Returns the sorted indices of the CPUs in this set. */
+      const std::vector<int>& get_cpus() const noexcept;
+
+      /**
+       * Returns <code>true</code> iff a CPU is in this set.
+       * @param cpu The index of the CPU to test.
+       */
+      bool contains(int cpu) const noexcept;
+
+      /**
+       * Adds a CPU to this set.
+       * @param cpu The index of the CPU to add.
+       */
+      void add(int cpu);
+
+      /**
+       * Removes a CPU from this set.
+       * @param cpu The index of the CPU to remove.
+       */
+      void remove(int cpu);
+
+    private:
+      std::vector<int> m_cpus;
+  };
+
+  /**
+   * Specifies where a thread runs and where the memory it allocates resides.
+   * A default constructed ThreadAffinity leaves the thread unrestricted.
+   */
+  class ThreadAffinity {
+    public:
+
+      /** Constructs an unrestricted ThreadAffinity. */
+      ThreadAffinity() noexcept;
+
+      /**
+       * Constructs a ThreadAffinity that pins a thread to a set of CPUs.
+       * @param cpus The CPUs the thread may run on.
+       */
+      explicit ThreadAffinity(CpuSet cpus) noexcept;
+
+      /**
+       * Constructs a ThreadAffinity that pins a thread to a set of CPUs and
+       * allocates its memory from a NUMA node.
+       * @param cpus The CPUs the thread may run on.
+       * @param numa_node The NUMA node to allocate memory from, or -1 to use
+       *        the system's default policy.
+       */
+      ThreadAffinity(CpuSet cpus, int numa_node) noexcept;
+
+      /** Returns the CPUs the thread may run on, empty if unrestricted. */
+      const CpuSet& get_cpus() const noexcept;
+
+      /** Returns the NUMA node memory is allocated from, or -1. */
+      int get_numa_node() const noexcept;
+
+      /** Returns <code>true</code> iff this affinity places no restriction. */
+      bool is_unrestricted() const noexcept;
+
+    private:
+      CpuSet m_cpus;
+      int m_numa_node;
+  };
+
+  /**
+   * Returns the set of CPUs the calling thread may run on, or an empty set if
+   * the platform doesn't support querying it.
+   */
+  CpuSet get_thread_cpus();
+
+  /**
+   * Applies a ThreadAffinity to the calling thread. Pinning takes effect
+   * immediately, the memory policy applies to pages first touched after the
+   * call. The memory policy is left unchanged if the <i>affinity</i> has no
+   * NUMA node.
+   * @param affinity The affinity to apply.
+   */
+  void set_thread_affinity(const ThreadAffinity& affinity);
+
+  /**
+   * Applies a ThreadAffinity to the calling thread for the lifetime of the
+   * guard and restores the thread's original CPUs and memory policy
+   * afterwards.
+   */
+  class AffinityGuard {
+    public:
+
+      /**
+       * Constructs an AffinityGuard.
+       * @param affinity The affinity to apply.
+       */
+      explicit AffinityGuard(const ThreadAffinity& affinity);
+
+      ~AffinityGuard();
+
+    private:
+      bool m_is_applied;
+      ThreadAffinity m_previous;
+#if defined (__linux__)
+      int m_memory_mode;
+      unsigned long m_node_mask;
+#endif
+
+      AffinityGuard(const AffinityGuard&) = delete;
+      AffinityGuard& operator =(const AffinityGuard&) = delete;
+      void restore() noexcept;
+  };
+
+  inline CpuSet::CpuSet(std::initializer_list<int> cpus) {
+    for(auto cpu : cpus) {
+      add(cpu);
+    }
+  }
+
+  inline bool CpuSet::is_empty() const noexcept {
+    return m_cpus.empty();
+  }
+
+  inline const std::vector<int>& CpuSet::get_cpus() const noexcept {
+    return m_cpus;
+  }
+
+  inline bool CpuSet::contains(int cpu) const noexcept {
+    return std::binary_search(m_cpus.begin(), m_cpus.end(), cpu);
+  }
+
+  inline void CpuSet::add(int cpu) {
+    auto i = std::lower_bound(m_cpus.begin(), m_cpus.end(), cpu);
+    if(i == m_cpus.end() || *i != cpu) {
+      m_cpus.insert(i, cpu);
+    }
+  }
+
+  inline void CpuSet::remove(int cpu) {
+    auto i = std::lower_bound(m_cpus.begin(), m_cpus.end(), cpu);
+    if(i != m_cpus.end() && *i == cpu) {
+      m_cpus.erase(i);
+    }
+  }
+
+  inline ThreadAffinity::ThreadAffinity() noexcept
+    : m_numa_node(-1) {}
+
+  inline ThreadAffinity::ThreadAffinity(CpuSet cpus) noexcept
+    : ThreadAffinity(std::move(cpus), -1) {}
+
+  inline ThreadAffinity::ThreadAffinity(CpuSet cpus, int numa_node) noexcept
+    : m_cpus(std::move(cpus)),
+      m_numa_node(numa_node) {}
+
+  inline const CpuSet& ThreadAffinity::get_cpus() const noexcept {
+    return m_cpus;
+  }
+
+  inline int ThreadAffinity::get_numa_node() const noexcept {
+    return m_numa_node;
+  }
+
+  inline bool ThreadAffinity::is_unrestricted() const noexcept {
+    return m_cpus.is_empty() && m_numa_node == -1;
+  }
+
+  inline CpuSet get_thread_cpus() {
+    auto cpus = CpuSet();
+#if defined WIN32
+    auto process_mask = DWORD_PTR(0);
+    auto system_mask = DWORD_PTR(0);
+    if(::GetProcessAffinityMask(::GetCurrentProcess(), &process_mask,
+        &system_mask)) {
+      auto mask = ::SetThreadAffinityMask(::GetCurrentThread(), process_mask);
+      if(mask != 0) {
+        ::SetThreadAffinityMask(::GetCurrentThread(), mask);
+        for(auto cpu = 0; cpu != static_cast<int>(8 * sizeof(mask)); ++cpu) {
+          if(mask & (DWORD_PTR(1) << cpu)) {
+            cpus.add(cpu);
+          }
+        }
+      }
+    }
+#elif defined (__linux__)
+    auto set = cpu_set_t();
+    CPU_ZERO(&set);
+    if(::pthread_getaffinity_np(::pthread_self(), sizeof(set), &set) == 0) {
+      for(auto cpu = 0; cpu != CPU_SETSIZE; ++cpu) {
+        if(CPU_ISSET(cpu, &set)) {
+          cpus.add(cpu);
+        }
+      }
+    }
+#endif
+    return cpus;
+  }
+
+  inline void set_thread_affinity(const ThreadAffinity& affinity) {
+    auto& cpus = affinity.get_cpus().get_cpus();
+#if defined WIN32
+    if(!cpus.empty()) {
+      auto mask = DWORD_PTR(0);
+      for(auto cpu : cpus) {
+        if(cpu < 0 || cpu >= static_cast<int>(8 * sizeof(mask))) {
+          ASPEN_THROW(std::runtime_error("Invalid CPU index."));
+        }
+        mask |= DWORD_PTR(1) << cpu;
+      }
+      if(::SetThreadAffinityMask(::GetCurrentThread(), mask) == 0) {
+        ASPEN_THROW(std::runtime_error("Unable to set thread affinity."));
+      }
+    }
+#elif defined (__linux__)
+    if(!cpus.empty()) {
+      auto set = cpu_set_t();
+      CPU_ZERO(&set);
+      for(auto cpu : cpus) {
+        if(cpu < 0 || cpu >= CPU_SETSIZE) {
+          ASPEN_THROW(std::runtime_error("Invalid CPU index."));
+        }
+        CPU_SET(cpu, &set);
+      }
+      if(::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) != 0) {
+        ASPEN_THROW(std::runtime_error("Unable to set thread affinity."));
+      }
+    }
+    auto node = affinity.get_numa_node();
+    if(node < 0) {
+      return;
+    }
+    auto mask = static_cast<unsigned long>(0);
+    auto max_node = sizeof(mask) * 8;
+    if(node >= static_cast<int>(max_node)) {
+      ASPEN_THROW(std::runtime_error("Invalid NUMA node."));
+    }
+    mask = static_cast<unsigned long>(1) << node;
+    if(::syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask, max_node) != 0) {
+      ASPEN_THROW(std::runtime_error("Unable to set NUMA memory policy."));
+    }
+#endif
+  }
+
+  inline AffinityGuard::AffinityGuard(const ThreadAffinity& affinity)
+      : m_is_applied(!affinity.is_unrestricted()) {
+    if(m_is_applied) {
+      m_previous = ThreadAffinity(get_thread_cpus());
+#if defined (__linux__)
+      m_node_mask = 0;
+      if(::syscall(SYS_get_mempolicy, &m_memory_mode, &m_node_mask,
+          sizeof(m_node_mask) * 8, nullptr, 0) != 0) {
+        m_memory_mode = MPOL_DEFAULT;
+      }
+#endif
+      ASPEN_TRY {
+        set_thread_affinity(affinity);
+      } ASPEN_CATCH(...) {
+        restore();
+        ASPEN_RETHROW;
+      }
+    }
+  }
+
+  inline AffinityGuard::~AffinityGuard() {
+    if(m_is_applied) {
+      restore();
+    }
+  }
+
+  inline void AffinityGuard::restore() noexcept {
+    ASPEN_TRY {
+      set_thread_affinity(m_previous);
+    } ASPEN_CATCH(const std::exception&) {}
+#if defined (__linux__)
+    if(m_memory_mode == MPOL_DEFAULT) {
+      ::syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+    } else {
+      ::syscall(SYS_set_mempolicy, m_memory_mode, &m_node_mask,
+        sizeof(m_node_mask) * 8);
+    }
+#endif
+  }
+}
+
+#endif
@@ -1,43 +1,66 @@
 #ifndef ASPEN_HPP
 #define ASPEN_HPP
+#include "Aspen/Affinity.hpp"
+#include "Aspen/Batch.hpp"
 #include "Aspen/Box.hpp"
 #include "Aspen/Cell.hpp"
 #include "Aspen/Chain.hpp"
+#include "Aspen/CommitBudget.hpp"
 #include "Aspen/CommitHandler.hpp"
+#include "Aspen/CommitPool.hpp"
 #include "Aspen/Concat.hpp"
 #include "Aspen/Concur.hpp"
 #include "Aspen/Constant.hpp"
 #include "Aspen/Conversions.hpp"
+#include "Aspen/Coroutine.hpp"
 #include "Aspen/Count.hpp"
+#include "Aspen/DirtyGuard.hpp"
 #include "Aspen/Discard.hpp"
+#include "Aspen/EpollContext.hpp"
+#include "Aspen/EpollExecutor.hpp"
+#include "Aspen/Error.hpp"
+#include "Aspen/EvalPolicy.hpp"
 #include "Aspen/Executor.hpp"
+#include "Aspen/ExecutorPool.hpp"
+#include "Aspen/ExecutorStatistics.hpp"
 #include "Aspen/First.hpp"
+#include "Aspen/FlatGraph.hpp"
 #include "Aspen/Fold.hpp"
 #include "Aspen/Group.hpp"
 #include "Aspen/Last.hpp"
 #include "Aspen/Lift.hpp"
 #include "Aspen/LocalPtr.hpp"
 #include "Aspen/Maybe.hpp"
+#include "Aspen/MultiplexExecutor.hpp"
 #include "Aspen/MultiSync.hpp"
 #include "Aspen/None.hpp"
 #include "Aspen/Operators.hpp"
 #include "Aspen/Override.hpp"
+#include "Aspen/ParallelCommitHandler.hpp"
+#include "Aspen/ParallelLift.hpp"
 #include "Aspen/Perpetual.hpp"
 #include "Aspen/Proxy.hpp"
 #include "Aspen/Queue.hpp"
 #include "Aspen/Range.hpp"
+#include "Aspen/Sample.hpp"
 #include "Aspen/Shared.hpp"
+#include "Aspen/SharedPolicy.hpp"
+#include "Aspen/SimulatedExecutor.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/StateReactor.hpp"
 #include "Aspen/StaticCommitHandler.hpp"
 #include "Aspen/Switch.hpp"
 #include "Aspen/Sync.hpp"
 #include "Aspen/Throw.hpp"
+#include "Aspen/Timer.hpp"
+#include "Aspen/TimerWheel.hpp"
 #include "Aspen/Traits.hpp"
+#include "Aspen/Transaction.hpp"
 #include "Aspen/Trigger.hpp"
 #include "Aspen/Unconsecutive.hpp"
 #include "Aspen/Unique.hpp"
 #include "Aspen/Until.hpp"
+#include "Aspen/VariantBox.hpp"
 #include "Aspen/VectorSync.hpp"
 #include "Aspen/Weak.hpp"
 #include "Aspen/When.hpp"
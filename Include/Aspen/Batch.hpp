@@ -0,0 +1,193 @@
+#ifndef ASPEN_BATCH_HPP
+#define ASPEN_BATCH_HPP
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "Aspen/Error.hpp"
+#include "Aspen/Maybe.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/Traits.hpp"
+
+namespace Aspen {
+
+  /**
+   * A view over the evaluations a reactor produced within a single sequence,
+   * in the order they were produced. Evaluations that failed store their
+   * exception in place of a value.
+   *
+   * A batch-aware reactor provides, in addition to the reactor protocol:
+   *
+   *   State commit_batch(int sequence) noexcept;
+   *   Batch<Type> eval_batch() const;
+   *
+   * commit_batch commits the reactor, allowing it to evaluate to every value
+   * that is ready rather than only the next one. The returned State has an
+   * evaluation iff the batch is non-empty, eval() returns the last value in
+   * the batch, and eval_batch() remains valid until the next commit.
+   * Reactors that aren't batch-aware are committed one value at a time.
+   * Batching is opt-in: only sources that produce several values at once,
+   * and reactors that transform the batch of such a source, provide it.
+   * @param <T> The type of values in the batch.
+   */
+  template<typename T>
+  class Batch {
+    public:
+      using Type = T;
+
+      /** The type used to iterate over the evaluations. */
+      using Iterator = const Maybe<Type>*;
+
+      /** Constructs an empty Batch. */
+      Batch() noexcept;
+
+      /**
+       * Constructs a Batch.
+       * @param data A pointer to the first evaluation.
+       * @param size The number of evaluations.
+       */
+      Batch(const Maybe<Type>* data, std::size_t size) noexcept;
+
+      /** Returns <code>true</code> iff there are no evaluations. */
+      bool is_empty() const noexcept;
+
+      /** Returns the number of evaluations. */
+      std::size_t size() const noexcept;
+
+      /** Returns the evaluation at the specified index. */
+      const Maybe<Type>& operator [](std::size_t i) const noexcept;
+
+      /** Returns the last evaluation. */
+      const Maybe<Type>& back() const noexcept;
+
+      /** Returns an iterator to the first evaluation. */
+      Iterator begin() const noexcept;
+
+      /** Returns an iterator past the last evaluation. */
+      Iterator end() const noexcept;
+
+    private:
+      const Maybe<Type>* m_data;
+      std::size_t m_size;
+  };
+
+  /** Trait testing whether a reactor is batch-aware. */
+  template<typename R, typename=void>
+  struct is_batch_reactor : std::false_type {};
+
+  template<typename R>
+  struct is_batch_reactor<R, std::enable_if_t<std::is_same_v<
+    decltype(std::declval<R&>().commit_batch(std::declval<int>())), State> &&
+    std::is_same_v<decltype(std::declval<const R&>().eval_batch()),
+    Batch<typename R::Type>>>> : std::true_type {};
+
+  template<typename R>
+  constexpr auto is_batch_reactor_v = is_batch_reactor<R>::value;
+
+  /**
+   * Commits a reactor, evaluating to a batch if the reactor is batch-aware.
+   * @param reactor The reactor to commit.
+   * @param sequence The commit's sequence.
+   */
+  template<typename R>
+  State commit_batch(R& reactor, int sequence) noexcept {
+    if constexpr(is_batch_reactor_v<R>) {
+      return reactor.commit_batch(sequence);
+    } else {
+      return reactor.commit(sequence);
+    }
+  }
+
+namespace Details {
+
+  /** Adapts a batch-aware reactor so that commit goes through commit_batch. */
+  template<typename R>
+  struct BatchCommitter {
+    using Type = reactor_result_t<R>;
+    R m_reactor;
+
+    template<typename Q, typename = std::enable_if_t<
+      !std::is_base_of_v<BatchCommitter, std::decay_t<Q>>>>
+    explicit BatchCommitter(Q&& reactor);
+    State commit(int sequence) noexcept;
+    decltype(auto) eval() const;
+    Error get_error() const noexcept;
+  };
+
+  /**
+   * Returns a reactor that commits through commit_batch if the reactor is
+   * batch-aware, otherwise forwards the reactor unchanged.
+   * @param reactor The reactor to adapt.
+   */
+  template<typename R>
+  decltype(auto) commit_through_batch(R&& reactor) {
+    if constexpr(is_batch_reactor_v<std::decay_t<R>>) {
+      return BatchCommitter<std::decay_t<R>>(std::forward<R>(reactor));
+    } else {
+      return std::forward<R>(reactor);
+    }
+  }
+
+  template<typename R>
+  template<typename Q, typename>
+  BatchCommitter<R>::BatchCommitter(Q&& reactor)
+    : m_reactor(std::forward<Q>(reactor)) {}
+
+  template<typename R>
+  State BatchCommitter<R>::commit(int sequence) noexcept {
+    return m_reactor.commit_batch(sequence);
+  }
+
+  template<typename R>
+  decltype(auto) BatchCommitter<R>::eval() const {
+    return m_reactor.eval();
+  }
+
+  template<typename R>
+  Error BatchCommitter<R>::get_error() const noexcept {
+    return eval_error(m_reactor);
+  }
+}
+
+  template<typename T>
+  Batch<T>::Batch() noexcept
+    : m_data(nullptr),
+      m_size(0) {}
+
+  template<typename T>
+  Batch<T>::Batch(const Maybe<Type>* data, std::size_t size) noexcept
+    : m_data(data),
+      m_size(size) {}
+
+  template<typename T>
+  bool Batch<T>::is_empty() const noexcept {
+    return m_size == 0;
+  }
+
+  template<typename T>
+  std::size_t Batch<T>::size() const noexcept {
+    return m_size;
+  }
+
+  template<typename T>
+  const Maybe<typename Batch<T>::Type>& Batch<T>::operator [](
+      std::size_t i) const noexcept {
+    return m_data[i];
+  }
+
+  template<typename T>
+  const Maybe<typename Batch<T>::Type>& Batch<T>::back() const noexcept {
+    return m_data[m_size - 1];
+  }
+
+  template<typename T>
+  typename Batch<T>::Iterator Batch<T>::begin() const noexcept {
+    return m_data;
+  }
+
+  template<typename T>
+  typename Batch<T>::Iterator Batch<T>::end() const noexcept {
+    return m_data + m_size;
+  }
+}
+
+#endif
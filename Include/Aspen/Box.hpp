@@ -1,8 +1,11 @@
 #ifndef ASPEN_BOX_HPP
 #define ASPEN_BOX_HPP
-#include <memory>
+#include <cstddef>
+#include <new>
 #include <optional>
 #include <type_traits>
+#include <utility>
+#include "Aspen/EvalPolicy.hpp"
 #include "Aspen/Maybe.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
@@ -10,15 +13,22 @@
 namespace Aspen {
 
   /**
-   * Wraps a reactor within a generic interface.
+   * Wraps a reactor within a generic interface. Reactors small enough to fit
+   * in INLINE_SIZE bytes are stored within the Box itself, larger ones are
+   * allocated on the heap. The default size keeps a Box within a single
+   * 64 byte cache line.
    * @param <T> The type that the reactor evaluates to.
+   * @param <N> The number of bytes available to store a reactor inline.
    */
-  template<typename T>
+  template<typename T, std::size_t N = 48>
   class Box {
     public:
       using Type = T;
       using Result = eval_result_t<T>;
 
+      /** The number of bytes available to store a reactor inline. */
+      static constexpr std::size_t INLINE_SIZE = N;
+
       /**
        * Constructs a Box.
        * @param reactor The reactor to wrap.
@@ -27,40 +37,86 @@ namespace Aspen {
         !std::is_base_of_v<Box, std::decay_t<R>>>>
       explicit Box(R&& reactor);
 
+      /**
+       * Constructs a Box.
+       * @param reactor The reactor to wrap.
+       * @param policy Specifies when to copy the reactor's value if it
+       *        evaluates by value. LAZY behaves like CACHED since the copy
+       *        must outlive the call to eval.
+       */
+      template<typename R>
+      Box(R&& reactor, EvalPolicy policy);
+
+      Box(Box&& box) noexcept;
+
+      ~Box();
+
       State commit(int sequence) noexcept;
 
       Result eval() const;
 
+      /** Returns the error this reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
+      Box& operator =(Box&& box) noexcept;
+
     private:
-      struct BaseWrapper {
-        virtual ~BaseWrapper() = default;
-        virtual State commit(int sequence) noexcept = 0;
-        virtual Result eval() const = 0;
+      struct VTable {
+        State (*m_commit)(void* wrapper, int sequence) noexcept;
+        Result (*m_eval)(const void* wrapper);
+        Error (*m_get_error)(const void* wrapper) noexcept;
+        void (*m_move)(void* source, void* destination) noexcept;
+        void (*m_destroy)(void* wrapper) noexcept;
       };
+      template<typename W>
+      static constexpr auto is_inline = sizeof(W) <= INLINE_SIZE &&
+        alignof(W) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<W>;
+      template<typename W>
+      struct Operations {
+        static W& get(void* wrapper) noexcept;
+        static const W& get(const void* wrapper) noexcept;
+        static State commit(void* wrapper, int sequence) noexcept;
+        static Result eval(const void* wrapper);
+        static Error get_error(const void* wrapper) noexcept;
+        static void move(void* source, void* destination) noexcept;
+        static void destroy(void* wrapper) noexcept;
+      };
+      template<typename W>
+      static constexpr VTable VTABLE = { &Operations<W>::commit,
+        &Operations<W>::eval, &Operations<W>::get_error,
+        &Operations<W>::move, &Operations<W>::destroy };
       template<typename R>
-      struct ByReferenceWrapper final : BaseWrapper {
+      struct ByReferenceWrapper {
         R m_reactor;
 
         template<typename Q, typename = std::enable_if_t<
           !std::is_base_of_v<ByReferenceWrapper, std::decay_t<Q>>>>
         ByReferenceWrapper(Q&& reactor);
-        State commit(int sequence) noexcept override;
-        Result eval() const override;
+        State commit(int sequence) noexcept;
+        Result eval() const;
+        Error get_error() const noexcept;
       };
       template<typename R>
-      struct ByValueWrapper final : BaseWrapper {
+      struct ByValueWrapper {
         static constexpr auto is_noexcept = is_noexcept_reactor_v<R>;
         R m_reactor;
-        std::conditional_t<is_noexcept, std::optional<Type>, Maybe<Type>>
-          m_value;
+        EvalPolicy m_policy;
+        Details::EvalCache<Type, is_noexcept> m_value;
 
-        template<typename Q, typename = std::enable_if_t<
-          !std::is_base_of_v<ByValueWrapper, std::decay_t<Q>>>>
-        ByValueWrapper(Q&& reactor);
-        State commit(int sequence) noexcept override;
-        Result eval() const override;
+        template<typename Q>
+        ByValueWrapper(Q&& reactor, EvalPolicy policy);
+        void update(State state) noexcept;
+        State commit(int sequence) noexcept;
+        Result eval() const;
+        Error get_error() const noexcept;
       };
-      std::unique_ptr<BaseWrapper> m_reactor;
+      const VTable* m_vtable;
+      alignas(std::max_align_t) unsigned char m_storage[INLINE_SIZE];
+
+      template<typename W, typename... A>
+      void emplace(A&&... args);
+      void reset() noexcept;
   };
 
   template<typename R, typename = std::enable_if_t<
@@ -68,6 +124,9 @@ namespace Aspen {
     std::decay_t<R>>>>
   Box(R&& reactor) -> Box<reactor_result_t<to_reactor_t<R>>>;
 
+  template<typename R>
+  Box(R&& reactor, EvalPolicy) -> Box<reactor_result_t<to_reactor_t<R>>>;
+
   /**
    * Boxes a reactor into a generic interface.
    * @param reactor The reactor to wrap.
@@ -77,45 +136,170 @@ namespace Aspen {
     return Box(std::forward<R>(reactor));
   }
 
-  template<typename T>
+  /**
+   * Boxes a reactor into a generic interface.
+   * @param reactor The reactor to wrap.
+   * @param policy Specifies when to copy the reactor's value.
+   */
+  template<typename R>
+  auto box(R&& reactor, EvalPolicy policy) {
+    return Box(std::forward<R>(reactor), policy);
+  }
+
+  template<typename T, std::size_t N>
   template<typename R, typename>
-  Box<T>::Box(R&& reactor) {
+  Box<T, N>::Box(R&& reactor)
+    : Box(std::forward<R>(reactor), EvalPolicy::EAGER) {}
+
+  template<typename T, std::size_t N>
+  template<typename R>
+  Box<T, N>::Box(R&& reactor, EvalPolicy policy)
+      : m_vtable(nullptr) {
     using Reactor = to_reactor_t<R>;
     if constexpr(std::is_same_v<Type, void> || std::is_reference_v<
         decltype(std::declval<Reactor>().eval())>) {
-      m_reactor = std::make_unique<ByReferenceWrapper<Reactor>>(
-        std::forward<R>(reactor));
+      emplace<ByReferenceWrapper<Reactor>>(std::forward<R>(reactor));
     } else {
-      m_reactor = std::make_unique<ByValueWrapper<Reactor>>(
-        std::forward<R>(reactor));
+      emplace<ByValueWrapper<Reactor>>(std::forward<R>(reactor), policy);
+    }
+  }
+
+  template<typename T, std::size_t N>
+  Box<T, N>::Box(Box&& box) noexcept
+      : m_vtable(box.m_vtable) {
+    if(m_vtable) {
+      m_vtable->m_move(box.m_storage, m_storage);
+      box.m_vtable = nullptr;
     }
   }
 
-  template<typename T>
-  State Box<T>::commit(int sequence) noexcept {
-    return m_reactor->commit(sequence);
+  template<typename T, std::size_t N>
+  Box<T, N>::~Box() {
+    reset();
+  }
+
+  template<typename T, std::size_t N>
+  State Box<T, N>::commit(int sequence) noexcept {
+    return m_vtable->m_commit(m_storage, sequence);
+  }
+
+  template<typename T, std::size_t N>
+  typename Box<T, N>::Result Box<T, N>::eval() const {
+    return m_vtable->m_eval(m_storage);
+  }
+
+  template<typename T, std::size_t N>
+  Error Box<T, N>::get_error() const noexcept {
+    return m_vtable->m_get_error(m_storage);
+  }
+
+  template<typename T, std::size_t N>
+  Box<T, N>& Box<T, N>::operator =(Box&& box) noexcept {
+    if(this == &box) {
+      return *this;
+    }
+    reset();
+    if(box.m_vtable) {
+      box.m_vtable->m_move(box.m_storage, m_storage);
+      m_vtable = box.m_vtable;
+      box.m_vtable = nullptr;
+    }
+    return *this;
   }
 
-  template<typename T>
-  typename Box<T>::Result Box<T>::eval() const {
-    return m_reactor->eval();
+  template<typename T, std::size_t N>
+  template<typename W, typename... A>
+  void Box<T, N>::emplace(A&&... args) {
+    if constexpr(is_inline<W>) {
+      new(m_storage) W(std::forward<A>(args)...);
+    } else {
+      new(m_storage) W*(new W(std::forward<A>(args)...));
+    }
+    m_vtable = &VTABLE<W>;
   }
 
-  template<typename T>
+  template<typename T, std::size_t N>
+  void Box<T, N>::reset() noexcept {
+    if(m_vtable) {
+      m_vtable->m_destroy(m_storage);
+      m_vtable = nullptr;
+    }
+  }
+
+  template<typename T, std::size_t N>
+  template<typename W>
+  W& Box<T, N>::Operations<W>::get(void* wrapper) noexcept {
+    if constexpr(is_inline<W>) {
+      return *std::launder(static_cast<W*>(wrapper));
+    } else {
+      return **std::launder(static_cast<W**>(wrapper));
+    }
+  }
+
+  template<typename T, std::size_t N>
+  template<typename W>
+  const W& Box<T, N>::Operations<W>::get(const void* wrapper) noexcept {
+    return get(const_cast<void*>(wrapper));
+  }
+
+  template<typename T, std::size_t N>
+  template<typename W>
+  State Box<T, N>::Operations<W>::commit(void* wrapper,
+      int sequence) noexcept {
+    return get(wrapper).commit(sequence);
+  }
+
+  template<typename T, std::size_t N>
+  template<typename W>
+  typename Box<T, N>::Result Box<T, N>::Operations<W>::eval(
+      const void* wrapper) {
+    return get(wrapper).eval();
+  }
+
+  template<typename T, std::size_t N>
+  template<typename W>
+  Error Box<T, N>::Operations<W>::get_error(const void* wrapper) noexcept {
+    return get(wrapper).get_error();
+  }
+
+  template<typename T, std::size_t N>
+  template<typename W>
+  void Box<T, N>::Operations<W>::move(void* source,
+      void* destination) noexcept {
+    if constexpr(is_inline<W>) {
+      auto& wrapper = get(source);
+      new(destination) W(std::move(wrapper));
+      wrapper.~W();
+    } else {
+      new(destination) W*(&get(source));
+    }
+  }
+
+  template<typename T, std::size_t N>
+  template<typename W>
+  void Box<T, N>::Operations<W>::destroy(void* wrapper) noexcept {
+    if constexpr(is_inline<W>) {
+      get(wrapper).~W();
+    } else {
+      delete &get(wrapper);
+    }
+  }
+
+  template<typename T, std::size_t N>
   template<typename R>
   template<typename Q, typename>
-  Box<T>::ByReferenceWrapper<R>::ByReferenceWrapper(Q&& reactor)
+  Box<T, N>::ByReferenceWrapper<R>::ByReferenceWrapper(Q&& reactor)
     : m_reactor(std::forward<Q>(reactor)) {}
 
-  template<typename T>
+  template<typename T, std::size_t N>
   template<typename R>
-  State Box<T>::ByReferenceWrapper<R>::commit(int sequence) noexcept {
+  State Box<T, N>::ByReferenceWrapper<R>::commit(int sequence) noexcept {
     return m_reactor.commit(sequence);
   }
 
-  template<typename T>
+  template<typename T, std::size_t N>
   template<typename R>
-  typename Box<T>::Result Box<T>::ByReferenceWrapper<R>::eval() const {
+  typename Box<T, N>::Result Box<T, N>::ByReferenceWrapper<R>::eval() const {
     if constexpr(std::is_same_v<Result, void>) {
       m_reactor.eval();
     } else {
@@ -123,30 +307,65 @@ namespace Aspen {
     }
   }
 
-  template<typename T>
+  template<typename T, std::size_t N>
   template<typename R>
-  template<typename Q, typename>
-  Box<T>::ByValueWrapper<R>::ByValueWrapper(Q&& reactor)
-    : m_reactor(std::forward<Q>(reactor)) {}
+  Error Box<T, N>::ByReferenceWrapper<R>::get_error() const noexcept {
+    if constexpr(has_error_v<R>) {
+      return m_reactor.get_error();
+    } else {
+      return Error();
+    }
+  }
 
-  template<typename T>
+  template<typename T, std::size_t N>
   template<typename R>
-  State Box<T>::ByValueWrapper<R>::commit(int sequence) noexcept {
-    auto state = m_reactor.commit(sequence);
-    if(has_evaluation(state)) {
-      m_value = try_call(
+  template<typename Q>
+  Box<T, N>::ByValueWrapper<R>::ByValueWrapper(Q&& reactor, EvalPolicy policy)
+    : m_reactor(std::forward<Q>(reactor)),
+      m_policy(policy) {}
+
+  template<typename T, std::size_t N>
+  template<typename R>
+  void Box<T, N>::ByValueWrapper<R>::update(State state) noexcept {
+    if(!has_evaluation(state)) {
+      return;
+    }
+    if(m_policy == EvalPolicy::EAGER) {
+      if constexpr(!is_noexcept) {
+        if(auto error = eval_error(m_reactor)) {
+          m_value.set_error(std::move(error));
+          return;
+        }
+      }
+      m_value.update(
         [&] () noexcept(is_noexcept) { return m_reactor.eval(); });
+    } else {
+      m_value.invalidate();
     }
+  }
+
+  template<typename T, std::size_t N>
+  template<typename R>
+  State Box<T, N>::ByValueWrapper<R>::commit(int sequence) noexcept {
+    auto state = m_reactor.commit(sequence);
+    update(state);
     return state;
   }
 
-  template<typename T>
+  template<typename T, std::size_t N>
   template<typename R>
-  typename Box<T>::Result Box<T>::ByValueWrapper<R>::eval() const {
-    if constexpr(std::is_same_v<Result, void>) {
-      m_value.get();
+  typename Box<T, N>::Result Box<T, N>::ByValueWrapper<R>::eval() const {
+    return m_value.get(
+      [&] () noexcept(is_noexcept) { return m_reactor.eval(); });
+  }
+
+  template<typename T, std::size_t N>
+  template<typename R>
+  Error Box<T, N>::ByValueWrapper<R>::get_error() const noexcept {
+    if constexpr(has_error_v<R>) {
+      return m_reactor.get_error();
     } else {
-      return *m_value;
+      return Error();
     }
   }
 }
@@ -1,10 +1,13 @@
 #ifndef ASPEN_CELL_HPP
 #define ASPEN_CELL_HPP
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <utility>
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
+#include "Aspen/Transaction.hpp"
 #include "Aspen/Trigger.hpp"
 
 namespace Aspen {
@@ -78,53 +81,68 @@ namespace Aspen {
       Cell& operator =(Cell&& cell);
 
     private:
+      friend class Transaction;
       std::mutex m_mutex;
       bool m_is_complete;
       std::optional<Type> m_current;
       std::optional<Type> m_next;
+      std::deque<Details::StagedValue<Type>> m_staged;
       Trigger* m_trigger;
+      int m_sequence;
+
+      void update(Type value);
+      void stage(const std::shared_ptr<Details::TransactionState>& transaction,
+        Type value);
+      Trigger* load_trigger();
   };
 
   template<typename T>
   Cell<T>::Cell()
     : m_is_complete(false),
-      m_trigger(nullptr) {}
+      m_trigger(nullptr),
+      m_sequence(-1) {}
 
   template<typename T>
   Cell<T>::Cell(Type value)
     : m_is_complete(false),
       m_next(std::move(value)),
-      m_trigger(nullptr) {}
+      m_trigger(nullptr),
+      m_sequence(-1) {}
 
   template<typename T>
   template<typename... A>
   Cell<T>::Cell(std::in_place_t, A&&... args)
     : m_is_complete(false),
       m_next(std::in_place, std::forward<A>(args)...),
-      m_trigger(nullptr) {}
+      m_trigger(nullptr),
+      m_sequence(-1) {}
 
   template<typename T>
   Cell<T>::Cell(const Cell& cell)
-      : m_trigger(nullptr) {
+      : m_trigger(nullptr),
+        m_sequence(-1) {
     auto lock = std::lock_guard(cell.m_mutex);
     m_is_complete = cell.m_is_complete;
     m_current = cell.m_current;
     m_next = cell.m_next;
+    m_staged = cell.m_staged;
   }
 
   template<typename T>
   Cell<T>::Cell(Cell&& cell)
-      : m_trigger(nullptr) {
+      : m_trigger(nullptr),
+        m_sequence(-1) {
     auto lock = std::lock_guard(cell.m_mutex);
     m_is_complete = cell.m_is_complete;
     m_current = std::move(cell.m_current);
     m_next = std::move(cell.m_next);
+    m_staged = std::move(cell.m_staged);
   }
 
   template<typename T>
   void Cell<T>::set(Type value) {
     auto lock = std::lock_guard(m_mutex);
-    m_next = std::move(value);
+    update(std::move(value));
     if(m_trigger != nullptr) {
       m_trigger->signal();
     }
@@ -134,7 +152,11 @@ namespace Aspen {
   template<typename... A>
   void Cell<T>::emplace(A&&... args) {
     auto lock = std::lock_guard(m_mutex);
-    m_next.emplace(std::forward<A>(args)...);
+    if(m_staged.empty()) {
+      m_next.emplace(std::forward<A>(args)...);
+    } else {
+      update(Type(std::forward<A>(args)...));
+    }
     if(m_trigger != nullptr) {
       m_trigger->signal();
     }
@@ -153,7 +175,7 @@ namespace Aspen {
   void Cell<T>::set_complete(Type value) {
     auto lock = std::lock_guard(m_mutex);
     m_is_complete = true;
-    m_next = std::move(value);
+    update(std::move(value));
     if(m_trigger != nullptr) {
       m_trigger->signal();
     }
@@ -164,7 +186,11 @@ namespace Aspen {
   void Cell<T>::emplace_complete(A&&... args) {
     auto lock = std::lock_guard(m_mutex);
     m_is_complete = true;
-    m_next.emplace(std::forward<A>(args)...);
+    if(m_staged.empty()) {
+      m_next.emplace(std::forward<A>(args)...);
+    } else {
+      update(Type(std::forward<A>(args)...));
+    }
     if(m_trigger != nullptr) {
       m_trigger->signal();
     }
@@ -176,13 +202,22 @@ namespace Aspen {
     if(m_trigger == nullptr) {
       m_trigger = Trigger::get_trigger();
     }
+    m_sequence = sequence;
+    auto has_continuation = false;
+    while(!m_staged.empty() &&
+        Details::is_ready(m_staged.front(), sequence, has_continuation)) {
+      m_next = std::move(m_staged.front().m_value);
+      m_staged.pop_front();
+    }
     auto state = State::NONE;
     if(m_next.has_value()) {
       m_current = std::move(m_next);
       m_next = std::nullopt;
       state = State::EVALUATED;
     }
-    if(m_is_complete) {
+    if(has_continuation) {
+      state = combine(state, State::CONTINUE);
+    } else if(m_is_complete && m_staged.empty()) {
       state = combine(state, State::COMPLETE);
     }
     return state;
@@ -193,6 +228,30 @@ namespace Aspen {
     return *m_current;
   }
 
+  template<typename T>
+  void Cell<T>::update(Type value) {
+    if(m_staged.empty()) {
+      m_next = std::move(value);
+    } else {
+      m_staged.push_back({nullptr, std::move(value)});
+    }
+  }
+
+  template<typename T>
+  void Cell<T>::stage(
+      const std::shared_ptr<Details::TransactionState>& transaction,
+      Type value) {
+    auto lock = std::lock_guard(m_mutex);
+    transaction->observe(m_sequence);
+    m_staged.push_back({transaction, std::move(value)});
+  }
+
+  template<typename T>
+  Trigger* Cell<T>::load_trigger() {
+    auto lock = std::lock_guard(m_mutex);
+    return m_trigger;
+  }
+
   template<typename T>
   Cell<T>& Cell<T>::operator =(const Cell& cell) {
     auto lock = std::lock_guard(m_mutex);
@@ -200,6 +259,7 @@ namespace Aspen {
     m_is_complete = cell.m_is_complete;
     m_current = cell.m_current;
     m_next = cell.m_next;
+    m_staged = cell.m_staged;
     return *this;
   }
 
@@ -210,6 +270,7 @@ namespace Aspen {
     m_is_complete = std::move(cell.m_is_complete);
     m_current = std::move(cell.m_current);
     m_next = std::move(cell.m_next);
+    m_staged = std::move(cell.m_staged);
     return *this;
   }
 }
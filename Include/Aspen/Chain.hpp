@@ -2,6 +2,7 @@
 #define ASPEN_CHAIN_HPP
 #include <cstdint>
 #include <utility>
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -32,6 +33,9 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const noexcept(is_noexcept);
 
+      /** Returns the error the current reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       enum class Status : char {
         START,
@@ -125,6 +129,15 @@ namespace Aspen {
       return m_continuation.eval();
     }
   }
+
+  template<typename A, typename B>
+  Error Chain<A, B>::get_error() const noexcept {
+    if(m_which == 0) {
+      return eval_error(m_initial);
+    } else {
+      return eval_error(m_continuation);
+    }
+  }
 }
 
 #endif
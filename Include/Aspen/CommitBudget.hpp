@@ -0,0 +1,138 @@
+#ifndef ASPEN_COMMIT_BUDGET_HPP
+#define ASPEN_COMMIT_BUDGET_HPP
+#include <chrono>
+#include <limits>
+
+namespace Aspen {
+
+  /**
+   * Bounds the amount of work an executor performs on a reactor before
+   * yielding, measured in commits, in elapsed time, or both. A budget is
+   * exhausted as soon as either of its limits is reached.
+   */
+  class CommitBudget {
+    public:
+
+      /** The clock used to measure elapsed time. */
+      using Clock = std::chrono::steady_clock;
+
+      /** The type used to represent a duration. */
+      using Duration = Clock::duration;
+
+      /** Constructs an unlimited CommitBudget. */
+      constexpr CommitBudget() noexcept;
+
+      /**
+       * Constructs a CommitBudget limited by the number of commits.
+       * @param commits The maximum number of consecutive commits.
+       */
+      constexpr explicit CommitBudget(int commits) noexcept;
+
+      /**
+       * Constructs a CommitBudget limited by elapsed time.
+       * @param duration The maximum duration to spend committing.
+       */
+      constexpr explicit CommitBudget(Duration duration) noexcept;
+
+      /**
+       * Constructs a CommitBudget limited by both commits and elapsed time.
+       * @param commits The maximum number of consecutive commits.
+       * @param duration The maximum duration to spend committing.
+       */
+      constexpr CommitBudget(int commits, Duration duration) noexcept;
+
+      /** Returns the maximum number of consecutive commits. */
+      constexpr int get_commits() const noexcept;
+
+      /** Returns the maximum duration to spend committing. */
+      constexpr Duration get_duration() const noexcept;
+
+      /** Returns <code>true</code> iff this budget never runs out. */
+      constexpr bool is_unlimited() const noexcept;
+
+    private:
+      int m_commits;
+      Duration m_duration;
+  };
+
+namespace Details {
+
+  /** Tracks the consumption of a CommitBudget. */
+  class BudgetMeter {
+    public:
+
+      /**
+       * Constructs a BudgetMeter and starts measuring.
+       * @param budget The budget to measure against.
+       */
+      explicit BudgetMeter(const CommitBudget& budget) noexcept;
+
+      /** Restarts measuring from a full budget. */
+      void reset() noexcept;
+
+      /**
+       * Records a commit.
+       * @return <code>true</code> iff the budget is now exhausted.
+       */
+      bool consume() noexcept;
+
+    private:
+      const CommitBudget* m_budget;
+      int m_commits;
+      CommitBudget::Clock::time_point m_start;
+  };
+}
+
+  constexpr CommitBudget::CommitBudget() noexcept
+    : CommitBudget(std::numeric_limits<int>::max(), Duration::max()) {}
+
+  constexpr CommitBudget::CommitBudget(int commits) noexcept
+    : CommitBudget(commits, Duration::max()) {}
+
+  constexpr CommitBudget::CommitBudget(Duration duration) noexcept
+    : CommitBudget(std::numeric_limits<int>::max(), duration) {}
+
+  constexpr CommitBudget::CommitBudget(int commits, Duration duration) noexcept
+    : m_commits(commits < 1 ? 1 : commits),
+      m_duration(duration) {}
+
+  constexpr int CommitBudget::get_commits() const noexcept {
+    return m_commits;
+  }
+
+  constexpr CommitBudget::Duration CommitBudget::get_duration() const noexcept {
+    return m_duration;
+  }
+
+  constexpr bool CommitBudget::is_unlimited() const noexcept {
+    return m_commits == std::numeric_limits<int>::max() &&
+      m_duration == Duration::max();
+  }
+
+namespace Details {
+  inline BudgetMeter::BudgetMeter(const CommitBudget& budget) noexcept
+      : m_budget(&budget) {
+    reset();
+  }
+
+  inline void BudgetMeter::reset() noexcept {
+    m_commits = 0;
+    if(m_budget->get_duration() != CommitBudget::Duration::max()) {
+      m_start = CommitBudget::Clock::now();
+    }
+  }
+
+  inline bool BudgetMeter::consume() noexcept {
+    if(m_budget->get_commits() != std::numeric_limits<int>::max()) {
+      ++m_commits;
+      if(m_commits >= m_budget->get_commits()) {
+        return true;
+      }
+    }
+    return m_budget->get_duration() != CommitBudget::Duration::max() &&
+      CommitBudget::Clock::now() - m_start >= m_budget->get_duration();
+  }
+}
+}
+
+#endif
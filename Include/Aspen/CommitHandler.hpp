@@ -1,10 +1,35 @@
 #ifndef ASPEN_COMMIT_HANDLER_HPP
 #define ASPEN_COMMIT_HANDLER_HPP
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 #include "Aspen/State.hpp"
+#include "Aspen/Trigger.hpp"
 
 namespace Aspen {
+  template<typename R> class ParallelCommitHandler;
+
+  /** Specifies which children a CommitHandler commits on each sequence. */
+  enum class CommitPolicy {
+
+    /** Every child that hasn't completed is committed. */
+    ALL,
+
+    /**
+     * Only children that signalled an update through their Trigger or that
+     * requested a continuation are committed, making the cost of a commit
+     * proportional to the number of children that changed. Each child's
+     * sources capture a Trigger owned by the CommitHandler, so as with a
+     * DirtyGuard, a source shared with reactors outside of the handler
+     * should be committed outside of it. A copy of the handler starts with
+     * every child dirty.
+     */
+    DIRTY
+  };
 
   /** Helper class used to commit a list of reactors and evaluate to their
    *  aggregate state.
@@ -17,9 +42,11 @@ namespace Aspen {
       /**
        * Constructs a CommitHandler.
        * @param children The reactors whose commits are to be managed.
+       * @param policy Specifies which children are committed.
        */
       template<typename A = std::allocator<R>>
-      explicit CommitHandler(std::vector<R, A> children);
+      explicit CommitHandler(std::vector<R, A> children,
+        CommitPolicy policy = CommitPolicy::ALL);
 
       /**
        * Commits all children and returns their aggregate State.
@@ -38,6 +65,7 @@ namespace Aspen {
       R& get(std::size_t i) noexcept;
 
     private:
+      template<typename> friend class ParallelCommitHandler;
       struct Child {
         R m_reactor;
         State m_state;
@@ -45,8 +73,37 @@ namespace Aspen {
 
         Child(R reactor);
       };
+      struct DirtySet {
+        std::mutex m_mutex;
+        std::vector<std::size_t> m_signals;
+        std::vector<std::size_t> m_dirty;
+        std::vector<std::size_t> m_continuations;
+        std::unique_ptr<std::atomic_bool[]> m_is_dirty;
+        std::deque<Trigger> m_triggers;
+        Trigger* m_parent;
+        std::size_t m_evaluation_count;
+        std::size_t m_completion_count;
+
+        DirtySet(std::size_t size);
+        DirtySet(const DirtySet& dirty_set);
+        void mark(std::size_t i);
+      };
+      struct DirtySetPtr {
+        std::unique_ptr<DirtySet> m_dirty_set;
+
+        DirtySetPtr() = default;
+        DirtySetPtr(const DirtySetPtr& pointer);
+        DirtySetPtr(DirtySetPtr&&) = default;
+        explicit operator bool() const noexcept;
+        DirtySet& operator *() const noexcept;
+        DirtySetPtr& operator =(const DirtySetPtr& pointer);
+        DirtySetPtr& operator =(DirtySetPtr&&) = default;
+      };
       std::vector<Child> m_children;
       bool m_is_initializing;
+      DirtySetPtr m_dirty_set;
+
+      State commit_dirty(int sequence) noexcept;
   };
 
   template<typename R>
@@ -55,13 +112,77 @@ namespace Aspen {
       m_state(State::NONE),
       m_has_evaluation(false) {}
 
+  template<typename R>
+  CommitHandler<R>::DirtySet::DirtySet(std::size_t size)
+      : m_is_dirty(std::make_unique<std::atomic_bool[]>(size)),
+        m_parent(nullptr),
+        m_evaluation_count(0),
+        m_completion_count(0) {
+    for(auto i = std::size_t(0); i != size; ++i) {
+      m_is_dirty[i].store(true, std::memory_order_relaxed);
+      m_signals.push_back(i);
+      m_triggers.emplace_back([=] {
+        mark(i);
+      });
+    }
+  }
+
+  template<typename R>
+  CommitHandler<R>::DirtySet::DirtySet(const DirtySet& dirty_set)
+      : DirtySet(dirty_set.m_triggers.size()) {
+    m_evaluation_count = dirty_set.m_evaluation_count;
+    m_completion_count = dirty_set.m_completion_count;
+  }
+
+  template<typename R>
+  void CommitHandler<R>::DirtySet::mark(std::size_t i) {
+    if(!m_is_dirty[i].exchange(true, std::memory_order_acq_rel)) {
+      auto lock = std::lock_guard(m_mutex);
+      m_signals.push_back(i);
+    }
+    if(m_parent != nullptr) {
+      m_parent->signal();
+    }
+  }
+
+  template<typename R>
+  CommitHandler<R>::DirtySetPtr::DirtySetPtr(const DirtySetPtr& pointer) {
+    *this = pointer;
+  }
+
+  template<typename R>
+  CommitHandler<R>::DirtySetPtr::operator bool() const noexcept {
+    return m_dirty_set != nullptr;
+  }
+
+  template<typename R>
+  typename CommitHandler<R>::DirtySet&
+      CommitHandler<R>::DirtySetPtr::operator *() const noexcept {
+    return *m_dirty_set;
+  }
+
+  template<typename R>
+  typename CommitHandler<R>::DirtySetPtr&
+      CommitHandler<R>::DirtySetPtr::operator =(const DirtySetPtr& pointer) {
+    if(pointer.m_dirty_set) {
+      m_dirty_set = std::make_unique<DirtySet>(*pointer.m_dirty_set);
+    } else {
+      m_dirty_set = nullptr;
+    }
+    return *this;
+  }
+
   template<typename R>
   template<typename A>
-  CommitHandler<R>::CommitHandler(std::vector<R, A> children)
+  CommitHandler<R>::CommitHandler(std::vector<R, A> children,
+      CommitPolicy policy)
       : m_is_initializing(true) {
     for(auto& child : children) {
       m_children.push_back(std::move(child));
     }
+    if(policy == CommitPolicy::DIRTY) {
+      m_dirty_set.m_dirty_set = std::make_unique<DirtySet>(m_children.size());
+    }
   }
 
   template<typename R>
@@ -69,6 +190,9 @@ namespace Aspen {
     if(m_children.empty()) {
       return State::COMPLETE;
     }
+    if(m_dirty_set) {
+      return commit_dirty(sequence);
+    }
     auto state = State::NONE;
     auto evaluation_count = std::size_t(0);
     auto completion_count = std::size_t(0);
@@ -119,6 +243,69 @@ namespace Aspen {
     return state;
   }
 
+  template<typename R>
+  State CommitHandler<R>::commit_dirty(int sequence) noexcept {
+    auto& dirty_set = *m_dirty_set;
+    if(dirty_set.m_parent == nullptr) {
+      dirty_set.m_parent = Trigger::get_trigger();
+    }
+    dirty_set.m_dirty.clear();
+    {
+      auto lock = std::lock_guard(dirty_set.m_mutex);
+      dirty_set.m_dirty.swap(dirty_set.m_signals);
+    }
+    for(auto i : dirty_set.m_continuations) {
+      if(!dirty_set.m_is_dirty[i].exchange(true, std::memory_order_acq_rel)) {
+        dirty_set.m_dirty.push_back(i);
+      }
+    }
+    dirty_set.m_continuations.clear();
+    std::sort(dirty_set.m_dirty.begin(), dirty_set.m_dirty.end());
+    auto evaluation_count = std::size_t(0);
+    auto parent = Trigger::get_trigger();
+    for(auto i : dirty_set.m_dirty) {
+      dirty_set.m_is_dirty[i].store(false, std::memory_order_release);
+      auto& child = m_children[i];
+      if(is_complete(child.m_state)) {
+        continue;
+      }
+      Trigger::set_trigger(dirty_set.m_triggers[i]);
+      child.m_state = child.m_reactor.commit(sequence);
+      if(has_evaluation(child.m_state)) {
+        ++evaluation_count;
+        if(!child.m_has_evaluation) {
+          child.m_has_evaluation = true;
+          ++dirty_set.m_evaluation_count;
+        }
+      }
+      if(is_complete(child.m_state)) {
+        ++dirty_set.m_completion_count;
+        if(!child.m_has_evaluation) {
+          Trigger::set_trigger(parent);
+          return State::COMPLETE;
+        }
+      } else if(has_continuation(child.m_state)) {
+        dirty_set.m_continuations.push_back(i);
+      }
+    }
+    Trigger::set_trigger(parent);
+    auto state = State::NONE;
+    if(m_is_initializing) {
+      if(dirty_set.m_evaluation_count == m_children.size()) {
+        m_is_initializing = false;
+        state = State::EVALUATED;
+      }
+    } else if(evaluation_count != 0) {
+      state = State::EVALUATED;
+    }
+    if(dirty_set.m_completion_count == m_children.size()) {
+      state = combine(state, State::COMPLETE);
+    } else if(!dirty_set.m_continuations.empty()) {
+      state = combine(state, State::CONTINUE);
+    }
+    return state;
+  }
+
   template<typename R>
   std::size_t CommitHandler<R>::size() const noexcept {
     return m_children.size();
@@ -0,0 +1,356 @@
+#ifndef ASPEN_COMMIT_POOL_HPP
+#define ASPEN_COMMIT_POOL_HPP
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Aspen/EpollContext.hpp"
+#include "Aspen/TimerWheel.hpp"
+#include "Aspen/Trigger.hpp"
+
+namespace Aspen {
+namespace Details {
+
+  /** Stores the thread local state a CommitPool installs on its workers. */
+  struct CommitContext {
+    Trigger* m_trigger;
+    TimerWheel* m_wheel;
+    EpollExecutor* m_executor;
+
+    /** Returns the calling thread's context. */
+    static CommitContext get() noexcept;
+
+    /** Installs a context on the calling thread. */
+    static void set(const CommitContext& context) noexcept;
+  };
+
+  inline CommitContext CommitContext::get() noexcept {
+    return CommitContext{Trigger::get_trigger(), TimerWheel::get_wheel(),
+      current_epoll_executor};
+  }
+
+  inline void CommitContext::set(const CommitContext& context) noexcept {
+    Trigger::set_trigger(context.m_trigger);
+    TimerWheel::set_wheel(context.m_wheel);
+    current_epoll_executor = context.m_executor;
+  }
+}
+
+  /**
+   * A fork-join thread pool used to commit the children of a commit handler
+   * in parallel. The thread calling run participates in the work and only
+   * returns once every index has been processed. A pool runs one job at a
+   * time; a call to run made while another is in progress, including a
+   * nested call from within a job, is performed serially on the calling
+   * thread.
+   */
+  class CommitPool {
+    public:
+
+      /**
+       * Constructs a CommitPool.
+       * @param thread_count The number of threads that participate in a job,
+       *        including the thread calling run.
+       */
+      explicit CommitPool(std::size_t thread_count);
+
+      /** Constructs a CommitPool with one thread per hardware thread. */
+      CommitPool();
+
+      /** Stops all worker threads. */
+      ~CommitPool();
+
+      /**
+       * Returns the number of threads that participate in a job, including
+       * the thread calling run.
+       */
+      std::size_t get_thread_count() const noexcept;
+
+      /**
+       * Invokes a function on every index in [0, count), distributed across
+       * the pool's threads, and waits for all invocations to return. The
+       * calling thread's Trigger, TimerWheel and EpollExecutor are installed
+       * on every worker and the TimerWheel is shared for the duration of the
+       * job.
+       * @param count The number of indices.
+       * @param f The function to invoke, must not throw.
+       */
+      template<typename F>
+      void run(std::size_t count, F&& f) noexcept;
+
+    private:
+      struct Job {
+        void (*m_function)(void* context, std::size_t index) noexcept;
+        void* m_context;
+        std::size_t m_count;
+        Details::CommitContext m_thread_context;
+        std::atomic<std::size_t> m_next;
+      };
+      std::vector<std::thread> m_threads;
+      std::mutex m_mutex;
+      std::condition_variable m_job_condition;
+      std::condition_variable m_done_condition;
+      Job* m_job;
+      std::uint64_t m_generation;
+      std::size_t m_active_count;
+      std::atomic_bool m_is_running;
+      bool m_is_stopping;
+
+      CommitPool(const CommitPool&) = delete;
+      CommitPool& operator =(const CommitPool&) = delete;
+      static void work(Job& job) noexcept;
+      void run_worker();
+  };
+
+  /**
+   * Specifies when a commit handler commits its children in parallel on a
+   * CommitPool. Children are committed in parallel only when there are at
+   * least a minimum number of them and the estimated cost of committing all
+   * of them, measured over previous commits, is at least a minimum duration.
+   * Children committed in parallel must not share any reactors with one
+   * another, including through a Shared reactor. Copies of a ParallelCommit
+   * share the same cost estimate.
+   */
+  class ParallelCommit {
+    public:
+
+      /** The default minimum number of children to commit in parallel. */
+      static constexpr std::size_t DEFAULT_MINIMUM_SIZE = 2;
+
+      /** The default minimum estimated cost to commit in parallel. */
+      static constexpr auto DEFAULT_MINIMUM_COST =
+        std::chrono::microseconds(100);
+
+      /** Constructs a ParallelCommit that always commits serially. */
+      ParallelCommit() = default;
+
+      /**
+       * Constructs a ParallelCommit using the default thresholds.
+       * @param pool The pool used to commit children in parallel.
+       */
+      explicit ParallelCommit(CommitPool& pool);
+
+      /**
+       * Constructs a ParallelCommit.
+       * @param pool The pool used to commit children in parallel.
+       * @param minimum_size The minimum number of children to commit in
+       *        parallel.
+       * @param minimum_cost The minimum estimated cost of a commit to commit
+       *        in parallel.
+       */
+      ParallelCommit(CommitPool& pool, std::size_t minimum_size,
+        std::chrono::nanoseconds minimum_cost);
+
+      /** Returns <code>true</code> iff a CommitPool was specified. */
+      bool is_enabled() const noexcept;
+
+      /** Returns the estimated cost of committing every child. */
+      std::chrono::nanoseconds get_cost() const noexcept;
+
+      /**
+       * Invokes a function on every index in [0, count), in parallel if the
+       * thresholds are met and serially otherwise, and updates the estimated
+       * cost.
+       * @param count The number of indices.
+       * @param f The function to invoke, must not throw.
+       */
+      template<typename F>
+      void run(std::size_t count, F&& f) noexcept;
+
+    private:
+      struct Settings {
+        CommitPool* m_pool;
+        std::size_t m_minimum_size;
+        std::chrono::nanoseconds m_minimum_cost;
+        std::atomic<std::chrono::nanoseconds::rep> m_cost;
+
+        Settings(CommitPool& pool, std::size_t minimum_size,
+          std::chrono::nanoseconds minimum_cost);
+      };
+      std::shared_ptr<Settings> m_settings;
+
+      void record(std::chrono::nanoseconds cost) noexcept;
+  };
+
+  inline CommitPool::CommitPool(std::size_t thread_count)
+      : m_job(nullptr),
+        m_generation(0),
+        m_active_count(0),
+        m_is_running(false),
+        m_is_stopping(false) {
+    for(auto i = std::size_t(1); i < thread_count; ++i) {
+      m_threads.emplace_back([=] {
+        run_worker();
+      });
+    }
+  }
+
+  inline CommitPool::CommitPool()
+    : CommitPool(std::thread::hardware_concurrency()) {}
+
+  inline CommitPool::~CommitPool() {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      m_is_stopping = true;
+    }
+    m_job_condition.notify_all();
+    for(auto& thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  inline std::size_t CommitPool::get_thread_count() const noexcept {
+    return m_threads.size() + 1;
+  }
+
+  template<typename F>
+  void CommitPool::run(std::size_t count, F&& f) noexcept {
+    auto is_running = false;
+    if(count < 2 || m_threads.empty() ||
+        !m_is_running.compare_exchange_strong(is_running, true,
+          std::memory_order_acquire)) {
+      for(auto i = std::size_t(0); i != count; ++i) {
+        f(i);
+      }
+      return;
+    }
+    using Function = std::remove_reference_t<F>;
+    auto job = Job{
+      [] (void* context, std::size_t index) noexcept {
+        (*static_cast<Function*>(context))(index);
+      }, const_cast<void*>(static_cast<const void*>(&f)), count,
+      Details::CommitContext::get(), {0}};
+    auto wheel = job.m_thread_context.m_wheel;
+    if(wheel != nullptr) {
+      wheel->share();
+    }
+    {
+      auto lock = std::lock_guard(m_mutex);
+      m_job = &job;
+      ++m_generation;
+    }
+    m_job_condition.notify_all();
+    work(job);
+    {
+      auto lock = std::unique_lock(m_mutex);
+      m_job = nullptr;
+      while(m_active_count != 0) {
+        m_done_condition.wait(lock);
+      }
+    }
+    if(wheel != nullptr) {
+      wheel->unshare();
+    }
+    m_is_running.store(false, std::memory_order_release);
+  }
+
+  inline void CommitPool::work(Job& job) noexcept {
+    while(true) {
+      auto index = job.m_next.fetch_add(1, std::memory_order_relaxed);
+      if(index >= job.m_count) {
+        return;
+      }
+      job.m_function(job.m_context, index);
+    }
+  }
+
+  inline void CommitPool::run_worker() {
+    auto generation = std::uint64_t(0);
+    auto lock = std::unique_lock(m_mutex);
+    while(true) {
+      while(!m_is_stopping &&
+          (m_job == nullptr || m_generation == generation)) {
+        m_job_condition.wait(lock);
+      }
+      if(m_is_stopping) {
+        return;
+      }
+      generation = m_generation;
+      auto& job = *m_job;
+      ++m_active_count;
+      lock.unlock();
+      Details::CommitContext::set(job.m_thread_context);
+      work(job);
+      Details::CommitContext::set(Details::CommitContext{});
+      lock.lock();
+      --m_active_count;
+      if(m_active_count == 0) {
+        m_done_condition.notify_all();
+      }
+    }
+  }
+
+  inline ParallelCommit::Settings::Settings(CommitPool& pool,
+    std::size_t minimum_size, std::chrono::nanoseconds minimum_cost)
+    : m_pool(&pool),
+      m_minimum_size(minimum_size),
+      m_minimum_cost(minimum_cost),
+      m_cost(0) {}
+
+  inline ParallelCommit::ParallelCommit(CommitPool& pool)
+    : ParallelCommit(pool, DEFAULT_MINIMUM_SIZE, DEFAULT_MINIMUM_COST) {}
+
+  inline ParallelCommit::ParallelCommit(CommitPool& pool,
+    std::size_t minimum_size, std::chrono::nanoseconds minimum_cost)
+    : m_settings(std::make_shared<Settings>(pool, minimum_size,
+        minimum_cost)) {}
+
+  inline bool ParallelCommit::is_enabled() const noexcept {
+    return m_settings != nullptr;
+  }
+
+  inline std::chrono::nanoseconds ParallelCommit::get_cost() const noexcept {
+    if(!m_settings) {
+      return std::chrono::nanoseconds(0);
+    }
+    return std::chrono::nanoseconds(
+      m_settings->m_cost.load(std::memory_order_relaxed));
+  }
+
+  template<typename F>
+  void ParallelCommit::run(std::size_t count, F&& f) noexcept {
+    using Clock = std::chrono::steady_clock;
+    if(!m_settings || count < m_settings->m_minimum_size) {
+      for(auto i = std::size_t(0); i != count; ++i) {
+        f(i);
+      }
+      return;
+    }
+    if(get_cost() < m_settings->m_minimum_cost) {
+      auto start = Clock::now();
+      for(auto i = std::size_t(0); i != count; ++i) {
+        f(i);
+      }
+      record(Clock::now() - start);
+      return;
+    }
+    auto cost = std::atomic<std::chrono::nanoseconds::rep>(0);
+    m_settings->m_pool->run(count, [&] (std::size_t i) noexcept {
+      auto start = Clock::now();
+      f(i);
+      cost.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - start).count(), std::memory_order_relaxed);
+    });
+    record(std::chrono::nanoseconds(cost.load(std::memory_order_relaxed)));
+  }
+
+  inline void ParallelCommit::record(std::chrono::nanoseconds cost) noexcept {
+    auto previous = m_settings->m_cost.load(std::memory_order_relaxed);
+    if(previous == 0) {
+      m_settings->m_cost.store(cost.count(), std::memory_order_relaxed);
+    } else {
+      m_settings->m_cost.store((3 * previous + cost.count()) / 4,
+        std::memory_order_relaxed);
+    }
+  }
+}
+
+#endif
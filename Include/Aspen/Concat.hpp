@@ -3,6 +3,7 @@
 #include <list>
 #include <type_traits>
 #include <utility>
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -33,6 +34,9 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const noexcept(is_noexcept);
 
+      /** Returns the error the current child evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       Reactor m_producer;
       bool m_is_producer_complete;
@@ -66,10 +70,10 @@ namespace Aspen {
     auto state = [&] {
       if(!m_is_producer_complete) {
         auto producer_state = m_producer.commit(sequence);
-        if(has_evaluation(producer_state)) {
-          try {
+        if(has_evaluation(producer_state) && !eval_error(m_producer)) {
+          ASPEN_TRY {
             m_children.emplace_back(m_producer.eval());
-          } catch(...) {}
+          } ASPEN_CATCH(...) {}
         }
         if(has_continuation(producer_state)) {
           return State::CONTINUE;
@@ -132,6 +136,11 @@ namespace Aspen {
       const noexcept(is_noexcept) {
     return m_children.front().eval();
   }
+
+  template<typename T>
+  Error Concat<T>::get_error() const noexcept {
+    return eval_error(m_children.front());
+  }
 }
 
 #endif
@@ -3,6 +3,7 @@
 #include <list>
 #include <optional>
 #include <utility>
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -32,6 +33,9 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const noexcept(is_noexcept);
 
+      /** Returns the error the current child evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       struct Child {
         reactor_result_t<T> m_reactor;
@@ -80,13 +84,13 @@ namespace Aspen {
     auto state = [&] {
       if(m_producer.has_value()) {
         auto producer_state = m_producer->commit(sequence);
-        if(has_evaluation(producer_state)) {
-          try {
+        if(has_evaluation(producer_state) && !eval_error(*m_producer)) {
+          ASPEN_TRY {
             m_children->emplace_back(m_producer->eval());
             if(m_children->size() == 1) {
               m_position = m_children->begin();
             }
-          } catch(...) {}
+          } ASPEN_CATCH(...) {}
         }
         if(has_continuation(producer_state)) {
           return State::CONTINUE;
@@ -154,6 +158,11 @@ namespace Aspen {
     return m_current->m_reactor.eval();
   }
 
+  template<typename T>
+  Error Concur<T>::get_error() const noexcept {
+    return eval_error(m_current->m_reactor);
+  }
+
   template<typename T>
   void Concur<T>::increment() {
     ++m_position;
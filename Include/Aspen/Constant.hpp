@@ -1,5 +1,6 @@
 #ifndef ASPEN_CONSTANT_HPP
 #define ASPEN_CONSTANT_HPP
+#include <type_traits>
 #include <utility>
 #include "Aspen/State.hpp"
 
@@ -37,6 +38,16 @@ namespace Aspen {
     return Constant(std::forward<T>(value));
   }
 
+  /** Tests if a type is a Constant reactor. */
+  template<typename T>
+  struct is_constant : std::false_type {};
+
+  template<typename T>
+  struct is_constant<Constant<T>> : std::true_type {};
+
+  template<typename T>
+  constexpr auto is_constant_v = is_constant<T>::value;
+
   template<typename T>
   constexpr Constant<T>::Constant(T value)
     : m_value(std::move(value)) {}
@@ -1,7 +1,10 @@
 #ifndef ASPEN_CONVERSIONS_HPP
 #define ASPEN_CONVERSIONS_HPP
+#include <cstddef>
 #include <type_traits>
 #include <utility>
+#include "Aspen/Error.hpp"
+#include "Aspen/EvalPolicy.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -12,13 +15,16 @@ namespace Aspen {
    * to the result.
    * @param <R> The type of reactor to perform the conversion to.
    * @param <F> The conversion function to apply to the reactor.
+   * @param <P> Specifies when the conversion is performed.
    */
-  template<typename R, typename F>
+  template<typename R, typename F, EvalPolicy P = EvalPolicy::LAZY>
   class ConversionReactor {
     public:
       using Type = decltype(std::declval<F>()(std::declval<R>().eval()));
       static constexpr auto is_noexcept =
         noexcept(std::declval<F>()(std::declval<R>().eval()));
+      using Result = std::conditional_t<P == EvalPolicy::LAZY, Type,
+        const Type&>;
 
       /**
        * Constructs a ConversionReactor.
@@ -30,17 +36,34 @@ namespace Aspen {
 
       State commit(int sequence) noexcept;
 
-      Type eval() const noexcept(is_noexcept);
+      Result eval() const noexcept(is_noexcept);
+
+      /** Returns the error this reactor evaluates to, if any. */
+      Error get_error() const noexcept;
 
     private:
       R m_reactor;
       F m_conversion;
+      std::conditional_t<P == EvalPolicy::LAZY, std::nullptr_t,
+        Details::EvalCache<Type, is_noexcept>> m_value;
   };
 
   template<typename R, typename F>
   ConversionReactor(R&&, F&&) ->
     ConversionReactor<std::decay_t<R>, std::decay_t<F>>;
 
+  /**
+   * Applies a conversion function to the result of a reactor.
+   * @param <P> Specifies when the conversion is performed.
+   * @param reactor The reactor to apply the conversion to.
+   * @param conversion The conversion to perform.
+   */
+  template<EvalPolicy P, typename R, typename F>
+  auto convert(R&& reactor, F&& conversion) {
+    return ConversionReactor<std::decay_t<R>, std::decay_t<F>, P>(
+      std::forward<R>(reactor), std::forward<F>(conversion));
+  }
+
   /** Performs a static_cast on the result of a reactor. */
   template<typename T, typename R>
   decltype(auto) static_reactor_cast(R&& reactor) {
@@ -54,21 +77,51 @@ namespace Aspen {
     }
   }
 
-  template<typename R, typename F>
+  template<typename R, typename F, EvalPolicy P>
   template<typename RF, typename FF>
-  ConversionReactor<R, F>::ConversionReactor(RF&& reactor, FF&& conversion)
+  ConversionReactor<R, F, P>::ConversionReactor(RF&& reactor,
+    FF&& conversion)
     : m_reactor(std::forward<RF>(reactor)),
       m_conversion(std::forward<FF>(conversion)) {}
 
-  template<typename R, typename F>
-  State ConversionReactor<R, F>::commit(int sequence) noexcept {
-    return m_reactor.commit(sequence);
+  template<typename R, typename F, EvalPolicy P>
+  State ConversionReactor<R, F, P>::commit(int sequence) noexcept {
+    auto state = m_reactor.commit(sequence);
+    if constexpr(P != EvalPolicy::LAZY) {
+      if(has_evaluation(state)) {
+        if constexpr(P == EvalPolicy::EAGER) {
+          if constexpr(!is_noexcept) {
+            if(auto error = eval_error(m_reactor)) {
+              m_value.set_error(std::move(error));
+              return state;
+            }
+          }
+          m_value.update([&] () noexcept(is_noexcept) {
+            return m_conversion(m_reactor.eval());
+          });
+        } else {
+          m_value.invalidate();
+        }
+      }
+    }
+    return state;
   }
 
-  template<typename R, typename F>
-  typename ConversionReactor<R, F>::Type
-      ConversionReactor<R, F>::eval() const noexcept(is_noexcept) {
-    return m_conversion(m_reactor.eval());
+  template<typename R, typename F, EvalPolicy P>
+  typename ConversionReactor<R, F, P>::Result
+      ConversionReactor<R, F, P>::eval() const noexcept(is_noexcept) {
+    if constexpr(P == EvalPolicy::LAZY) {
+      return m_conversion(m_reactor.eval());
+    } else {
+      return m_value.get([&] () noexcept(is_noexcept) {
+        return m_conversion(m_reactor.eval());
+      });
+    }
+  }
+
+  template<typename R, typename F, EvalPolicy P>
+  Error ConversionReactor<R, F, P>::get_error() const noexcept {
+    return eval_error(m_reactor);
   }
 }
 
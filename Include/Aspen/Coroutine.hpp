@@ -0,0 +1,431 @@
+#ifndef ASPEN_COROUTINE_HPP
+#define ASPEN_COROUTINE_HPP
+#if defined (__cpp_impl_coroutine)
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "Aspen/Error.hpp"
+#include "Aspen/Maybe.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/Traits.hpp"
+
+namespace Aspen {
+namespace Details {
+
+  /**
+   * Allocates coroutine frames from per-thread free lists bucketed by size,
+   * so that reactors created and destroyed at a steady rate stop touching the
+   * global heap. Frames larger than the largest bucket use the global heap.
+   * The free lists are trivially destructible and are drained by a separate
+   * guard at thread exit, after which frames that outlive it, such as those
+   * owned by other thread_local objects, go straight to the global heap.
+   */
+  class CoroutineFrameAllocator {
+    public:
+
+      /**
+       * Allocates a frame.
+       * @param size The size of the frame in bytes.
+       */
+      static void* allocate(std::size_t size);
+
+      /**
+       * Releases a frame allocated by this allocator.
+       * @param frame The frame to release.
+       * @param size The size the frame was allocated with.
+       */
+      static void release(void* frame, std::size_t size) noexcept;
+
+    private:
+      static constexpr auto GRANULARITY = std::size_t(64);
+      static constexpr auto BUCKETS = std::size_t(16);
+      static constexpr auto MAX_CACHED = std::size_t(64);
+      struct Block {
+        Block* m_next;
+      };
+      struct FreeList {
+        Block* m_head;
+        std::size_t m_size;
+      };
+      struct Cache {
+        std::array<FreeList, BUCKETS> m_lists;
+        bool m_is_closed;
+      };
+      struct CacheGuard {
+        ~CacheGuard();
+      };
+      static Cache& get_cache() noexcept;
+  };
+
+  template<typename T>
+  struct CoroutinePromise;
+}
+
+  /**
+   * A reactor whose behaviour is written as a coroutine. The coroutine starts
+   * running on the first commit, evaluates every value it co_yields, and
+   * completes when it returns. After each co_yield the coroutine runs ahead
+   * to its next suspension point within the same commit, so that a value is
+   * only reported with a continuation if the coroutine has more work ready,
+   * and the last value yielded before returning completes with it. Awaiting
+   * a reactor commits it and resumes with its next evaluation, suspending for
+   * as many sequences as that takes. At most one child is committed per
+   * sequence, and awaiting a reactor that completes without evaluating throws
+   * a std::runtime_error inside the coroutine.
+   * @param <T> The type of value the coroutine yields.
+   */
+  template<typename T>
+  class Coroutine {
+    public:
+      using Type = T;
+      using promise_type = Details::CoroutinePromise<T>;
+
+      Coroutine(Coroutine&& coroutine) noexcept;
+
+      ~Coroutine();
+
+      State commit(int sequence) noexcept;
+
+      eval_result_t<Type> eval() const;
+
+      /** Returns the error the coroutine evaluates to, if any. */
+      Error get_error() const noexcept;
+
+      Coroutine& operator =(Coroutine&& coroutine) noexcept;
+
+    private:
+      friend struct Details::CoroutinePromise<T>;
+      std::coroutine_handle<promise_type> m_handle;
+
+      explicit Coroutine(std::coroutine_handle<promise_type> handle) noexcept;
+      Coroutine(const Coroutine&) = delete;
+      Coroutine& operator =(const Coroutine&) = delete;
+  };
+
+namespace Details {
+  template<typename T>
+  struct CoroutinePromise {
+    using Poll = State (*)(void*, int) noexcept;
+
+    Maybe<T> m_value;
+    Maybe<T> m_next_value;
+    State m_state;
+    int m_sequence;
+    bool m_has_next_value;
+    bool m_is_looking_ahead;
+    bool m_has_committed_child;
+    const void* m_child;
+    State m_child_state;
+    Poll m_poll;
+    void* m_awaiter;
+
+    template<typename R>
+    struct ChildAwaiter {
+      R* m_reactor;
+      CoroutinePromise* m_promise;
+      State m_state;
+
+      static State poll(void* awaiter, int sequence) noexcept;
+      bool commit(int sequence) noexcept;
+      bool await_ready() noexcept;
+      void await_suspend(std::coroutine_handle<>) noexcept;
+      decltype(auto) await_resume() const;
+    };
+
+    CoroutinePromise() noexcept;
+    Coroutine<T> get_return_object() noexcept;
+    std::suspend_always initial_suspend() const noexcept;
+    std::suspend_always final_suspend() const noexcept;
+    template<typename U>
+    std::suspend_always yield_value(U&& value) noexcept(
+      std::is_nothrow_constructible_v<T, U&&>);
+    template<typename R>
+    ChildAwaiter<std::remove_reference_t<R>> await_transform(R&& reactor)
+      noexcept;
+    void return_void() noexcept;
+    void unhandled_exception() noexcept;
+    static void* operator new(std::size_t size);
+    static void operator delete(void* frame, std::size_t size) noexcept;
+  };
+
+  inline void* CoroutineFrameAllocator::allocate(std::size_t size) {
+    auto bucket = (size + GRANULARITY - 1) / GRANULARITY;
+    if(bucket == 0 || bucket > BUCKETS) {
+      return ::operator new(size);
+    }
+    auto& cache = get_cache();
+    if(cache.m_is_closed) {
+      return ::operator new(bucket * GRANULARITY);
+    }
+    auto& list = cache.m_lists[bucket - 1];
+    if(list.m_head != nullptr) {
+      auto block = list.m_head;
+      list.m_head = block->m_next;
+      --list.m_size;
+      return block;
+    }
+    return ::operator new(bucket * GRANULARITY);
+  }
+
+  inline void CoroutineFrameAllocator::release(void* frame,
+      std::size_t size) noexcept {
+    auto bucket = (size + GRANULARITY - 1) / GRANULARITY;
+    if(bucket == 0 || bucket > BUCKETS) {
+      ::operator delete(frame);
+      return;
+    }
+    auto& cache = get_cache();
+    auto& list = cache.m_lists[bucket - 1];
+    if(cache.m_is_closed || list.m_size == MAX_CACHED) {
+      ::operator delete(frame);
+      return;
+    }
+    auto block = static_cast<Block*>(frame);
+    block->m_next = list.m_head;
+    list.m_head = block;
+    ++list.m_size;
+  }
+
+  inline CoroutineFrameAllocator::CacheGuard::~CacheGuard() {
+    auto& cache = get_cache();
+    cache.m_is_closed = true;
+    for(auto& list : cache.m_lists) {
+      while(list.m_head != nullptr) {
+        auto block = list.m_head;
+        list.m_head = block->m_next;
+        ::operator delete(block);
+      }
+      list.m_size = 0;
+    }
+  }
+
+  inline CoroutineFrameAllocator::Cache&
+      CoroutineFrameAllocator::get_cache() noexcept {
+    static thread_local auto cache = Cache();
+    static thread_local auto guard = CacheGuard();
+    return cache;
+  }
+
+  template<typename T>
+  CoroutinePromise<T>::CoroutinePromise() noexcept
+    : m_state(State::NONE),
+      m_sequence(-1),
+      m_has_next_value(false),
+      m_is_looking_ahead(false),
+      m_has_committed_child(false),
+      m_child(nullptr),
+      m_child_state(State::NONE),
+      m_poll(nullptr),
+      m_awaiter(nullptr) {}
+
+  template<typename T>
+  Coroutine<T> CoroutinePromise<T>::get_return_object() noexcept {
+    return Coroutine<T>(
+      std::coroutine_handle<CoroutinePromise>::from_promise(*this));
+  }
+
+  template<typename T>
+  std::suspend_always CoroutinePromise<T>::initial_suspend() const noexcept {
+    return {};
+  }
+
+  template<typename T>
+  std::suspend_always CoroutinePromise<T>::final_suspend() const noexcept {
+    return {};
+  }
+
+  template<typename T>
+  template<typename U>
+  std::suspend_always CoroutinePromise<T>::yield_value(U&& value) noexcept(
+      std::is_nothrow_constructible_v<T, U&&>) {
+    if(m_is_looking_ahead) {
+      m_next_value = std::forward<U>(value);
+      m_has_next_value = true;
+    } else {
+      m_value = std::forward<U>(value);
+    }
+    m_state = State::CONTINUE_EVALUATED;
+    return {};
+  }
+
+  template<typename T>
+  template<typename R>
+  CoroutinePromise<T>::ChildAwaiter<std::remove_reference_t<R>>
+      CoroutinePromise<T>::await_transform(R&& reactor) noexcept {
+    return {&reactor, this, State::NONE};
+  }
+
+  template<typename T>
+  void CoroutinePromise<T>::return_void() noexcept {
+    m_state = State::COMPLETE;
+  }
+
+  template<typename T>
+  void CoroutinePromise<T>::unhandled_exception() noexcept {
+    if(m_is_looking_ahead) {
+      m_next_value = current_error();
+      m_has_next_value = true;
+    } else {
+      m_value = current_error();
+    }
+    m_state = State::COMPLETE_EVALUATED;
+  }
+
+  template<typename T>
+  void* CoroutinePromise<T>::operator new(std::size_t size) {
+    return CoroutineFrameAllocator::allocate(size);
+  }
+
+  template<typename T>
+  void CoroutinePromise<T>::operator delete(void* frame,
+      std::size_t size) noexcept {
+    CoroutineFrameAllocator::release(frame, size);
+  }
+
+  template<typename T>
+  template<typename R>
+  State CoroutinePromise<T>::ChildAwaiter<R>::poll(void* awaiter,
+      int sequence) noexcept {
+    auto& self = *static_cast<ChildAwaiter*>(awaiter);
+    self.commit(sequence);
+    return self.m_state;
+  }
+
+  template<typename T>
+  template<typename R>
+  bool CoroutinePromise<T>::ChildAwaiter<R>::commit(int sequence) noexcept {
+    m_promise->m_has_committed_child = true;
+    m_state = m_reactor->commit(sequence);
+    m_promise->m_child = m_reactor;
+    m_promise->m_child_state = m_state;
+    return has_evaluation(m_state) || is_complete(m_state);
+  }
+
+  template<typename T>
+  template<typename R>
+  bool CoroutinePromise<T>::ChildAwaiter<R>::await_ready() noexcept {
+    if(m_promise->m_has_committed_child) {
+      if(m_promise->m_child == m_reactor &&
+          !has_continuation(m_promise->m_child_state)) {
+        m_state = State::NONE;
+      } else {
+        m_state = State::CONTINUE;
+      }
+      return false;
+    }
+    return commit(m_promise->m_sequence);
+  }
+
+  template<typename T>
+  template<typename R>
+  void CoroutinePromise<T>::ChildAwaiter<R>::await_suspend(
+      std::coroutine_handle<>) noexcept {
+    m_promise->m_poll = &poll;
+    m_promise->m_awaiter = this;
+    if(has_continuation(m_state)) {
+      m_promise->m_state = State::CONTINUE;
+    } else {
+      m_promise->m_state = State::NONE;
+    }
+  }
+
+  template<typename T>
+  template<typename R>
+  decltype(auto) CoroutinePromise<T>::ChildAwaiter<R>::await_resume() const {
+    if(!has_evaluation(m_state)) {
+      ASPEN_THROW(std::runtime_error("Reactor completed without evaluating."));
+    }
+    return m_reactor->eval();
+  }
+}
+
+  template<typename T>
+  Coroutine<T>::Coroutine(std::coroutine_handle<promise_type> handle) noexcept
+    : m_handle(handle) {}
+
+  template<typename T>
+  Coroutine<T>::Coroutine(Coroutine&& coroutine) noexcept
+    : m_handle(std::exchange(coroutine.m_handle, nullptr)) {}
+
+  template<typename T>
+  Coroutine<T>::~Coroutine() {
+    if(m_handle) {
+      m_handle.destroy();
+    }
+  }
+
+  template<typename T>
+  State Coroutine<T>::commit(int sequence) noexcept {
+    auto& promise = m_handle.promise();
+    if(sequence == promise.m_sequence || is_complete(promise.m_state)) {
+      return promise.m_state;
+    }
+    promise.m_sequence = sequence;
+    promise.m_has_committed_child = false;
+    if(promise.m_has_next_value) {
+      promise.m_value = std::move(promise.m_next_value);
+      promise.m_has_next_value = false;
+      if(m_handle.done()) {
+        promise.m_state = State::COMPLETE_EVALUATED;
+        return promise.m_state;
+      }
+    } else {
+      if(promise.m_poll != nullptr) {
+        auto state = promise.m_poll(promise.m_awaiter, sequence);
+        if(!has_evaluation(state) && !is_complete(state)) {
+          if(has_continuation(state)) {
+            promise.m_state = State::CONTINUE;
+          } else {
+            promise.m_state = State::NONE;
+          }
+          return promise.m_state;
+        }
+        promise.m_poll = nullptr;
+      }
+      m_handle.resume();
+      if(promise.m_state != State::CONTINUE_EVALUATED) {
+        return promise.m_state;
+      }
+    }
+    promise.m_is_looking_ahead = true;
+    m_handle.resume();
+    promise.m_is_looking_ahead = false;
+    if(promise.m_has_next_value) {
+      promise.m_state = State::CONTINUE_EVALUATED;
+    } else if(m_handle.done()) {
+      promise.m_state = State::COMPLETE_EVALUATED;
+    } else if(has_continuation(promise.m_state)) {
+      promise.m_state = State::CONTINUE_EVALUATED;
+    } else {
+      promise.m_state = State::EVALUATED;
+    }
+    return promise.m_state;
+  }
+
+  template<typename T>
+  eval_result_t<typename Coroutine<T>::Type> Coroutine<T>::eval() const {
+    return m_handle.promise().m_value;
+  }
+
+  template<typename T>
+  Error Coroutine<T>::get_error() const noexcept {
+    return m_handle.promise().m_value.get_exception();
+  }
+
+  template<typename T>
+  Coroutine<T>& Coroutine<T>::operator =(Coroutine&& coroutine) noexcept {
+    if(m_handle) {
+      m_handle.destroy();
+    }
+    m_handle = std::exchange(coroutine.m_handle, nullptr);
+    return *this;
+  }
+}
+
+#endif
+#endif
@@ -1,18 +1,105 @@
 #ifndef ASPEN_COUNT_HPP
 #define ASPEN_COUNT_HPP
+#include <type_traits>
 #include <utility>
-#include "Aspen/Lift.hpp"
+#include <vector>
+#include "Aspen/Batch.hpp"
+#include "Aspen/Maybe.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/Traits.hpp"
 
 namespace Aspen {
 
+  /**
+   * Implements a reactor that counts the number of evaluations produced by
+   * its child.
+   * @param <R> The type of reactor to count.
+   */
+  template<typename R>
+  class Count {
+    public:
+      using Reactor = R;
+      using Type = int;
+
+      /**
+       * Constructs a Count.
+       * @param series The reactor whose evaluations are counted.
+       */
+      template<typename RF, typename = std::enable_if_t<
+        !std::is_base_of_v<Count, std::decay_t<RF>>>>
+      explicit Count(RF&& series);
+
+      State commit(int sequence) noexcept;
+
+      const Type& eval() const noexcept;
+
+      /**
+       * Commits this reactor, counting every value in the child's batch.
+       * Only available if the child is batch-aware.
+       * @param sequence The commit's sequence.
+       */
+      template<bool B = is_batch_reactor_v<Reactor>,
+        typename = std::enable_if_t<B>>
+      State commit_batch(int sequence) noexcept;
+
+      /** Returns the counts evaluated by the last call to commit_batch. */
+      template<bool B = is_batch_reactor_v<Reactor>,
+        typename = std::enable_if_t<B>>
+      Batch<Type> eval_batch() const;
+
+    private:
+      Reactor m_series;
+      Type m_count;
+      std::vector<Maybe<Type>> m_batch;
+  };
+
+  template<typename R>
+  Count(R&&) -> Count<to_reactor_t<R>>;
+
   /** Counts the number of evaluations produced by a reactor. */
   template<typename T>
   auto count(T&& series) {
-    return lift(
-      [counter = 0] (auto&& value) mutable noexcept {
-        ++counter;
-        return counter;
-      }, std::forward<T>(series));
+    return Count(std::forward<T>(series));
+  }
+
+  template<typename R>
+  template<typename RF, typename>
+  Count<R>::Count(RF&& series)
+    : m_series(std::forward<RF>(series)),
+      m_count(0) {}
+
+  template<typename R>
+  State Count<R>::commit(int sequence) noexcept {
+    auto state = m_series.commit(sequence);
+    if(has_evaluation(state)) {
+      ++m_count;
+    }
+    return state;
+  }
+
+  template<typename R>
+  const typename Count<R>::Type& Count<R>::eval() const noexcept {
+    return m_count;
+  }
+
+  template<typename R>
+  template<bool B, typename>
+  State Count<R>::commit_batch(int sequence) noexcept {
+    m_batch.clear();
+    auto state = m_series.commit_batch(sequence);
+    if(has_evaluation(state)) {
+      for(auto i = m_series.eval_batch().size(); i != 0; --i) {
+        ++m_count;
+        m_batch.emplace_back(m_count);
+      }
+    }
+    return state;
+  }
+
+  template<typename R>
+  template<bool B, typename>
+  Batch<typename Count<R>::Type> Count<R>::eval_batch() const {
+    return Batch<Type>(m_batch.data(), m_batch.size());
   }
 }
 
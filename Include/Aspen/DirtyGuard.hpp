@@ -0,0 +1,137 @@
+#ifndef ASPEN_DIRTY_GUARD_HPP
+#define ASPEN_DIRTY_GUARD_HPP
+#include <atomic>
+#include <memory>
+#include <utility>
+#include "Aspen/Error.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/Traits.hpp"
+#include "Aspen/Trigger.hpp"
+
+namespace Aspen {
+
+  /**
+   * Implements a reactor that only commits its child when one of the child's
+   * sources has signalled an update or the child requested a continuation.
+   * Sources committed beneath the guard capture the guard's Trigger, which
+   * marks the guard dirty before forwarding the signal to the enclosing
+   * Trigger, so a sequence skips every clean subtree instead of walking it.
+   * Placing guards around the branches of a large graph makes the cost of a
+   * commit proportional to the number of branches that changed.
+   *
+   * A source captures the Trigger of the first commit that reaches it, so a
+   * source shared between several guards, such as through a Shared reactor,
+   * only marks the first of them dirty; such sources should be committed
+   * outside of any guard.
+   * @param <R> The type of reactor to guard.
+   */
+  template<typename R>
+  class DirtyGuard {
+    public:
+      using Reactor = R;
+      using Type = reactor_result_t<Reactor>;
+      static constexpr auto is_noexcept = is_noexcept_reactor_v<Reactor>;
+
+      /**
+       * Constructs a DirtyGuard.
+       * @param reactor The reactor to guard.
+       */
+      template<typename RF>
+      explicit DirtyGuard(RF&& reactor);
+
+      /** Returns <code>true</code> iff the child must be committed. */
+      bool is_dirty() const noexcept;
+
+      State commit(int sequence) noexcept;
+
+      eval_result_t<Type> eval() const noexcept(is_noexcept);
+
+      /** Returns the error the child evaluates to, if any. */
+      Error get_error() const noexcept;
+
+    private:
+      struct Node {
+        std::atomic_bool m_is_dirty;
+        Trigger* m_parent;
+        Trigger m_trigger;
+
+        Node();
+      };
+      Reactor m_reactor;
+      std::unique_ptr<Node> m_node;
+      State m_state;
+      int m_sequence;
+  };
+
+  template<typename R>
+  DirtyGuard(R&&) -> DirtyGuard<to_reactor_t<R>>;
+
+  /**
+   * Returns a reactor that skips committing its child while none of the
+   * child's sources have updates.
+   * @param reactor The reactor to guard.
+   */
+  template<typename R>
+  auto dirty_guard(R&& reactor) {
+    return DirtyGuard(std::forward<R>(reactor));
+  }
+
+  template<typename R>
+  template<typename RF>
+  DirtyGuard<R>::DirtyGuard(RF&& reactor)
+    : m_reactor(std::forward<RF>(reactor)),
+      m_node(std::make_unique<Node>()),
+      m_state(State::NONE),
+      m_sequence(-1) {}
+
+  template<typename R>
+  bool DirtyGuard<R>::is_dirty() const noexcept {
+    return has_continuation(m_state) ||
+      m_node->m_is_dirty.load(std::memory_order_acquire);
+  }
+
+  template<typename R>
+  State DirtyGuard<R>::commit(int sequence) noexcept {
+    if(sequence == m_sequence || is_complete(m_state)) {
+      return m_state;
+    }
+    m_sequence = sequence;
+    if(m_node->m_parent == nullptr) {
+      m_node->m_parent = Trigger::get_trigger();
+    }
+    if(!m_node->m_is_dirty.exchange(false, std::memory_order_acq_rel) &&
+        !has_continuation(m_state)) {
+      m_state = State::NONE;
+      return m_state;
+    }
+    auto parent = Trigger::get_trigger();
+    Trigger::set_trigger(m_node->m_trigger);
+    m_state = m_reactor.commit(sequence);
+    Trigger::set_trigger(parent);
+    return m_state;
+  }
+
+  template<typename R>
+  eval_result_t<typename DirtyGuard<R>::Type> DirtyGuard<R>::eval() const
+      noexcept(is_noexcept) {
+    return m_reactor.eval();
+  }
+
+  template<typename R>
+  Error DirtyGuard<R>::get_error() const noexcept {
+    return eval_error(m_reactor);
+  }
+
+  template<typename R>
+  DirtyGuard<R>::Node::Node()
+    : m_is_dirty(true),
+      m_parent(nullptr),
+      m_trigger([this] {
+        m_is_dirty.store(true, std::memory_order_release);
+        if(m_parent != nullptr) {
+          m_parent->signal();
+        }
+      }) {}
+}
+
+#endif
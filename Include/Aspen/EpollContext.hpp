@@ -0,0 +1,17 @@
+#ifndef ASPEN_EPOLL_CONTEXT_HPP
+#define ASPEN_EPOLL_CONTEXT_HPP
+
+namespace Aspen {
+  class EpollExecutor;
+
+namespace Details {
+
+  /**
+   * The EpollExecutor running on the calling thread, declared apart from the
+   * EpollExecutor so that a CommitPool can install it on its workers.
+   */
+  inline thread_local EpollExecutor* current_epoll_executor = nullptr;
+}
+}
+
+#endif
@@ -0,0 +1,411 @@
+#ifndef ASPEN_EPOLL_EXECUTOR_HPP
+#define ASPEN_EPOLL_EXECUTOR_HPP
+#if defined (__linux__)
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "Aspen/Box.hpp"
+#include "Aspen/EpollContext.hpp"
+#include "Aspen/Error.hpp"
+#include "Aspen/ExecutorStatistics.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/Maybe.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/TimerWheel.hpp"
+#include "Aspen/Trigger.hpp"
+
+namespace Aspen {
+namespace Details {
+  struct FileDescriptor {
+    int m_fd;
+
+    explicit FileDescriptor(int fd) noexcept;
+    ~FileDescriptor();
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator =(const FileDescriptor&) = delete;
+  };
+
+  inline FileDescriptor::FileDescriptor(int fd) noexcept
+    : m_fd(fd) {}
+
+  inline FileDescriptor::~FileDescriptor() {
+    if(m_fd != -1) {
+      ::close(m_fd);
+    }
+  }
+}
+
+  /**
+   * Runs a single reactor on the calling thread, waiting on an epoll instance
+   * so that file descriptors registered by the reactor are read directly on
+   * the executor's thread. Timers committed by the reactor are scheduled on a
+   * TimerWheel owned by the executor, whose next expiry bounds the wait.
+   */
+  class EpollExecutor {
+    public:
+
+      /** Stores the readiness of a file descriptor being monitored. */
+      struct Readiness {
+
+        /** Set to <code>true</code> when the file descriptor is readable. */
+        bool m_is_ready;
+
+        /**
+         * The Trigger signalled when the file descriptor becomes readable, or
+         * <code>nullptr</code>.
+         */
+        Trigger* m_trigger;
+      };
+
+      /**
+       * Constructs an EpollExecutor.
+       * @param reactor The reactor to execute.
+       */
+      template<typename R>
+      explicit EpollExecutor(R&& reactor);
+
+      /**
+       * Returns the EpollExecutor running on the calling thread, or
+       * <code>nullptr</code>.
+       */
+      static EpollExecutor* get_executor() noexcept;
+
+      /**
+       * Monitors a file descriptor for readability.
+       * @param fd The file descriptor to monitor.
+       * @param readiness Updated when the <i>fd</i> becomes readable, must
+       *        remain valid until the <i>fd</i> is removed.
+       */
+      void add(int fd, Readiness& readiness);
+
+      /**
+       * Stops monitoring a file descriptor.
+       * @param fd The file descriptor to stop monitoring.
+       */
+      void remove(int fd) noexcept;
+
+      /** Repeatedly executes the reactor until it completes or evaluates to
+       *  NONE.
+       */
+      void run_until_none();
+
+      /** Repeatedly executes the reactor until it completes or this executor
+       *  is closed.
+       */
+      void run_until_complete();
+
+      /** Causes run_until_complete to return, may be called from any thread. */
+      void close();
+
+      /**
+       * Returns a snapshot of the work this EpollExecutor has performed, may
+       * be called from any thread.
+       */
+      ExecutorStatistics get_statistics() const noexcept;
+
+    private:
+      static constexpr auto MAX_EVENTS = 64;
+      Details::FileDescriptor m_epoll;
+      Details::FileDescriptor m_event;
+      std::atomic_bool m_has_update;
+      std::atomic_bool m_is_closed;
+      Trigger m_trigger;
+      int m_sequence;
+      TimerWheel m_timers;
+      Box<void> m_reactor;
+      Details::StatisticsRecorder m_statistics;
+
+      EpollExecutor(const EpollExecutor&) = delete;
+      EpollExecutor& operator =(const EpollExecutor&) = delete;
+      void on_update();
+      void wait();
+  };
+
+  /**
+   * A reactor that reads from a file descriptor whenever it becomes readable.
+   * When committed within an EpollExecutor the file descriptor is monitored by
+   * that executor, otherwise it is read on every commit.
+   * @param <F> The type of function used to read from the file descriptor.
+   *        It is passed the file descriptor and returns a FunctionEvaluation,
+   *        where NONE indicates no more data is available and COMPLETE
+   *        indicates the end of the stream.
+   */
+  template<typename F>
+  class FileDescriptorReactor {
+    public:
+      using Type = Details::function_reactor_result_t<std::invoke_result_t<F,
+        int>>;
+
+      /** The type of function used to read from the file descriptor. */
+      using Reader = F;
+
+      /**
+       * Constructs a FileDescriptorReactor.
+       * @param fd The non-blocking file descriptor to read from, it is not
+       *        owned by this reactor.
+       * @param reader The function used to read from the <i>fd</i>.
+       */
+      template<typename FF>
+      FileDescriptorReactor(int fd, FF&& reader);
+
+      FileDescriptorReactor(FileDescriptorReactor&& reactor) = default;
+
+      ~FileDescriptorReactor();
+
+      State commit(int sequence) noexcept;
+
+      eval_result_t<Type> eval() const;
+
+      /** Returns the error the reader produced, if any. */
+      Error get_error() const noexcept;
+
+    private:
+      struct Registration {
+        int m_fd;
+        EpollExecutor* m_executor;
+        EpollExecutor::Readiness m_readiness;
+        bool m_is_complete;
+      };
+      Reader m_reader;
+      std::unique_ptr<Registration> m_registration;
+      Maybe<Type> m_value;
+
+      void unregister() noexcept;
+  };
+
+  template<typename F>
+  FileDescriptorReactor(int, F&&) -> FileDescriptorReactor<std::decay_t<F>>;
+
+  /**
+   * Returns a reactor that reads from a file descriptor.
+   * @param fd The non-blocking file descriptor to read from.
+   * @param reader The function used to read from the <i>fd</i>.
+   */
+  template<typename F>
+  auto read_fd(int fd, F&& reader) {
+    return FileDescriptorReactor(fd, std::forward<F>(reader));
+  }
+
+  template<typename R>
+  EpollExecutor::EpollExecutor(R&& reactor)
+      : m_epoll(::epoll_create1(EPOLL_CLOEXEC)),
+        m_event(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+        m_has_update(false),
+        m_is_closed(false),
+        m_trigger([=] { on_update(); }),
+        m_sequence(0),
+        m_reactor(std::forward<R>(reactor)) {
+    if(m_epoll.m_fd == -1 || m_event.m_fd == -1) {
+      ASPEN_THROW(std::runtime_error("Unable to create epoll instance."));
+    }
+    auto event = epoll_event();
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    ::epoll_ctl(m_epoll.m_fd, EPOLL_CTL_ADD, m_event.m_fd, &event);
+  }
+
+  inline EpollExecutor* EpollExecutor::get_executor() noexcept {
+    return Details::current_epoll_executor;
+  }
+
+  inline void EpollExecutor::add(int fd, Readiness& readiness) {
+    auto event = epoll_event();
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.ptr = &readiness;
+    if(::epoll_ctl(m_epoll.m_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+      ASPEN_THROW(std::runtime_error("Unable to monitor file descriptor."));
+    }
+  }
+
+  inline void EpollExecutor::remove(int fd) noexcept {
+    ::epoll_ctl(m_epoll.m_fd, EPOLL_CTL_DEL, fd, nullptr);
+  }
+
+  inline void EpollExecutor::run_until_none() {
+    auto old_trigger = Trigger::get_trigger();
+    auto old_wheel = TimerWheel::get_wheel();
+    auto old_executor = Details::current_epoll_executor;
+    Trigger::set_trigger(m_trigger);
+    TimerWheel::set_wheel(&m_timers);
+    Details::current_epoll_executor = this;
+    while(true) {
+      auto start = Details::StatisticsRecorder::Clock::now();
+      m_timers.advance(start);
+      auto state = m_reactor.commit(m_sequence);
+      ++m_sequence;
+      m_statistics.record_commit(state,
+        Details::StatisticsRecorder::Clock::now() - start);
+      if(!has_continuation(state)) {
+        break;
+      }
+    }
+    Details::current_epoll_executor = old_executor;
+    TimerWheel::set_wheel(old_wheel);
+    Trigger::set_trigger(old_trigger);
+  }
+
+  inline void EpollExecutor::run_until_complete() {
+    auto old_trigger = Trigger::get_trigger();
+    auto old_wheel = TimerWheel::get_wheel();
+    auto old_executor = Details::current_epoll_executor;
+    Trigger::set_trigger(m_trigger);
+    TimerWheel::set_wheel(&m_timers);
+    Details::current_epoll_executor = this;
+    auto start = Details::StatisticsRecorder::Clock::now();
+    while(!m_is_closed) {
+      m_timers.advance(start);
+      auto state = m_reactor.commit(m_sequence);
+      ++m_sequence;
+      auto end = Details::StatisticsRecorder::Clock::now();
+      m_statistics.record_commit(state, end - start);
+      start = end;
+      if(is_complete(state)) {
+        break;
+      } else if(!has_continuation(state)) {
+        wait();
+        start = Details::StatisticsRecorder::Clock::now();
+        m_statistics.record_wakeup(start - end);
+      }
+    }
+    Details::current_epoll_executor = old_executor;
+    TimerWheel::set_wheel(old_wheel);
+    Trigger::set_trigger(old_trigger);
+  }
+
+  inline void EpollExecutor::close() {
+    m_is_closed = true;
+    auto value = std::uint64_t(1);
+    auto result = ::write(m_event.m_fd, &value, sizeof(value));
+    static_cast<void>(result);
+  }
+
+  inline ExecutorStatistics EpollExecutor::get_statistics() const noexcept {
+    return m_statistics.load();
+  }
+
+  inline void EpollExecutor::on_update() {
+    if(!m_has_update.exchange(true)) {
+      auto value = std::uint64_t(1);
+      auto result = ::write(m_event.m_fd, &value, sizeof(value));
+      static_cast<void>(result);
+    }
+  }
+
+  inline void EpollExecutor::wait() {
+    epoll_event events[MAX_EVENTS];
+    auto timeout = -1;
+    if(auto expiry = m_timers.get_next_expiry()) {
+      auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+        *expiry - TimerWheel::Clock::now()).count();
+      timeout = static_cast<int>(std::clamp<decltype(remaining)>(remaining, 0,
+        std::numeric_limits<int>::max()));
+    }
+    auto count = ::epoll_wait(m_epoll.m_fd, events, MAX_EVENTS, timeout);
+    m_has_update = true;
+    for(auto i = 0; i < count; ++i) {
+      if(events[i].data.ptr == nullptr) {
+        auto value = std::uint64_t(0);
+        auto result = ::read(m_event.m_fd, &value, sizeof(value));
+        static_cast<void>(result);
+      } else {
+        auto& readiness = *static_cast<Readiness*>(events[i].data.ptr);
+        readiness.m_is_ready = true;
+        if(readiness.m_trigger != nullptr) {
+          readiness.m_trigger->signal();
+        }
+      }
+    }
+    m_timers.advance(TimerWheel::Clock::now());
+    m_has_update = false;
+  }
+
+  template<typename F>
+  template<typename FF>
+  FileDescriptorReactor<F>::FileDescriptorReactor(int fd, FF&& reader)
+    : m_reader(std::forward<FF>(reader)),
+      m_registration(std::make_unique<Registration>(
+        Registration{fd, nullptr, {true, nullptr}, false})) {}
+
+  template<typename F>
+  FileDescriptorReactor<F>::~FileDescriptorReactor() {
+    unregister();
+  }
+
+  template<typename F>
+  State FileDescriptorReactor<F>::commit(int) noexcept {
+    auto& registration = *m_registration;
+    if(registration.m_is_complete) {
+      return State::COMPLETE;
+    }
+    if(registration.m_executor == nullptr) {
+      if(auto executor = EpollExecutor::get_executor()) {
+        ASPEN_TRY {
+          registration.m_readiness.m_trigger = Trigger::get_trigger();
+          executor->add(registration.m_fd, registration.m_readiness);
+          registration.m_executor = executor;
+        } ASPEN_CATCH(...) {
+          m_value = current_error();
+          registration.m_is_complete = true;
+          return State::COMPLETE_EVALUATED;
+        }
+      }
+    }
+    if(!registration.m_readiness.m_is_ready) {
+      return State::NONE;
+    }
+    auto evaluation = [&] {
+      ASPEN_TRY {
+        return FunctionEvaluation<Type>(m_reader(registration.m_fd));
+      } ASPEN_CATCH(...) {
+        return FunctionEvaluation<Type>(Maybe<Type>(current_error()),
+          State::COMPLETE);
+      }
+    }();
+    if(evaluation.m_value.has_value()) {
+      m_value = std::move(*evaluation.m_value);
+    }
+    if(is_complete(evaluation.m_state)) {
+      unregister();
+      registration.m_is_complete = true;
+      return evaluation.m_state;
+    } else if(has_evaluation(evaluation.m_state)) {
+      return State::CONTINUE_EVALUATED;
+    }
+    if(registration.m_executor != nullptr) {
+      registration.m_readiness.m_is_ready = false;
+    }
+    return State::NONE;
+  }
+
+  template<typename F>
+  eval_result_t<typename FileDescriptorReactor<F>::Type>
+      FileDescriptorReactor<F>::eval() const {
+    return m_value;
+  }
+
+  template<typename F>
+  Error FileDescriptorReactor<F>::get_error() const noexcept {
+    return m_value.get_exception();
+  }
+
+  template<typename F>
+  void FileDescriptorReactor<F>::unregister() noexcept {
+    if(m_registration != nullptr && m_registration->m_executor != nullptr) {
+      m_registration->m_executor->remove(m_registration->m_fd);
+      m_registration->m_executor = nullptr;
+    }
+  }
+}
+
+#endif
+#endif
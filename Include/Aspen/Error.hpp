@@ -0,0 +1,98 @@
+#ifndef ASPEN_ERROR_HPP
+#define ASPEN_ERROR_HPP
+#include <cstdlib>
+#include <exception>
+#include <system_error>
+#include <type_traits>
+
+/**
+ * Defining ASPEN_NO_EXCEPTIONS builds the library without any use of C++
+ * exceptions, as required by -fno-exceptions. Errors are then represented
+ * by a std::error_code rather than a std::exception_ptr, and any attempt to
+ * raise an error aborts the process.
+ */
+#ifdef ASPEN_NO_EXCEPTIONS
+  #define ASPEN_TRY if(true)
+  #define ASPEN_CATCH(exception) else if(false)
+  #define ASPEN_THROW(exception) ::Aspen::raise(::Aspen::make_error(exception))
+  #define ASPEN_RETHROW ::std::abort()
+#else
+  #define ASPEN_TRY try
+  #define ASPEN_CATCH(exception) catch(exception)
+  #define ASPEN_THROW(exception) throw exception
+  #define ASPEN_RETHROW throw
+#endif
+
+namespace Aspen {
+
+#ifdef ASPEN_NO_EXCEPTIONS
+
+  /** Represents the error a reactor evaluates to. */
+  using Error = std::error_code;
+#else
+
+  /** Represents the error a reactor evaluates to. */
+  using Error = std::exception_ptr;
+#endif
+
+  /**
+   * Makes an Error. Without exceptions, error codes are stored as is and any
+   * other exception type is represented by std::errc::not_supported.
+   * @param exception The exception or error code the Error represents.
+   */
+  template<typename E>
+  Error make_error(const E& exception) noexcept {
+#ifdef ASPEN_NO_EXCEPTIONS
+    if constexpr(std::is_same_v<E, Error>) {
+      return exception;
+    } else if constexpr(std::is_error_code_enum_v<E> ||
+        std::is_same_v<E, std::errc>) {
+      return make_error_code(exception);
+    } else if constexpr(std::is_base_of_v<std::system_error, E>) {
+      return exception.code();
+    } else {
+      return std::make_error_code(std::errc::not_supported);
+    }
+#else
+    if constexpr(std::is_same_v<E, Error>) {
+      return exception;
+    } else if constexpr(std::is_same_v<E, std::error_code>) {
+      return std::make_exception_ptr(std::system_error(exception));
+    } else if constexpr(std::is_error_code_enum_v<E> ||
+        std::is_same_v<E, std::errc>) {
+      return std::make_exception_ptr(
+        std::system_error(make_error_code(exception)));
+    } else {
+      return std::make_exception_ptr(exception);
+    }
+#endif
+  }
+
+  /**
+   * Returns the Error currently being handled, or an empty Error if
+   * exceptions are disabled.
+   */
+  inline Error current_error() noexcept {
+#ifdef ASPEN_NO_EXCEPTIONS
+    return {};
+#else
+    return std::current_exception();
+#endif
+  }
+
+  /**
+   * Raises an Error by throwing the exception it represents, or aborts if
+   * exceptions are disabled.
+   * @param error The Error to raise.
+   */
+  [[noreturn]] inline void raise(const Error& error) {
+#ifdef ASPEN_NO_EXCEPTIONS
+    static_cast<void>(error);
+    std::abort();
+#else
+    std::rethrow_exception(error);
+#endif
+  }
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef ASPEN_EVAL_POLICY_HPP
+#define ASPEN_EVAL_POLICY_HPP
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "Aspen/Error.hpp"
+#include "Aspen/Maybe.hpp"
+
+namespace Aspen {
+
+  /** Specifies when a reactor computes the value it evaluates to. */
+  enum class EvalPolicy {
+
+    /** The value is computed during the commit that produces it. */
+    EAGER,
+
+    /** The value is computed every time it's evaluated. */
+    LAZY,
+
+    /**
+     * The value is computed the first time it's evaluated and reused until
+     * the next commit that produces a new value.
+     */
+    CACHED
+  };
+
+namespace Details {
+
+  /**
+   * Stores a computed value along with whether it needs to be recomputed.
+   * @param <T> The type of value stored.
+   * @param <IS_NOEXCEPT> Whether computing the value never throws.
+   */
+  template<typename T, bool IS_NOEXCEPT>
+  class EvalCache {
+    public:
+
+      /** Constructs a stale EvalCache. */
+      EvalCache();
+
+      /** Marks the stored value as needing to be recomputed. */
+      void invalidate() noexcept;
+
+      /**
+       * Computes and stores a value.
+       * @param f The function computing the value.
+       */
+      template<typename F>
+      void update(F&& f) noexcept;
+
+      /**
+       * Stores an error in place of the value.
+       * @param error The error to store.
+       */
+      void set_error(Error error) noexcept;
+
+      /**
+       * Returns the stored value, computing it first if it's stale.
+       * @param f The function computing the value.
+       */
+      template<typename F>
+      const T& get(F&& f) const noexcept(IS_NOEXCEPT);
+
+    private:
+      mutable std::conditional_t<IS_NOEXCEPT, std::optional<T>, Maybe<T>>
+        m_value;
+      mutable bool m_is_stale;
+  };
+
+  template<typename T, bool IS_NOEXCEPT>
+  EvalCache<T, IS_NOEXCEPT>::EvalCache()
+    : m_is_stale(true) {}
+
+  template<typename T, bool IS_NOEXCEPT>
+  void EvalCache<T, IS_NOEXCEPT>::invalidate() noexcept {
+    m_is_stale = true;
+  }
+
+  template<typename T, bool IS_NOEXCEPT>
+  template<typename F>
+  void EvalCache<T, IS_NOEXCEPT>::update(F&& f) noexcept {
+    m_value = try_call([&] () noexcept(IS_NOEXCEPT) { return f(); });
+    m_is_stale = false;
+  }
+
+  template<typename T, bool IS_NOEXCEPT>
+  void EvalCache<T, IS_NOEXCEPT>::set_error(Error error) noexcept {
+    static_assert(!IS_NOEXCEPT);
+    m_value = std::move(error);
+    m_is_stale = false;
+  }
+
+  template<typename T, bool IS_NOEXCEPT>
+  template<typename F>
+  const T& EvalCache<T, IS_NOEXCEPT>::get(F&& f) const noexcept(IS_NOEXCEPT) {
+    if(m_is_stale) {
+      m_value = try_call([&] () noexcept(IS_NOEXCEPT) { return f(); });
+      m_is_stale = false;
+    }
+    return *m_value;
+  }
+}
+}
+
+#endif
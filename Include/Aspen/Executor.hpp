@@ -1,54 +1,161 @@
 #ifndef ASPEN_EXECUTOR_HPP
 #define ASPEN_EXECUTOR_HPP
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <optional>
+#include <thread>
 #if defined WIN32
   #include <windows.h>
 #elif defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
   #include <signal.h>
 #endif
+#if defined (__linux__)
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
 #include <set>
+#include "Aspen/Affinity.hpp"
+#include "Aspen/Batch.hpp"
 #include "Aspen/Box.hpp"
+#include "Aspen/CommitBudget.hpp"
+#include "Aspen/ExecutorStatistics.hpp"
+#include "Aspen/TimerWheel.hpp"
 #include "Aspen/Trigger.hpp"
 
 namespace Aspen {
 
-  /** Provides a synchronized environment for running a single reactor. */
+  /** Lists the ways an Executor can wait for an update. */
+  enum class WaitStrategy : unsigned char {
+
+    //! Blocks on a mutex and condition variable.
+    BLOCK,
+
+    //! Busy-spins until an update arrives.
+    SPIN,
+
+    //! Spins briefly and then yields the thread until an update arrives.
+    YIELD,
+
+    //! Spins briefly and then parks the thread, only making a system call to
+    //! wake it up if it is actually parked.
+    PARK
+  };
+
+namespace Details {
+
+  /** Hints to the processor that the calling thread is spinning. */
+  inline void pause() noexcept {
+#if defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+    YieldProcessor();
+#elif defined (__x86_64__) || defined (__i386__)
+    __builtin_ia32_pause();
+#elif defined (__aarch64__)
+    asm volatile("yield");
+#endif
+  }
+}
+
+  /**
+   * Provides a synchronized environment for running a single reactor. Timers
+   * committed by the reactor are scheduled on a TimerWheel owned by the
+   * Executor, which bounds how long the Executor waits for an update. A
+   * batch-aware reactor is committed through commit_batch, so it consumes
+   * every value that is ready within a single sequence.
+   */
   class Executor {
     public:
 
       /**
-       * Constructs an Executor.
+       * Constructs an Executor that blocks while waiting for updates.
        * @param reactor The reactor to execute.
        */
       template<typename R>
       explicit Executor(R&& reactor);
 
-      /** Repeatedly executes the reactor until it completes or evaluates to
-       *  NONE.
+      /**
+       * Constructs an Executor.
+       * @param reactor The reactor to execute.
+       * @param strategy The strategy used to wait for updates.
+       */
+      template<typename R>
+      Executor(R&& reactor, WaitStrategy strategy);
+
+      /**
+       * Constructs an Executor.
+       * @param reactor The reactor to execute.
+       * @param strategy The strategy used to wait for updates.
+       * @param budget The number of consecutive commits or the duration after
+       *        which the Executor yields its thread.
+       */
+      template<typename R>
+      Executor(R&& reactor, WaitStrategy strategy, CommitBudget budget);
+
+      /**
+       * Constructs an Executor.
+       * @param reactor The reactor to execute.
+       * @param strategy The strategy used to wait for updates.
+       * @param budget The number of consecutive commits or the duration after
+       *        which the Executor yields its thread.
+       * @param affinity The placement applied to the thread calling
+       *        run_until_complete for as long as it runs.
+       */
+      template<typename R>
+      Executor(R&& reactor, WaitStrategy strategy, CommitBudget budget,
+        ThreadAffinity affinity);
+
+      /**
+       * Repeatedly executes the reactor until it completes, evaluates to NONE
+       * or exhausts its budget. If the budget is exhausted, the pending
+       * continuation is treated as an update.
        */
       void run_until_none();
 
-      /** Repeatedly executes the reactor until it completes. */
+      /**
+       * Repeatedly executes the reactor until it completes, yielding the
+       * thread and checking for an abort every time its budget is exhausted.
+       */
       void run_until_complete();
 
+      /**
+       * Returns a snapshot of the work this Executor has performed, may be
+       * called from any thread.
+       */
+      ExecutorStatistics get_statistics() const noexcept;
+
     private:
-      enum class Update : char {
+      enum class Update : int {
         NONE,
         UPDATE,
         ABORT
       };
+      static constexpr auto SPIN_COUNT = 1 << 10;
       static inline std::mutex m_abort_mutex;
       static inline std::set<Executor*> m_running_executors;
       std::mutex m_mutex;
       std::condition_variable m_update_condition;
       Trigger m_trigger;
       int m_sequence;
+      TimerWheel m_timers;
       Box<void> m_reactor;
-      Update m_has_update;
+      WaitStrategy m_strategy;
+      CommitBudget m_budget;
+      ThreadAffinity m_affinity;
+      std::atomic<Update> m_has_update;
+      std::atomic_bool m_is_parked;
+      Details::StatisticsRecorder m_statistics;
 
       void abort();
       void on_update();
+      void notify(Update update);
+      void advance();
+      bool wait();
+      bool wait_until(std::optional<TimerWheel::TimePoint> deadline);
+      void park(std::optional<TimerWheel::TimePoint> deadline);
+      void unpark();
 #if defined WIN32
       static BOOL __stdcall ctrl_handler(DWORD ctrl);
 #elif defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
@@ -60,24 +167,58 @@ namespace Aspen {
 
   template<typename R>
   Executor::Executor(R&& reactor)
+    : Executor(std::forward<R>(reactor), WaitStrategy::BLOCK) {}
+
+  template<typename R>
+  Executor::Executor(R&& reactor, WaitStrategy strategy)
+    : Executor(std::forward<R>(reactor), strategy, CommitBudget()) {}
+
+  template<typename R>
+  Executor::Executor(R&& reactor, WaitStrategy strategy, CommitBudget budget)
+    : Executor(std::forward<R>(reactor), strategy, budget, ThreadAffinity()) {}
+
+  template<typename R>
+  Executor::Executor(R&& reactor, WaitStrategy strategy, CommitBudget budget,
+    ThreadAffinity affinity)
     : m_trigger([=] { on_update(); }),
       m_sequence(0),
-      m_reactor(std::forward<R>(reactor)),
-      m_has_update(Update::NONE) {}
+      m_reactor(Details::commit_through_batch(std::forward<R>(reactor))),
+      m_strategy(strategy),
+      m_budget(budget),
+      m_affinity(std::move(affinity)),
+      m_has_update(Update::NONE),
+      m_is_parked(false) {}
 
   inline void Executor::run_until_none() {
     auto old_trigger = Trigger::get_trigger();
+    auto old_wheel = TimerWheel::get_wheel();
     Trigger::set_trigger(m_trigger);
-    while(has_continuation(m_reactor.commit(m_sequence))) {
+    TimerWheel::set_wheel(&m_timers);
+    auto meter = Details::BudgetMeter(m_budget);
+    while(true) {
+      auto start = Details::StatisticsRecorder::Clock::now();
+      advance();
+      auto state = m_reactor.commit(m_sequence);
       ++m_sequence;
+      m_statistics.record_commit(state,
+        Details::StatisticsRecorder::Clock::now() - start);
+      if(!has_continuation(state)) {
+        break;
+      } else if(meter.consume()) {
+        on_update();
+        break;
+      }
     }
-    ++m_sequence;
+    TimerWheel::set_wheel(old_wheel);
     Trigger::set_trigger(old_trigger);
   }
 
   inline void Executor::run_until_complete() {
+    auto affinity = AffinityGuard(m_affinity);
     auto old_trigger = Trigger::get_trigger();
+    auto old_wheel = TimerWheel::get_wheel();
     Trigger::set_trigger(m_trigger);
+    TimerWheel::set_wheel(&m_timers);
 #if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
     auto previous_handler = static_cast<sighandler_t>(nullptr);
 #endif
@@ -91,20 +232,32 @@ namespace Aspen {
 #endif
       m_running_executors.insert(this);
     }
+    auto meter = Details::BudgetMeter(m_budget);
+    auto start = Details::StatisticsRecorder::Clock::now();
     while(true) {
+      advance();
       auto state = m_reactor.commit(m_sequence);
       ++m_sequence;
+      auto end = Details::StatisticsRecorder::Clock::now();
+      m_statistics.record_commit(state, end - start);
+      start = end;
       if(is_complete(state)) {
         break;
       } else if(!has_continuation(state)) {
-        auto lock = std::unique_lock(m_mutex);
-        while(m_has_update == Update::NONE) {
-          m_update_condition.wait(lock);
+        auto is_running = wait();
+        start = Details::StatisticsRecorder::Clock::now();
+        m_statistics.record_wakeup(start - end);
+        if(!is_running) {
+          break;
         }
-        if(m_has_update == Update::ABORT) {
+        meter.reset();
+      } else if(meter.consume()) {
+        if(m_has_update.load() == Update::ABORT) {
           break;
         }
-        m_has_update = Update::NONE;
+        std::this_thread::yield();
+        start = Details::StatisticsRecorder::Clock::now();
+        meter.reset();
       }
     }
     {
@@ -117,23 +270,139 @@ namespace Aspen {
     ::signal(SIGINT, previous_handler);
 #endif
     }
+    TimerWheel::set_wheel(old_wheel);
     Trigger::set_trigger(old_trigger);
   }
 
+  inline ExecutorStatistics Executor::get_statistics() const noexcept {
+    return m_statistics.load();
+  }
+
   inline void Executor::abort() {
+    notify(Update::ABORT);
+  }
+
+  inline void Executor::on_update() {
+    notify(Update::UPDATE);
+  }
+
+  inline void Executor::notify(Update update) {
+    if(m_strategy == WaitStrategy::BLOCK) {
+      {
+        auto lock = std::lock_guard(m_mutex);
+        if(m_has_update.load(std::memory_order_relaxed) != Update::ABORT) {
+          m_has_update.store(update, std::memory_order_relaxed);
+        }
+      }
+      m_update_condition.notify_one();
+      return;
+    }
+    if(update == Update::ABORT) {
+      m_has_update.store(update);
+    } else {
+      auto expected = Update::NONE;
+      if(!m_has_update.compare_exchange_strong(expected, update)) {
+        return;
+      }
+    }
+    if(m_strategy == WaitStrategy::PARK && m_is_parked.load()) {
+      unpark();
+    }
+  }
+
+  inline void Executor::advance() {
+    m_timers.advance(TimerWheel::Clock::now());
+  }
+
+  inline bool Executor::wait() {
+    while(!wait_until(m_timers.get_next_expiry())) {
+      advance();
+      if(m_has_update.load(std::memory_order_relaxed) != Update::NONE) {
+        break;
+      }
+    }
+    return m_has_update.exchange(Update::NONE) != Update::ABORT;
+  }
+
+  inline bool Executor::wait_until(
+      std::optional<TimerWheel::TimePoint> deadline) {
+    if(m_strategy == WaitStrategy::BLOCK) {
+      auto lock = std::unique_lock(m_mutex);
+      while(m_has_update.load(std::memory_order_relaxed) == Update::NONE) {
+        if(!deadline) {
+          m_update_condition.wait(lock);
+        } else if(m_update_condition.wait_until(lock, *deadline) ==
+            std::cv_status::timeout) {
+          return m_has_update.load(std::memory_order_relaxed) != Update::NONE;
+        }
+      }
+      return true;
+    }
+    auto spins = 0;
+    while(m_has_update.load(std::memory_order_acquire) == Update::NONE) {
+      if(deadline && TimerWheel::Clock::now() >= *deadline) {
+        return false;
+      }
+      if(m_strategy == WaitStrategy::SPIN || spins < SPIN_COUNT) {
+        Details::pause();
+        ++spins;
+      } else if(m_strategy == WaitStrategy::YIELD) {
+        std::this_thread::yield();
+      } else {
+        park(deadline);
+      }
+    }
+    return true;
+  }
+
+  inline void Executor::park(std::optional<TimerWheel::TimePoint> deadline) {
+    m_is_parked.store(true);
+#if defined (__linux__)
+    static_assert(sizeof(m_has_update) == sizeof(int));
+    if(m_has_update.load() == Update::NONE) {
+      auto timeout = timespec();
+      auto timeout_pointer = static_cast<timespec*>(nullptr);
+      if(deadline) {
+        auto remaining = std::max(*deadline - TimerWheel::Clock::now(),
+          TimerWheel::Duration::zero());
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+          remaining);
+        timeout.tv_sec = static_cast<time_t>(seconds.count());
+        timeout.tv_nsec = static_cast<long>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+            remaining - seconds).count());
+        timeout_pointer = &timeout;
+      }
+      ::syscall(SYS_futex, reinterpret_cast<int*>(&m_has_update),
+        FUTEX_WAIT_PRIVATE, static_cast<int>(Update::NONE), timeout_pointer,
+        nullptr, 0);
+    }
+#else
     {
-      auto lock = std::lock_guard(m_mutex);
-      m_has_update = Update::ABORT;
+      auto lock = std::unique_lock(m_mutex);
+      while(m_has_update.load() == Update::NONE) {
+        if(!deadline) {
+          m_update_condition.wait(lock);
+        } else if(m_update_condition.wait_until(lock, *deadline) ==
+            std::cv_status::timeout) {
+          break;
+        }
+      }
     }
-    m_update_condition.notify_one();
+#endif
+    m_is_parked.store(false);
   }
 
-  inline void Executor::on_update() {
+  inline void Executor::unpark() {
+#if defined (__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<int*>(&m_has_update),
+      FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
     {
       auto lock = std::lock_guard(m_mutex);
-      m_has_update = Update::UPDATE;
     }
     m_update_condition.notify_one();
+#endif
   }
 
 #if defined WIN32
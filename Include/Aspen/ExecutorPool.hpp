@@ -0,0 +1,470 @@
+#ifndef ASPEN_EXECUTOR_POOL_HPP
+#define ASPEN_EXECUTOR_POOL_HPP
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Aspen/Affinity.hpp"
+#include "Aspen/Box.hpp"
+#include "Aspen/CommitBudget.hpp"
+#include "Aspen/Error.hpp"
+#include "Aspen/ExecutorStatistics.hpp"
+#include "Aspen/TimerWheel.hpp"
+#include "Aspen/Trigger.hpp"
+
+namespace Aspen {
+
+  /**
+   * Runs any number of reactors on a fixed set of worker threads, where each
+   * worker maintains its own queue of runnable reactors and steals from the
+   * other workers when its own queue is empty. Each reactor has its own
+   * TimerWheel, which is advanced by whichever worker commits the reactor,
+   * and the workers wake the reactor once its next timer is due.
+   */
+  class ExecutorPool {
+    public:
+
+      /**
+       * Constructs an ExecutorPool.
+       * @param thread_count The number of worker threads to run.
+       */
+      explicit ExecutorPool(std::size_t thread_count);
+
+      /**
+       * Constructs an ExecutorPool.
+       * @param thread_count The number of worker threads to run.
+       * @param budget The number of consecutive commits or the duration after
+       *        which a reactor is moved behind the worker's other reactors.
+       */
+      ExecutorPool(std::size_t thread_count, CommitBudget budget);
+
+      /**
+       * Constructs an ExecutorPool with one worker thread per affinity. Each
+       * worker applies its affinity before running any reactors, so that
+       * memory allocated while committing resides on the worker's NUMA node.
+       * A worker whose affinity can't be applied runs unrestricted and
+       * reports the failure through get_affinity_error. The constructor
+       * returns once every worker has applied its affinity.
+       * @param affinities The placement of each worker thread.
+       * @param budget The number of consecutive commits or the duration after
+       *        which a reactor is moved behind the worker's other reactors.
+       */
+      ExecutorPool(std::vector<ThreadAffinity> affinities,
+        CommitBudget budget);
+
+      /** Constructs an ExecutorPool with one worker per hardware thread. */
+      ExecutorPool();
+
+      /** Stops all worker threads, abandoning any incomplete reactors. */
+      ~ExecutorPool();
+
+      /** Returns the number of worker threads. */
+      std::size_t get_thread_count() const noexcept;
+
+      /**
+       * Returns the error raised applying a worker's affinity, or an empty
+       * Error if it was applied.
+       * @param worker The index of the worker.
+       */
+      Error get_affinity_error(std::size_t worker) const;
+
+      /**
+       * Adds a reactor to execute. The reactor is destroyed once it completes
+       * and its slot is reused by subsequent calls to add.
+       * @param reactor The reactor to execute.
+       */
+      template<typename R>
+      void add(R&& reactor);
+
+      /** Blocks until every reactor added to this pool has completed. */
+      void wait();
+
+      /**
+       * Returns a snapshot of the work performed by all workers combined, may
+       * be called from any thread. Continuation chains are measured per time
+       * slice, so a chain ends whenever its reactor leaves the worker.
+       */
+      ExecutorStatistics get_statistics() const noexcept;
+
+    private:
+      enum class Status : int {
+        IDLE,
+        SCHEDULED,
+        RUNNING,
+        PENDING,
+        COMPLETE
+      };
+      struct Task {
+        ExecutorPool* m_pool;
+        TimerWheel m_timers;
+        std::optional<Box<void>> m_reactor;
+        Trigger m_trigger;
+        std::atomic<Status> m_status;
+        std::atomic<std::size_t> m_worker;
+        int m_sequence;
+        std::optional<TimerWheel::TimePoint> m_deadline;
+
+        Task(ExecutorPool& pool, std::size_t worker, Box<void> reactor);
+      };
+      struct Worker {
+        std::mutex m_mutex;
+        std::deque<Task*> m_tasks;
+        Details::StatisticsRecorder m_statistics;
+        Error m_affinity_error;
+      };
+      std::vector<std::unique_ptr<Worker>> m_workers;
+      std::vector<std::thread> m_threads;
+      std::mutex m_mutex;
+      std::condition_variable m_task_condition;
+      std::condition_variable m_completion_condition;
+      std::deque<std::unique_ptr<Task>> m_tasks;
+      std::vector<Task*> m_free_tasks;
+      std::set<std::pair<TimerWheel::TimePoint, Task*>> m_deadlines;
+      std::atomic<TimerWheel::TimePoint> m_next_deadline;
+      std::atomic<std::size_t> m_pending_count;
+      std::atomic<std::size_t> m_idle_count;
+      std::size_t m_running_count;
+      std::size_t m_next_worker;
+      std::atomic<bool> m_is_stopping;
+      CommitBudget m_budget;
+
+      ExecutorPool(const ExecutorPool&) = delete;
+      ExecutorPool& operator =(const ExecutorPool&) = delete;
+      void schedule(Task& task);
+      void push(std::size_t worker, Task& task);
+      void defer(std::size_t worker, Task& task);
+      Task* pop(std::size_t worker);
+      void add_deadline(TimerWheel::TimePoint deadline, Task& task);
+      void remove_deadline(Task& task);
+      void expire();
+      void run(Task& task, std::size_t worker);
+      void run(std::size_t worker);
+  };
+
+  inline ExecutorPool::ExecutorPool(std::size_t thread_count)
+    : ExecutorPool(thread_count, CommitBudget()) {}
+
+  inline ExecutorPool::ExecutorPool(std::size_t thread_count,
+    CommitBudget budget)
+    : ExecutorPool(std::vector<ThreadAffinity>(
+        std::max<std::size_t>(thread_count, 1)), budget) {}
+
+  inline ExecutorPool::ExecutorPool(std::vector<ThreadAffinity> affinities,
+      CommitBudget budget)
+      : m_next_deadline(TimerWheel::TimePoint::max()),
+        m_pending_count(0),
+        m_idle_count(0),
+        m_running_count(0),
+        m_next_worker(0),
+        m_is_stopping(false),
+        m_budget(budget) {
+    if(affinities.empty()) {
+      affinities.emplace_back();
+    }
+    for(auto i = std::size_t(0); i != affinities.size(); ++i) {
+      m_workers.push_back(std::make_unique<Worker>());
+    }
+    auto started_count = std::size_t(0);
+    for(auto i = std::size_t(0); i != affinities.size(); ++i) {
+      m_threads.emplace_back([&, i, affinity = std::move(affinities[i])] {
+        if(!affinity.is_unrestricted()) {
+          ASPEN_TRY {
+            set_thread_affinity(affinity);
+          } ASPEN_CATCH(const std::exception&) {
+            m_workers[i]->m_affinity_error = current_error();
+          }
+        }
+        {
+          auto lock = std::lock_guard(m_mutex);
+          ++started_count;
+        }
+        m_completion_condition.notify_all();
+        run(i);
+      });
+    }
+    auto lock = std::unique_lock(m_mutex);
+    while(started_count != m_threads.size()) {
+      m_completion_condition.wait(lock);
+    }
+  }
+
+  inline ExecutorPool::ExecutorPool()
+    : ExecutorPool(std::thread::hardware_concurrency()) {}
+
+  inline ExecutorPool::~ExecutorPool() {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      m_is_stopping = true;
+    }
+    m_task_condition.notify_all();
+    for(auto& thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  inline std::size_t ExecutorPool::get_thread_count() const noexcept {
+    return m_threads.size();
+  }
+
+  template<typename R>
+  void ExecutorPool::add(R&& reactor) {
+    auto box = Box<void>(std::forward<R>(reactor));
+    auto task = [&] {
+      auto lock = std::lock_guard(m_mutex);
+      auto worker = m_next_worker;
+      m_next_worker = (m_next_worker + 1) % m_workers.size();
+      ++m_running_count;
+      if(m_free_tasks.empty()) {
+        m_tasks.push_back(
+          std::make_unique<Task>(*this, worker, std::move(box)));
+        return m_tasks.back().get();
+      }
+      auto task = m_free_tasks.back();
+      m_free_tasks.pop_back();
+      task->m_reactor.emplace(std::move(box));
+      task->m_worker.store(worker, std::memory_order_relaxed);
+      task->m_sequence = 0;
+      task->m_status.store(Status::IDLE);
+      return task;
+    }();
+    schedule(*task);
+  }
+
+  inline void ExecutorPool::wait() {
+    auto lock = std::unique_lock(m_mutex);
+    while(m_running_count != 0) {
+      m_completion_condition.wait(lock);
+    }
+  }
+
+  inline Error ExecutorPool::get_affinity_error(std::size_t worker) const {
+    return m_workers[worker]->m_affinity_error;
+  }
+
+  inline ExecutorStatistics ExecutorPool::get_statistics() const noexcept {
+    auto statistics = ExecutorStatistics();
+    for(auto& worker : m_workers) {
+      statistics += worker->m_statistics.load();
+    }
+    return statistics;
+  }
+
+  inline ExecutorPool::Task::Task(ExecutorPool& pool, std::size_t worker,
+    Box<void> reactor)
+    : m_pool(&pool),
+      m_reactor(std::move(reactor)),
+      m_trigger([=] { m_pool->schedule(*this); }),
+      m_status(Status::IDLE),
+      m_worker(worker),
+      m_sequence(0) {}
+
+  inline void ExecutorPool::schedule(Task& task) {
+    auto status = task.m_status.load();
+    while(true) {
+      if(status == Status::IDLE) {
+        if(task.m_status.compare_exchange_weak(status, Status::SCHEDULED)) {
+          push(task.m_worker.load(std::memory_order_relaxed), task);
+          return;
+        }
+      } else if(status == Status::RUNNING) {
+        if(task.m_status.compare_exchange_weak(status, Status::PENDING)) {
+          return;
+        }
+      } else {
+        return;
+      }
+    }
+  }
+
+  inline void ExecutorPool::push(std::size_t worker, Task& task) {
+    ++m_pending_count;
+    {
+      auto lock = std::lock_guard(m_workers[worker]->m_mutex);
+      m_workers[worker]->m_tasks.push_back(&task);
+    }
+    if(m_idle_count.load() != 0) {
+      {
+        auto lock = std::lock_guard(m_mutex);
+      }
+      m_task_condition.notify_one();
+    }
+  }
+
+  inline void ExecutorPool::defer(std::size_t worker, Task& task) {
+    ++m_pending_count;
+    {
+      auto lock = std::lock_guard(m_workers[worker]->m_mutex);
+      m_workers[worker]->m_tasks.push_front(&task);
+    }
+    if(m_idle_count.load() != 0) {
+      {
+        auto lock = std::lock_guard(m_mutex);
+      }
+      m_task_condition.notify_one();
+    }
+  }
+
+  inline ExecutorPool::Task* ExecutorPool::pop(std::size_t worker) {
+    {
+      auto& self = *m_workers[worker];
+      auto lock = std::lock_guard(self.m_mutex);
+      if(!self.m_tasks.empty()) {
+        auto task = self.m_tasks.back();
+        self.m_tasks.pop_back();
+        --m_pending_count;
+        return task;
+      }
+    }
+    for(auto i = std::size_t(1); i != m_workers.size(); ++i) {
+      auto& victim = *m_workers[(worker + i) % m_workers.size()];
+      auto lock = std::lock_guard(victim.m_mutex);
+      if(!victim.m_tasks.empty()) {
+        auto task = victim.m_tasks.front();
+        victim.m_tasks.pop_front();
+        --m_pending_count;
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  inline void ExecutorPool::add_deadline(TimerWheel::TimePoint deadline,
+      Task& task) {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      if(task.m_deadline == deadline) {
+        return;
+      }
+      remove_deadline(task);
+      task.m_deadline = deadline;
+      m_deadlines.emplace(deadline, &task);
+      m_next_deadline.store(m_deadlines.begin()->first);
+    }
+    m_task_condition.notify_one();
+  }
+
+  inline void ExecutorPool::remove_deadline(Task& task) {
+    if(!task.m_deadline) {
+      return;
+    }
+    m_deadlines.erase(std::pair(*task.m_deadline, &task));
+    task.m_deadline = std::nullopt;
+    if(m_deadlines.empty()) {
+      m_next_deadline.store(TimerWheel::TimePoint::max());
+    } else {
+      m_next_deadline.store(m_deadlines.begin()->first);
+    }
+  }
+
+  inline void ExecutorPool::expire() {
+    auto now = TimerWheel::Clock::now();
+    if(now < m_next_deadline.load()) {
+      return;
+    }
+    auto tasks = std::vector<Task*>();
+    {
+      auto lock = std::lock_guard(m_mutex);
+      while(!m_deadlines.empty() && m_deadlines.begin()->first <= now) {
+        auto task = m_deadlines.begin()->second;
+        task->m_deadline = std::nullopt;
+        tasks.push_back(task);
+        m_deadlines.erase(m_deadlines.begin());
+      }
+      if(m_deadlines.empty()) {
+        m_next_deadline.store(TimerWheel::TimePoint::max());
+      } else {
+        m_next_deadline.store(m_deadlines.begin()->first);
+      }
+    }
+    for(auto task : tasks) {
+      schedule(*task);
+    }
+  }
+
+  inline void ExecutorPool::run(Task& task, std::size_t worker) {
+    task.m_worker.store(worker, std::memory_order_relaxed);
+    task.m_status.store(Status::RUNNING);
+    Trigger::set_trigger(task.m_trigger);
+    TimerWheel::set_wheel(&task.m_timers);
+    auto meter = Details::BudgetMeter(m_budget);
+    auto& statistics = m_workers[worker]->m_statistics;
+    while(true) {
+      auto start = Details::StatisticsRecorder::Clock::now();
+      task.m_timers.advance(start);
+      auto state = task.m_reactor->commit(task.m_sequence);
+      ++task.m_sequence;
+      statistics.record_commit(state,
+        Details::StatisticsRecorder::Clock::now() - start);
+      if(is_complete(state)) {
+        task.m_reactor.reset();
+        task.m_status.store(Status::COMPLETE);
+        auto lock = std::lock_guard(m_mutex);
+        remove_deadline(task);
+        m_free_tasks.push_back(&task);
+        --m_running_count;
+        if(m_running_count == 0) {
+          m_completion_condition.notify_all();
+        }
+        break;
+      } else if(!has_continuation(state) || m_is_stopping) {
+        auto deadline = task.m_timers.get_next_expiry();
+        auto status = Status::RUNNING;
+        if(task.m_status.compare_exchange_strong(status, Status::IDLE)) {
+          if(deadline) {
+            add_deadline(*deadline, task);
+          }
+          break;
+        }
+        task.m_status.store(Status::SCHEDULED);
+        push(worker, task);
+        break;
+      } else if(meter.consume()) {
+        task.m_status.store(Status::SCHEDULED);
+        defer(worker, task);
+        break;
+      }
+    }
+    statistics.end_chain();
+    TimerWheel::set_wheel(nullptr);
+    Trigger::set_trigger(nullptr);
+  }
+
+  inline void ExecutorPool::run(std::size_t worker) {
+    while(!m_is_stopping) {
+      expire();
+      if(auto task = pop(worker)) {
+        run(*task, worker);
+        continue;
+      }
+      auto lock = std::unique_lock(m_mutex);
+      ++m_idle_count;
+      if(m_pending_count.load() == 0 && !m_is_stopping) {
+        auto start = Details::StatisticsRecorder::Clock::now();
+        while(m_pending_count.load() == 0 && !m_is_stopping) {
+          if(m_deadlines.empty()) {
+            m_task_condition.wait(lock);
+          } else {
+            auto deadline = m_deadlines.begin()->first;
+            if(m_task_condition.wait_until(lock, deadline) ==
+                std::cv_status::timeout) {
+              break;
+            }
+          }
+        }
+        m_workers[worker]->m_statistics.record_wakeup(
+          Details::StatisticsRecorder::Clock::now() - start);
+      }
+      --m_idle_count;
+    }
+  }
+}
+
+#endif
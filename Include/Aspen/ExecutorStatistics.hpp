@@ -0,0 +1,210 @@
+#ifndef ASPEN_EXECUTOR_STATISTICS_HPP
+#define ASPEN_EXECUTOR_STATISTICS_HPP
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "Aspen/State.hpp"
+
+namespace Aspen {
+
+  /** Stores a snapshot of the work performed by an executor. */
+  struct ExecutorStatistics {
+
+    /** The number of commits, each of which commits a new sequence. */
+    std::uint64_t m_commits;
+
+    /** The number of commits that produced an evaluation. */
+    std::uint64_t m_evaluations;
+
+    /** The number of commits that requested a continuation. */
+    std::uint64_t m_continuations;
+
+    /** The number of times the executor woke up after waiting. */
+    std::uint64_t m_wakeups;
+
+    /** The number of wakeups whose following commit produced nothing. */
+    std::uint64_t m_spurious_wakeups;
+
+    /** The total time spent committing. */
+    std::chrono::nanoseconds m_commit_time;
+
+    /** The total time spent waiting for an update. */
+    std::chrono::nanoseconds m_idle_time;
+
+    /** The duration of the longest single commit. */
+    std::chrono::nanoseconds m_longest_commit;
+
+    /** The longest number of consecutive commits linked by continuations. */
+    std::uint64_t m_longest_chain;
+  };
+
+  /**
+   * Combines the statistics of two executors.
+   * @param left The statistics to accumulate into.
+   * @param right The statistics to add.
+   */
+  inline ExecutorStatistics& operator +=(ExecutorStatistics& left,
+      const ExecutorStatistics& right) noexcept {
+    left.m_commits += right.m_commits;
+    left.m_evaluations += right.m_evaluations;
+    left.m_continuations += right.m_continuations;
+    left.m_wakeups += right.m_wakeups;
+    left.m_spurious_wakeups += right.m_spurious_wakeups;
+    left.m_commit_time += right.m_commit_time;
+    left.m_idle_time += right.m_idle_time;
+    left.m_longest_commit = std::max(left.m_longest_commit,
+      right.m_longest_commit);
+    left.m_longest_chain = std::max(left.m_longest_chain,
+      right.m_longest_chain);
+    return left;
+  }
+
+namespace Details {
+
+  /**
+   * Records ExecutorStatistics from a single thread while allowing any other
+   * thread to take a snapshot without locking. Every counter has exactly one
+   * writer, so updates are relaxed loads and stores rather than atomic
+   * read-modify-write operations.
+   */
+  class StatisticsRecorder {
+    public:
+
+      /** The clock used to measure durations. */
+      using Clock = std::chrono::steady_clock;
+
+      /** Constructs a StatisticsRecorder with all counters at zero. */
+      StatisticsRecorder() noexcept;
+
+      /** Returns a snapshot of the recorded statistics. */
+      ExecutorStatistics load() const noexcept;
+
+      /**
+       * Records a commit.
+       * @param state The State returned by the commit.
+       * @param duration The time spent committing.
+       */
+      void record_commit(State state, Clock::duration duration) noexcept;
+
+      /**
+       * Records a wakeup.
+       * @param duration The time spent waiting.
+       */
+      void record_wakeup(Clock::duration duration) noexcept;
+
+      /** Ends the current continuation chain. */
+      void end_chain() noexcept;
+
+    private:
+      std::atomic<std::uint64_t> m_commits;
+      std::atomic<std::uint64_t> m_evaluations;
+      std::atomic<std::uint64_t> m_continuations;
+      std::atomic<std::uint64_t> m_wakeups;
+      std::atomic<std::uint64_t> m_spurious_wakeups;
+      std::atomic<std::int64_t> m_commit_time;
+      std::atomic<std::int64_t> m_idle_time;
+      std::atomic<std::int64_t> m_longest_commit;
+      std::atomic<std::uint64_t> m_longest_chain;
+      std::uint64_t m_chain;
+      bool m_is_woken;
+
+      static void increment(std::atomic<std::uint64_t>& counter) noexcept;
+      template<typename T>
+      static void add(std::atomic<T>& counter, T value) noexcept;
+      template<typename T>
+      static void maximize(std::atomic<T>& counter, T value) noexcept;
+  };
+
+  inline StatisticsRecorder::StatisticsRecorder() noexcept
+    : m_commits(0),
+      m_evaluations(0),
+      m_continuations(0),
+      m_wakeups(0),
+      m_spurious_wakeups(0),
+      m_commit_time(0),
+      m_idle_time(0),
+      m_longest_commit(0),
+      m_longest_chain(0),
+      m_chain(0),
+      m_is_woken(false) {}
+
+  inline ExecutorStatistics StatisticsRecorder::load() const noexcept {
+    auto statistics = ExecutorStatistics();
+    statistics.m_commits = m_commits.load(std::memory_order_relaxed);
+    statistics.m_evaluations = m_evaluations.load(std::memory_order_relaxed);
+    statistics.m_continuations =
+      m_continuations.load(std::memory_order_relaxed);
+    statistics.m_wakeups = m_wakeups.load(std::memory_order_relaxed);
+    statistics.m_spurious_wakeups =
+      m_spurious_wakeups.load(std::memory_order_relaxed);
+    statistics.m_commit_time = std::chrono::nanoseconds(
+      m_commit_time.load(std::memory_order_relaxed));
+    statistics.m_idle_time = std::chrono::nanoseconds(
+      m_idle_time.load(std::memory_order_relaxed));
+    statistics.m_longest_commit = std::chrono::nanoseconds(
+      m_longest_commit.load(std::memory_order_relaxed));
+    statistics.m_longest_chain =
+      m_longest_chain.load(std::memory_order_relaxed);
+    return statistics;
+  }
+
+  inline void StatisticsRecorder::record_commit(State state,
+      Clock::duration duration) noexcept {
+    auto nanoseconds = static_cast<std::int64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    increment(m_commits);
+    add(m_commit_time, nanoseconds);
+    maximize(m_longest_commit, nanoseconds);
+    if(has_evaluation(state)) {
+      increment(m_evaluations);
+    }
+    if(m_is_woken) {
+      m_is_woken = false;
+      if(state == State::NONE) {
+        increment(m_spurious_wakeups);
+      }
+    }
+    ++m_chain;
+    if(has_continuation(state)) {
+      increment(m_continuations);
+    } else {
+      end_chain();
+    }
+  }
+
+  inline void StatisticsRecorder::record_wakeup(
+      Clock::duration duration) noexcept {
+    increment(m_wakeups);
+    add(m_idle_time, static_cast<std::int64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    m_is_woken = true;
+  }
+
+  inline void StatisticsRecorder::end_chain() noexcept {
+    maximize(m_longest_chain, m_chain);
+    m_chain = 0;
+  }
+
+  inline void StatisticsRecorder::increment(
+      std::atomic<std::uint64_t>& counter) noexcept {
+    add(counter, std::uint64_t(1));
+  }
+
+  template<typename T>
+  void StatisticsRecorder::add(std::atomic<T>& counter, T value) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+      std::memory_order_relaxed);
+  }
+
+  template<typename T>
+  void StatisticsRecorder::maximize(std::atomic<T>& counter, T value)
+      noexcept {
+    if(value > counter.load(std::memory_order_relaxed)) {
+      counter.store(value, std::memory_order_relaxed);
+    }
+  }
+}
+}
+
+#endif
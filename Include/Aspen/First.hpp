@@ -1,10 +1,49 @@
 #ifndef ASPEN_FIRST_HPP
 #define ASPEN_FIRST_HPP
+#include <type_traits>
 #include <utility>
-#include "Aspen/Lift.hpp"
+#include "Aspen/Error.hpp"
+#include "Aspen/Maybe.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/Traits.hpp"
 
 namespace Aspen {
 
+  /**
+   * Implements a reactor that evaluates to the first value it receives from its
+   * source.
+   * @param <R> The type of the source reactor.
+   */
+  template<typename R>
+  class First {
+    public:
+      using Reactor = R;
+      using Type = reactor_result_t<Reactor>;
+      static constexpr auto is_noexcept = is_noexcept_reactor_v<Reactor>;
+
+      /**
+       * Constructs a First.
+       * @param source The source that will provide the value to evaluate to.
+       */
+      template<typename RF, typename = std::enable_if_t<
+        !std::is_base_of_v<First, std::decay_t<RF>>>>
+      explicit First(RF&& source);
+
+      State commit(int sequence) noexcept;
+
+      eval_result_t<Type> eval() const noexcept(is_noexcept);
+
+      /** Returns the error the first value evaluated to, if any. */
+      Error get_error() const noexcept;
+
+    private:
+      Reactor m_source;
+      try_maybe_t<Type, !is_noexcept> m_value;
+  };
+
+  template<typename R>
+  First(R&&) -> First<to_reactor_t<R>>;
+
   /**
    * Implements a reactor that evaluates to the first value it receives from its
    * source.
@@ -12,11 +51,37 @@ namespace Aspen {
    */
   template<typename Reactor>
   auto first(Reactor&& source) {
-    return Lift(
-      [] (auto&& value) {
-        return FunctionEvaluation(std::forward<decltype(value)>(value),
-          State::COMPLETE_EVALUATED);
-      }, std::forward<Reactor>(source));
+    return First(std::forward<Reactor>(source));
+  }
+
+  template<typename R>
+  template<typename RF, typename>
+  First<R>::First(RF&& source)
+    : m_source(std::forward<RF>(source)) {}
+
+  template<typename R>
+  State First<R>::commit(int sequence) noexcept {
+    auto state = m_source.commit(sequence);
+    if(has_evaluation(state)) {
+      m_value = try_eval(m_source);
+      return State::COMPLETE_EVALUATED;
+    }
+    return state;
+  }
+
+  template<typename R>
+  eval_result_t<typename First<R>::Type> First<R>::eval() const
+      noexcept(is_noexcept) {
+    return *m_value;
+  }
+
+  template<typename R>
+  Error First<R>::get_error() const noexcept {
+    if constexpr(is_noexcept) {
+      return Error();
+    } else {
+      return m_value.get_exception();
+    }
   }
 }
 
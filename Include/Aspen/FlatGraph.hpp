@@ -0,0 +1,612 @@
+#ifndef ASPEN_FLAT_GRAPH_HPP
+#define ASPEN_FLAT_GRAPH_HPP
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Aspen/Error.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/Maybe.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/Traits.hpp"
+
+namespace Aspen {
+  class FlatGraphBuilder;
+  template<typename T> class FlatNode;
+
+namespace Details {
+
+  /** Stores the per-sequence bookkeeping common to every flattened node. */
+  struct FlatHeader {
+
+    /** The State returned by the node's commit in the current sequence. */
+    State m_state;
+
+    /** Whether the node has ever evaluated. */
+    bool m_has_evaluation;
+
+    /** Whether the node has completed. */
+    bool m_is_complete;
+
+    /** Whether the node must be committed in the current sequence. */
+    bool m_is_dirty;
+
+    FlatHeader() noexcept;
+  };
+
+  /**
+   * Stores a flattened node's most recent evaluation.
+   * @param <T> The type the node evaluates to.
+   */
+  template<typename T>
+  struct FlatValue : FlatHeader {
+    Maybe<T> m_value;
+  };
+
+  /**
+   * Presents a flattened node's evaluation to a function the way a Lift
+   * presents a child reactor's evaluation.
+   * @param <T> The type the node evaluates to.
+   */
+  template<typename T>
+  struct FlatArgument {
+    using Type = T;
+    const FlatValue<T>* m_node;
+
+    decltype(auto) eval() const;
+    Error get_error() const noexcept;
+  };
+
+  /**
+   * A flattened node that adapts an existing reactor.
+   * @param <R> The type of reactor adapted.
+   */
+  template<typename R>
+  struct FlatSource : FlatValue<reactor_result_t<R>> {
+    R m_reactor;
+
+    template<typename RF>
+    explicit FlatSource(RF&& reactor);
+
+    State commit(int sequence) noexcept;
+  };
+
+  /**
+   * A flattened node that applies a function to the values of earlier nodes.
+   * @param <F> The type of function to apply.
+   * @param <T> The type the function evaluates to.
+   * @param <A> The types of the function's arguments.
+   */
+  template<typename F, typename T, typename... A>
+  struct FlatLift : FlatValue<T> {
+    F m_function;
+    std::tuple<FlatArgument<A>...> m_arguments;
+    bool m_has_continuation;
+
+    template<typename FF>
+    FlatLift(FF&& function, const FlatValue<A>*... arguments);
+
+    State commit(int) noexcept;
+    State invoke() noexcept;
+  };
+
+  template<typename T>
+  struct is_flat_node : std::false_type {};
+
+  template<typename T>
+  struct is_flat_node<FlatNode<T>> : std::true_type {};
+
+  template<typename T>
+  constexpr auto is_flat_node_v = is_flat_node<T>::value;
+
+  /**
+   * Stores how a FlatGraph commits and destroys one of its nodes, and which
+   * nodes read from it.
+   */
+  struct FlatEntry {
+    void* m_node;
+    FlatHeader* m_header;
+    State (*m_commit)(void*, int) noexcept;
+    void (*m_destroy)(void*) noexcept;
+
+    /** Whether the node adapts a reactor and is committed every sequence. */
+    bool m_is_source;
+
+    /** The index of the node's first dependent in the graph's list. */
+    std::size_t m_first_dependent;
+
+    /** The index one past the node's last dependent in the graph's list. */
+    std::size_t m_last_dependent;
+  };
+
+  inline FlatHeader::FlatHeader() noexcept
+    : m_state(State::NONE),
+      m_has_evaluation(false),
+      m_is_complete(false),
+      m_is_dirty(true) {}
+
+  template<typename T>
+  decltype(auto) FlatArgument<T>::eval() const {
+    if constexpr(std::is_same_v<T, void>) {
+      m_node->m_value.get();
+    } else {
+      return m_node->m_value.get();
+    }
+  }
+
+  template<typename T>
+  Error FlatArgument<T>::get_error() const noexcept {
+    return m_node->m_value.get_exception();
+  }
+
+  template<typename N>
+  State commit_flat_node(void* node, int sequence) noexcept {
+    return static_cast<N*>(node)->commit(sequence);
+  }
+
+  template<typename N>
+  void destroy_flat_node(void* node) noexcept {
+    static_cast<N*>(node)->~N();
+  }
+
+  template<typename R>
+  template<typename RF>
+  FlatSource<R>::FlatSource(RF&& reactor)
+    : m_reactor(std::forward<RF>(reactor)) {}
+
+  template<typename R>
+  State FlatSource<R>::commit(int sequence) noexcept {
+    auto state = m_reactor.commit(sequence);
+    if(has_evaluation(state)) {
+      this->m_value = try_eval_maybe(m_reactor);
+    }
+    return state;
+  }
+
+  template<typename F, typename T, typename... A>
+  template<typename FF>
+  FlatLift<F, T, A...>::FlatLift(FF&& function,
+    const FlatValue<A>*... arguments)
+    : m_function(std::forward<FF>(function)),
+      m_arguments(FlatArgument<A>{arguments}...),
+      m_has_continuation(false) {}
+
+  template<typename F, typename T, typename... A>
+  State FlatLift<F, T, A...>::commit(int) noexcept {
+    auto is_ready = true;
+    auto is_aborted = false;
+    auto has_update = false;
+    auto is_exhausted = true;
+    auto is_continuing = false;
+    std::apply([&] (const auto&... arguments) {
+      ((is_ready &= arguments.m_node->m_has_evaluation,
+        is_aborted |= !arguments.m_node->m_has_evaluation &&
+          arguments.m_node->m_is_complete,
+        has_update |= has_evaluation(arguments.m_node->m_state),
+        is_exhausted &= arguments.m_node->m_is_complete,
+        is_continuing |= has_continuation(arguments.m_node->m_state)), ...);
+    }, m_arguments);
+    if(is_aborted) {
+      return State::COMPLETE;
+    }
+    if(!is_ready || (!has_update && !m_has_continuation)) {
+      if(is_exhausted) {
+        return State::COMPLETE;
+      } else if(is_continuing) {
+        return State::CONTINUE;
+      }
+      return State::NONE;
+    }
+    auto invocation = invoke();
+    m_has_continuation = has_continuation(invocation);
+    auto state = State::NONE;
+    if(has_evaluation(invocation)) {
+      state = State::EVALUATED;
+    }
+    if(is_complete(invocation)) {
+      return combine(state, State::COMPLETE);
+    } else if(m_has_continuation || is_continuing) {
+      return combine(state, State::CONTINUE);
+    } else if(is_exhausted) {
+      return combine(state, State::COMPLETE);
+    }
+    return state;
+  }
+
+  template<typename F, typename T, typename... A>
+  State FlatLift<F, T, A...>::invoke() noexcept {
+    ASPEN_TRY {
+      if constexpr(std::is_same_v<T, void>) {
+        this->m_value = Maybe<void>();
+#ifdef ASPEN_NO_EXCEPTIONS
+        return FunctionEvaluator<void>()(this->m_value, m_function,
+          m_arguments);
+#else
+        std::apply([&] (const auto&... arguments) {
+          m_function(try_eval_argument(arguments)...);
+        }, m_arguments);
+        return State::EVALUATED;
+#endif
+      } else {
+        return FunctionEvaluator<T>()(this->m_value, m_function,
+          m_arguments);
+      }
+    } ASPEN_CATCH(...) {
+      this->m_value = current_error();
+      return State::EVALUATED;
+    }
+  }
+}
+
+  /**
+   * Identifies a node added to a FlatGraphBuilder. A node may only be passed
+   * back to the builder that added it, and only until that builder builds a
+   * graph.
+   * @param <T> The type the node evaluates to.
+   */
+  template<typename T>
+  class FlatNode {
+    public:
+      using Type = T;
+
+    private:
+      friend class FlatGraphBuilder;
+      std::uint64_t m_builder;
+      std::size_t m_offset;
+
+      FlatNode(std::uint64_t builder, std::size_t offset) noexcept;
+  };
+
+  /**
+   * A reactor graph compiled into a single contiguous arena of nodes stored
+   * in topological order. Each commit is one linear sweep over the arena in
+   * which adapted reactors are always committed, while a lifted node is only
+   * committed if one of its arguments evaluated or completed, or it asked to
+   * continue. No pointers are chased between separately allocated reactors
+   * and no virtual calls are made beyond those of adapted reactors.
+   * @param <T> The type the graph's output node evaluates to.
+   */
+  template<typename T>
+  class FlatGraph {
+    public:
+      using Type = T;
+
+      FlatGraph(FlatGraph&& graph) noexcept;
+
+      ~FlatGraph();
+
+      /** Returns the number of nodes in the graph. */
+      std::size_t get_node_count() const noexcept;
+
+      /** Returns the size of the arena storing every node, in bytes. */
+      std::size_t get_arena_size() const noexcept;
+
+      State commit(int sequence) noexcept;
+
+      eval_result_t<Type> eval() const;
+
+      /** Returns the error the output node evaluates to, if any. */
+      Error get_error() const noexcept;
+
+    private:
+      friend class FlatGraphBuilder;
+      std::unique_ptr<std::max_align_t[]> m_arena;
+      std::size_t m_arena_size;
+      std::vector<Details::FlatEntry> m_nodes;
+      std::vector<Details::FlatHeader*> m_dependents;
+      const Details::FlatValue<Type>* m_output;
+
+      FlatGraph(std::unique_ptr<std::max_align_t[]> arena,
+        std::size_t arena_size, std::vector<Details::FlatEntry> nodes,
+        std::vector<Details::FlatHeader*> dependents,
+        const Details::FlatValue<Type>* output) noexcept;
+      FlatGraph(const FlatGraph&) = delete;
+      FlatGraph& operator =(const FlatGraph&) = delete;
+      FlatGraph& operator =(FlatGraph&&) = delete;
+  };
+
+  /**
+   * Builds a FlatGraph one node at a time. Nodes can only refer to nodes
+   * added before them, so the order of addition is a topological order.
+   */
+  class FlatGraphBuilder {
+    public:
+
+      /** Constructs an empty FlatGraphBuilder. */
+      FlatGraphBuilder() noexcept;
+
+      /**
+       * Adds an existing reactor to the graph as an opaque node.
+       * @param reactor The reactor to adapt.
+       * @return The node evaluating to the <i>reactor</i>'s values.
+       */
+      template<typename R>
+      FlatNode<reactor_result_t<R>> add(R&& reactor);
+
+      /**
+       * Adds a node that applies a function to earlier nodes, following the
+       * same rules as a Lift. Throws if any of the nodes was not added by this
+       * builder since it last built a graph.
+       * @param function The function to apply.
+       * @param arguments The nodes to apply the <i>function</i> to.
+       * @return The node evaluating to the <i>function</i>'s result.
+       */
+      template<typename F, typename A, typename... B>
+      auto lift(F&& function, FlatNode<A> argument, FlatNode<B>... arguments);
+
+      /**
+       * Compiles every node added into a FlatGraph, after which this builder
+       * is empty and the nodes it returned can no longer be used. Throws if
+       * the <i>output</i> was not added by this builder.
+       * @param output The node the graph evaluates to.
+       */
+      template<typename T>
+      FlatGraph<T> build(FlatNode<T> output);
+
+    private:
+      struct BaseNode {
+        std::size_t m_offset;
+        std::vector<std::size_t> m_inputs;
+
+        explicit BaseNode(std::size_t offset) noexcept;
+        virtual ~BaseNode() = default;
+        virtual Details::FlatEntry construct(std::byte* arena) = 0;
+      };
+      template<typename N, typename... A>
+      struct Node final : BaseNode {
+        std::tuple<A...> m_arguments;
+
+        template<typename... AF>
+        Node(std::size_t offset, AF&&... arguments);
+        Details::FlatEntry construct(std::byte* arena) override;
+      };
+      std::vector<std::unique_ptr<BaseNode>> m_nodes;
+      std::size_t m_size;
+      std::uint64_t m_id;
+
+      static std::uint64_t make_id() noexcept;
+      template<typename T>
+      void check(FlatNode<T> node) const;
+      template<typename N, typename... A>
+      std::size_t allocate(A&&... arguments);
+      template<typename T>
+      static const Details::FlatValue<T>* resolve(std::byte* arena,
+        FlatNode<T> node) noexcept;
+      template<typename A>
+      static decltype(auto) resolve_argument(std::byte* arena, A&& argument)
+        noexcept;
+  };
+
+  template<typename T>
+  FlatNode<T>::FlatNode(std::uint64_t builder, std::size_t offset) noexcept
+    : m_builder(builder),
+      m_offset(offset) {}
+
+  template<typename T>
+  FlatGraph<T>::FlatGraph(FlatGraph&& graph) noexcept
+    : m_arena(std::move(graph.m_arena)),
+      m_arena_size(std::exchange(graph.m_arena_size, 0)),
+      m_nodes(std::move(graph.m_nodes)),
+      m_dependents(std::move(graph.m_dependents)),
+      m_output(std::exchange(graph.m_output, nullptr)) {
+    graph.m_nodes.clear();
+  }
+
+  template<typename T>
+  FlatGraph<T>::~FlatGraph() {
+    for(auto i = m_nodes.rbegin(); i != m_nodes.rend(); ++i) {
+      i->m_destroy(i->m_node);
+    }
+  }
+
+  template<typename T>
+  std::size_t FlatGraph<T>::get_node_count() const noexcept {
+    return m_nodes.size();
+  }
+
+  template<typename T>
+  std::size_t FlatGraph<T>::get_arena_size() const noexcept {
+    return m_arena_size;
+  }
+
+  template<typename T>
+  State FlatGraph<T>::commit(int sequence) noexcept {
+    auto is_continuing = false;
+    for(auto& node : m_nodes) {
+      auto& header = *node.m_header;
+      if(header.m_is_complete) {
+        header.m_state = State::COMPLETE;
+        continue;
+      } else if(!header.m_is_dirty) {
+        header.m_state = State::NONE;
+        continue;
+      }
+      header.m_state = node.m_commit(node.m_node, sequence);
+      header.m_has_evaluation |= has_evaluation(header.m_state);
+      header.m_is_complete = is_complete(header.m_state);
+      header.m_is_dirty = node.m_is_source || has_continuation(header.m_state);
+      is_continuing |= has_continuation(header.m_state);
+      if(has_evaluation(header.m_state) || header.m_is_complete) {
+        for(auto i = node.m_first_dependent; i != node.m_last_dependent; ++i) {
+          m_dependents[i]->m_is_dirty = true;
+        }
+      }
+    }
+    auto state = m_output->m_state;
+    if(is_complete(state)) {
+      return state;
+    } else if(is_continuing) {
+      return combine(state, State::CONTINUE);
+    }
+    return state;
+  }
+
+  template<typename T>
+  eval_result_t<typename FlatGraph<T>::Type> FlatGraph<T>::eval() const {
+    if constexpr(std::is_same_v<Type, void>) {
+      m_output->m_value.get();
+    } else {
+      return m_output->m_value.get();
+    }
+  }
+
+  template<typename T>
+  Error FlatGraph<T>::get_error() const noexcept {
+    return m_output->m_value.get_exception();
+  }
+
+  template<typename T>
+  FlatGraph<T>::FlatGraph(std::unique_ptr<std::max_align_t[]> arena,
+    std::size_t arena_size, std::vector<Details::FlatEntry> nodes,
+    std::vector<Details::FlatHeader*> dependents,
+    const Details::FlatValue<Type>* output) noexcept
+    : m_arena(std::move(arena)),
+      m_arena_size(arena_size),
+      m_nodes(std::move(nodes)),
+      m_dependents(std::move(dependents)),
+      m_output(output) {}
+
+  inline FlatGraphBuilder::FlatGraphBuilder() noexcept
+    : m_size(0),
+      m_id(make_id()) {}
+
+  template<typename R>
+  FlatNode<reactor_result_t<R>> FlatGraphBuilder::add(R&& reactor) {
+    using Source = Details::FlatSource<to_reactor_t<R>>;
+    return FlatNode<reactor_result_t<R>>(m_id,
+      allocate<Source>(to_reactor_t<R>(std::forward<R>(reactor))));
+  }
+
+  template<typename F, typename A, typename... B>
+  auto FlatGraphBuilder::lift(F&& function, FlatNode<A> argument,
+      FlatNode<B>... arguments) {
+    using Type = Details::function_reactor_result_t<std::invoke_result_t<
+      std::decay_t<F>, const Maybe<A>&, const Maybe<B>&...>>;
+    using LiftNode = Details::FlatLift<std::decay_t<F>, Type, A, B...>;
+    check(argument);
+    (check(arguments), ...);
+    auto offset = allocate<LiftNode>(std::decay_t<F>(
+      std::forward<F>(function)), argument, arguments...);
+    m_nodes.back()->m_inputs = {argument.m_offset, arguments.m_offset...};
+    return FlatNode<Type>(m_id, offset);
+  }
+
+  template<typename T>
+  FlatGraph<T> FlatGraphBuilder::build(FlatNode<T> output) {
+    check(output);
+    auto capacity = (m_size + sizeof(std::max_align_t) - 1) /
+      sizeof(std::max_align_t);
+    auto arena = std::make_unique<std::max_align_t[]>(capacity);
+    auto base = reinterpret_cast<std::byte*>(arena.get());
+    auto entries = std::vector<Details::FlatEntry>();
+    entries.reserve(m_nodes.size());
+    ASPEN_TRY {
+      for(auto& node : m_nodes) {
+        entries.push_back(node->construct(base));
+      }
+    } ASPEN_CATCH(...) {
+      for(auto i = entries.rbegin(); i != entries.rend(); ++i) {
+        i->m_destroy(i->m_node);
+      }
+      ASPEN_RETHROW;
+    }
+    auto dependents = std::vector<std::vector<std::size_t>>(m_nodes.size());
+    for(auto i = std::size_t(0); i != m_nodes.size(); ++i) {
+      for(auto input : m_nodes[i]->m_inputs) {
+        auto j = std::lower_bound(m_nodes.begin(), m_nodes.begin() + i, input,
+          [] (const auto& node, auto offset) {
+            return node->m_offset < offset;
+          }) - m_nodes.begin();
+        dependents[j].push_back(i);
+      }
+    }
+    auto headers = std::vector<Details::FlatHeader*>();
+    for(auto i = std::size_t(0); i != entries.size(); ++i) {
+      entries[i].m_is_source = m_nodes[i]->m_inputs.empty();
+      entries[i].m_first_dependent = headers.size();
+      for(auto j : dependents[i]) {
+        headers.push_back(entries[j].m_header);
+      }
+      entries[i].m_last_dependent = headers.size();
+    }
+    auto graph = FlatGraph<T>(std::move(arena), m_size, std::move(entries),
+      std::move(headers), resolve(base, output));
+    m_nodes.clear();
+    m_size = 0;
+    m_id = make_id();
+    return graph;
+  }
+
+  inline std::uint64_t FlatGraphBuilder::make_id() noexcept {
+    static auto next_id = std::atomic<std::uint64_t>(0);
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  template<typename T>
+  void FlatGraphBuilder::check(FlatNode<T> node) const {
+    if(node.m_builder != m_id) {
+      ASPEN_THROW(std::runtime_error(
+        "Node was not added by this FlatGraphBuilder."));
+    }
+  }
+
+  inline FlatGraphBuilder::BaseNode::BaseNode(std::size_t offset) noexcept
+    : m_offset(offset) {}
+
+  template<typename N, typename... A>
+  template<typename... AF>
+  FlatGraphBuilder::Node<N, A...>::Node(std::size_t offset,
+    AF&&... arguments)
+    : BaseNode(offset),
+      m_arguments(std::forward<AF>(arguments)...) {}
+
+  template<typename N, typename... A>
+  Details::FlatEntry FlatGraphBuilder::Node<N, A...>::construct(
+      std::byte* arena) {
+    auto node = std::apply([&] (auto&&... arguments) {
+      return ::new(arena + this->m_offset) N(
+        resolve_argument(arena, std::move(arguments))...);
+    }, m_arguments);
+    return Details::FlatEntry{node, static_cast<Details::FlatHeader*>(node),
+      &Details::commit_flat_node<N>, &Details::destroy_flat_node<N>, true, 0,
+      0};
+  }
+
+  template<typename N, typename... A>
+  std::size_t FlatGraphBuilder::allocate(A&&... arguments) {
+    static_assert(alignof(N) <= alignof(std::max_align_t),
+      "Over-aligned reactors can not be flattened.");
+    auto offset = (m_size + alignof(N) - 1) / alignof(N) * alignof(N);
+    m_nodes.push_back(std::make_unique<Node<N, std::decay_t<A>...>>(offset,
+      std::forward<A>(arguments)...));
+    m_size = offset + sizeof(N);
+    return offset;
+  }
+
+  template<typename T>
+  const Details::FlatValue<T>* FlatGraphBuilder::resolve(std::byte* arena,
+      FlatNode<T> node) noexcept {
+    return reinterpret_cast<const Details::FlatValue<T>*>(arena +
+      node.m_offset);
+  }
+
+  template<typename A>
+  decltype(auto) FlatGraphBuilder::resolve_argument(std::byte* arena,
+      A&& argument) noexcept {
+    if constexpr(Details::is_flat_node_v<std::decay_t<A>>) {
+      return resolve(arena, argument);
+    } else {
+      return std::forward<A>(argument);
+    }
+  }
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include <memory>
 #include <optional>
 #include <utility>
+#include "Aspen/Error.hpp"
 #include "Aspen/Lift.hpp"
 #include "Aspen/Maybe.hpp"
 #include "Aspen/Shared.hpp"
@@ -27,6 +28,9 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const;
 
+      /** Returns the error this argument evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       template<typename, typename> friend class Fold;
       Maybe<Type> m_value;
@@ -63,6 +67,9 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const;
 
+      /** Returns the error this reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       E m_evaluator;
       Shared<FoldArgument<Type>> m_left;
@@ -132,6 +139,11 @@ namespace Aspen {
     return m_value;
   }
 
+  template<typename T>
+  Error FoldArgument<T>::get_error() const noexcept {
+    return m_value.get_exception();
+  }
+
   template<typename T>
   void FoldArgument<T>::update(Maybe<Type> value) {
     m_next_value.emplace(std::move(value));
@@ -153,15 +165,15 @@ namespace Aspen {
     if(has_evaluation(series_state)) {
       if(!m_previous_value.has_value()) {
         if(!is_complete(series_state)) {
-          m_previous_value = try_call([&] { return m_series.eval(); });
+          m_previous_value = try_eval_maybe(m_series);
         }
       } else {
         m_left->update(std::move(*m_previous_value));
-        m_right->update(try_call([&] { return m_series.eval(); }));
+        m_right->update(try_eval_maybe(m_series));
         state = m_evaluator.commit(sequence);
         if(has_evaluation(state)) {
-          m_value = try_call([&] { return m_evaluator.eval(); });
-          m_previous_value = m_value;
+          m_value = try_eval_maybe(m_evaluator);
+          m_previous_value.emplace(m_value);
         }
       }
     }
@@ -177,6 +189,11 @@ namespace Aspen {
   eval_result_t<typename Fold<E, S>::Type> Fold<E, S>::eval() const {
     return m_value;
   }
+
+  template<typename E, typename S>
+  Error Fold<E, S>::get_error() const noexcept {
+    return m_value.get_exception();
+  }
 }
 
 #endif
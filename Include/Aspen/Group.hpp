@@ -2,6 +2,7 @@
 #define ASPEN_GROUP_HPP
 #include <cstdint>
 #include <utility>
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -31,6 +32,9 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const noexcept(is_noexcept);
 
+      /** Returns the error the current reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       A m_first;
       B m_second;
@@ -131,6 +135,15 @@ namespace Aspen {
     }
   }
 
+  template<typename A, typename B>
+  Error Group<A, B>::get_error() const noexcept {
+    if(m_current == 0) {
+      return eval_error(m_first);
+    } else {
+      return eval_error(m_second);
+    }
+  }
+
   template<typename A, typename B>
   std::uint8_t Group<A, B>::next_position() const {
     return (m_position + 1) % 2;
@@ -1,13 +1,51 @@
 #ifndef ASPEN_LAST_HPP
 #define ASPEN_LAST_HPP
+#include <type_traits>
 #include <utility>
-#include "Aspen/Lift.hpp"
-#include "Aspen/Shared.hpp"
-#include "Aspen/StateReactor.hpp"
+#include "Aspen/Error.hpp"
+#include "Aspen/Maybe.hpp"
+#include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
 namespace Aspen {
 
+  /**
+   * Implements a reactor that evaluates to the last value it receives from its
+   * source once the source completes. Only the final value is read, so
+   * intermediate values are never copied.
+   * @param <R> The type of the source reactor.
+   */
+  template<typename R>
+  class Last {
+    public:
+      using Reactor = R;
+      using Type = reactor_result_t<Reactor>;
+      static constexpr auto is_noexcept = is_noexcept_reactor_v<Reactor>;
+
+      /**
+       * Constructs a Last.
+       * @param source The source that will provide the value to evaluate to.
+       */
+      template<typename RF, typename = std::enable_if_t<
+        !std::is_base_of_v<Last, std::decay_t<RF>>>>
+      explicit Last(RF&& source);
+
+      State commit(int sequence) noexcept;
+
+      eval_result_t<Type> eval() const noexcept(is_noexcept);
+
+      /** Returns the error the last value evaluated to, if any. */
+      Error get_error() const noexcept;
+
+    private:
+      Reactor m_source;
+      try_maybe_t<Type, !is_noexcept> m_value;
+      bool m_has_evaluation;
+  };
+
+  template<typename R>
+  Last(R&&) -> Last<to_reactor_t<R>>;
+
   /**
    * Implements a reactor that evaluates to the last value it receives from its
    * source.
@@ -15,16 +53,44 @@ namespace Aspen {
    */
   template<typename Reactor>
   auto last(Reactor&& source) {
-    using Type = reactor_result_t<Reactor>;
-    auto source_reactor = Shared(std::forward<Reactor>(source));
-    return Lift(
-      [] (auto&& value, State state) noexcept -> FunctionEvaluation<Type> {
-        if(is_complete(state)) {
-          return FunctionEvaluation<Type>(std::forward<decltype(value)>(value),
-            State::COMPLETE_EVALUATED);
-        }
-        return State::NONE;
-      }, source_reactor, StateReactor(source_reactor));
+    return Last(std::forward<Reactor>(source));
+  }
+
+  template<typename R>
+  template<typename RF, typename>
+  Last<R>::Last(RF&& source)
+    : m_source(std::forward<RF>(source)),
+      m_has_evaluation(false) {}
+
+  template<typename R>
+  State Last<R>::commit(int sequence) noexcept {
+    auto state = m_source.commit(sequence);
+    m_has_evaluation |= has_evaluation(state);
+    if(is_complete(state)) {
+      if(m_has_evaluation) {
+        m_value = try_eval(m_source);
+        return State::COMPLETE_EVALUATED;
+      }
+      return State::COMPLETE;
+    } else if(has_continuation(state)) {
+      return State::CONTINUE;
+    }
+    return State::NONE;
+  }
+
+  template<typename R>
+  eval_result_t<typename Last<R>::Type> Last<R>::eval() const
+      noexcept(is_noexcept) {
+    return *m_value;
+  }
+
+  template<typename R>
+  Error Last<R>::get_error() const noexcept {
+    if constexpr(is_noexcept) {
+      return Error();
+    } else {
+      return m_value.get_exception();
+    }
   }
 }
 
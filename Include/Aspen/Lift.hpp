@@ -1,16 +1,22 @@
 #ifndef ASPEN_LIFT_HPP
 #define ASPEN_LIFT_HPP
+#include <bitset>
 #include <cassert>
 #include <optional>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <variant>
+#include <vector>
+#include "Aspen/Batch.hpp"
+#include "Aspen/Error.hpp"
 #include "Aspen/Maybe.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/StaticCommitHandler.hpp"
 #include "Aspen/Traits.hpp"
 
 namespace Aspen {
+  template<typename F, typename... A> class ParallelLift;
 
   /**
    * Stores the result of a function evaluation within a reactor.
@@ -108,6 +114,9 @@ namespace Aspen {
   };
 
 namespace Details {
+  template<typename T>
+  struct ExpressionOperand;
+
   template<typename T>
   struct function_reactor_result {
     using type = std::decay_t<T>;
@@ -126,16 +135,123 @@ namespace Details {
   template<typename T>
   using function_reactor_result_t = typename function_reactor_result<T>::type;
 
+  /**
+   * Evaluates an argument passed to a Lift's function. Without exceptions,
+   * errors are read through the argument's get_error method instead.
+   * @param argument The argument to evaluate.
+   */
+  template<typename R>
+  decltype(auto) try_eval_argument(const R& argument) noexcept {
+#ifdef ASPEN_NO_EXCEPTIONS
+    if constexpr(!is_noexcept_reactor_v<R> && has_error_v<R>) {
+      return try_eval(argument);
+    } else {
+      return try_call([&] () noexcept(noexcept(argument.eval())) {
+        return argument.eval();
+      });
+    }
+#else
+    return try_call([&] () noexcept(noexcept(argument.eval())) {
+      return argument.eval();
+    });
+#endif
+  }
+
+  template<typename T>
+  struct is_maybe : std::false_type {};
+
+  template<typename T>
+  struct is_maybe<Maybe<T>> : std::true_type {};
+
+  /** Lists the parameters of a function whose signature can be determined. */
+  template<typename F, typename=void>
+  struct function_parameters {};
+
+  template<typename F>
+  struct function_parameters<F, std::void_t<decltype(&F::operator ())>> :
+    function_parameters<decltype(&F::operator ())> {};
+
+  template<typename R, typename... P>
+  struct function_parameters<R (*)(P...)> {
+    using type = std::tuple<P...>;
+  };
+
+  template<typename R, typename... P>
+  struct function_parameters<R (*)(P...) noexcept> {
+    using type = std::tuple<P...>;
+  };
+
+  template<typename R, typename C, typename... P>
+  struct function_parameters<R (C::*)(P...)> {
+    using type = std::tuple<P...>;
+  };
+
+  template<typename R, typename C, typename... P>
+  struct function_parameters<R (C::*)(P...) noexcept> {
+    using type = std::tuple<P...>;
+  };
+
+  template<typename R, typename C, typename... P>
+  struct function_parameters<R (C::*)(P...) const> {
+    using type = std::tuple<P...>;
+  };
+
+  template<typename R, typename C, typename... P>
+  struct function_parameters<R (C::*)(P...) const noexcept> {
+    using type = std::tuple<P...>;
+  };
+
+  /**
+   * Tests if a function's parameter is a Maybe, allowing it to receive
+   * errors. Functions with overloaded or templated call operators are
+   * assumed not to receive errors.
+   */
+  template<typename F, std::size_t I, typename=void>
+  struct is_error_parameter : std::false_type {};
+
+  template<typename F, std::size_t I>
+  struct is_error_parameter<F, I,
+    std::void_t<typename function_parameters<F>::type>> :
+    is_maybe<std::decay_t<std::tuple_element_t<I,
+      typename function_parameters<F>::type>>> {};
+
+  /**
+   * Returns the first error among a function's arguments that the function
+   * can't receive.
+   * @param arguments The arguments to the function.
+   */
+  template<typename F, typename... A>
+  Error find_error(const std::tuple<A...>& arguments) noexcept {
+    auto error = Error();
+    for_each<0, sizeof...(A)>([&] (auto index) {
+      constexpr auto I = decltype(index)::value;
+      if constexpr(is_maybe<std::tuple_element_t<I, std::tuple<A...>>>::value
+          && !is_error_parameter<F, I>::value) {
+        if(!error) {
+          error = std::get<I>(arguments).get_exception();
+        }
+      }
+    });
+    return error;
+  }
+
   template<typename T>
   struct FunctionEvaluator {
     template<typename V, typename F, typename P>
     State operator ()(V& value, F& function, const P& pack) const {
       auto evaluation = apply(
         [&] (const auto&... arguments) {
+#ifdef ASPEN_NO_EXCEPTIONS
+          auto values = std::tuple<decltype(try_eval_argument(arguments))...>(
+            try_eval_argument(arguments)...);
+          if(auto error = find_error<F>(values)) {
+            return FunctionEvaluation<T>(Maybe<T>(std::move(error)));
+          }
+          return FunctionEvaluation<T>(std::apply(function, std::move(values)));
+#else
           return FunctionEvaluation<T>(function(
-            try_call([&] () noexcept(noexcept(arguments.eval())) {
-              return arguments.eval();
-            })...));
+            try_eval_argument(arguments)...));
+#endif
         }, pack);
       if(evaluation.m_value.has_value()) {
         if constexpr(std::is_same_v<V, LocalPtr<T>>) {
@@ -154,17 +270,77 @@ namespace Details {
     State operator ()(V& value, F& function, const P& pack) const {
       apply(
         [&] (const auto&... arguments) {
+#ifdef ASPEN_NO_EXCEPTIONS
+          auto values = std::tuple<decltype(try_eval_argument(arguments))...>(
+            try_eval_argument(arguments)...);
+          if(auto error = find_error<F>(values)) {
+            value = Maybe<void>(std::move(error));
+            return;
+          }
+          std::apply(function, std::move(values));
+#else
+          static_cast<void>(value);
           return FunctionEvaluation<void>(try_call([&] {
-            return function(
-              try_call([&] () noexcept(noexcept(arguments.eval())) {
-                return arguments.eval();
-              })...);
+            return function(try_eval_argument(arguments)...);
           }));
+#endif
         }, pack);
       return State::EVALUATED;
     }
   };
 
+  /**
+   * Wraps a function so that it's passed a mask of the arguments that
+   * evaluated since its last invocation as its first parameter.
+   * @param <F> The function to wrap.
+   * @param <N> The number of arguments.
+   */
+  template<typename F, std::size_t N>
+  struct MaskedFunction {
+    F m_function;
+    std::bitset<N> m_mask;
+    bool m_is_initialized;
+
+    template<typename FF>
+    explicit MaskedFunction(FF&& function);
+
+    void update(const std::bitset<N>& evaluations) noexcept;
+
+    template<typename... A>
+    decltype(auto) operator ()(A&&... arguments) noexcept(noexcept(
+        std::declval<F&>()(std::declval<const std::bitset<N>&>(),
+        std::forward<A>(arguments)...))) {
+      return m_function(std::as_const(m_mask),
+        std::forward<A>(arguments)...);
+    }
+  };
+
+  template<typename T>
+  struct is_masked_function : std::false_type {};
+
+  template<typename F, std::size_t N>
+  struct is_masked_function<MaskedFunction<F, N>> : std::true_type {};
+
+  template<typename T>
+  constexpr auto is_masked_function_v = is_masked_function<T>::value;
+
+  template<typename F, std::size_t N>
+  template<typename FF>
+  MaskedFunction<F, N>::MaskedFunction(FF&& function)
+    : m_function(std::forward<FF>(function)),
+      m_is_initialized(false) {}
+
+  template<typename F, std::size_t N>
+  void MaskedFunction<F, N>::update(const std::bitset<N>& evaluations)
+      noexcept {
+    if(m_is_initialized) {
+      m_mask = evaluations;
+    } else {
+      m_mask.set();
+      m_is_initialized = true;
+    }
+  }
+
   template<typename T>
   struct unwrap_local_ptr {
     using type = T;
@@ -186,6 +362,33 @@ namespace Details {
 
   template<typename F, typename... A>
   constexpr auto is_lift_noexcept_v = is_lift_noexcept<F, A...>::value;
+
+  template<typename... A>
+  struct is_unary_batch : std::false_type {};
+
+  template<typename A>
+  struct is_unary_batch<A> : is_batch_reactor<A> {};
+
+  template<typename... A>
+  constexpr auto is_unary_batch_v = is_unary_batch<A...>::value;
+
+  template<typename R>
+  struct BatchElement {
+    using Type = reactor_result_t<R>;
+    const Maybe<Type>* m_value;
+
+    decltype(auto) eval() const noexcept(is_noexcept_reactor_v<R>) {
+      if constexpr(std::is_same_v<Type, void>) {
+        m_value->get();
+      } else {
+        return m_value->get();
+      }
+    }
+
+    Error get_error() const noexcept {
+      return m_value->get_exception();
+    }
+  };
 }
 
   /**
@@ -217,13 +420,38 @@ namespace Details {
 
       eval_result_t<Type> eval() const noexcept(is_noexcept);
 
+      /** Returns the error this reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
+      /**
+       * Commits this reactor, applying the function to every value in the
+       * batch of its argument. Only available if this reactor has a single
+       * batch-aware argument.
+       * @param sequence The commit's sequence.
+       */
+      template<bool B = Details::is_unary_batch_v<A...>,
+        typename = std::enable_if_t<B>>
+      State commit_batch(int sequence) noexcept;
+
+      /** Returns the values evaluated by the last call to commit_batch. */
+      template<bool B = Details::is_unary_batch_v<A...>,
+        typename = std::enable_if_t<B>>
+      Batch<Type> eval_batch() const;
+
     private:
+      template<typename> friend struct Details::ExpressionOperand;
+      template<typename, typename...> friend class ParallelLift;
       Function m_function;
       StaticCommitHandler<A...> m_handler;
       try_maybe_t<Type, std::is_same_v<Type, void> || !is_noexcept> m_value;
       bool m_has_continuation;
+      std::conditional_t<Details::is_unary_batch_v<A...>,
+        std::vector<Maybe<Type>>, std::monostate> m_batch;
 
       State invoke();
+      template<typename P>
+      State invoke(const P& pack);
+      void append_batch();
   };
 
   /**
@@ -249,6 +477,9 @@ namespace Details {
 
       eval_result_t<Type> eval() const;
 
+      /** Returns the error this reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       Function m_function;
       try_maybe_t<Type, std::is_same_v<Type, void> || !is_noexcept> m_value;
@@ -274,6 +505,20 @@ namespace Details {
     return Lift(std::forward<F>(function), std::forward<A>(arguments)...);
   }
 
+  /**
+   * Lifts a function to operate on reactors, passing it a
+   * <code>std::bitset</code> of the arguments that evaluated since its last
+   * invocation as its first parameter. Every bit is set on the first
+   * invocation.
+   * @param function The function to lift.
+   * @param arguments The reactors used as arguments to the function.
+   */
+  template<typename F, typename... A>
+  auto masked_lift(F&& function, A&&... arguments) {
+    return Lift(Details::MaskedFunction<std::decay_t<F>, sizeof...(A)>(
+      std::forward<F>(function)), std::forward<A>(arguments)...);
+  }
+
   template<typename T>
   FunctionEvaluation<T>::FunctionEvaluation()
     : m_state(State::NONE) {}
@@ -410,6 +655,9 @@ namespace Details {
     auto children_state = m_handler.commit(sequence);
     if(has_evaluation(children_state) || m_has_continuation) {
       m_has_continuation = false;
+      if constexpr(Details::is_masked_function_v<F>) {
+        m_function.update(m_handler.get_evaluations());
+      }
       auto invocation = invoke();
       if(invocation == State::NONE) {
         if(is_complete(children_state)) {
@@ -444,25 +692,101 @@ namespace Details {
     return *m_value;
   }
 
+  template<typename F, typename... A>
+  Error Lift<F, A...>::get_error() const noexcept {
+    if constexpr(std::is_same_v<decltype(m_value), Maybe<Type>>) {
+      return m_value.get_exception();
+    } else {
+      return Error();
+    }
+  }
+
+  template<typename F, typename... A>
+  template<bool B, typename>
+  State Lift<F, A...>::commit_batch(int sequence) noexcept {
+    m_batch.clear();
+    auto children_state = m_handler.commit_batch(sequence);
+    auto is_function_complete = false;
+    auto consume = [&] (State invocation) {
+      if(has_evaluation(invocation)) {
+        append_batch();
+      }
+      m_has_continuation = m_has_continuation ||
+        has_continuation(invocation);
+      is_function_complete = is_complete(invocation);
+    };
+    if constexpr(Details::is_masked_function_v<F>) {
+      m_function.update(m_handler.get_evaluations());
+    }
+    if(has_evaluation(children_state)) {
+      m_has_continuation = false;
+      using Element = Details::BatchElement<A...>;
+      for(auto& value : m_handler.template get<0>().eval_batch()) {
+        consume(invoke(std::tuple<Element>(Element{&value})));
+        if(is_function_complete) {
+          break;
+        }
+      }
+    } else if(m_has_continuation) {
+      m_has_continuation = false;
+      consume(invoke());
+    } else {
+      return children_state;
+    }
+    auto state = State::NONE;
+    if(!m_batch.empty()) {
+      state = State::EVALUATED;
+    }
+    if(is_function_complete) {
+      return combine(state, State::COMPLETE);
+    } else if(m_has_continuation || has_continuation(children_state)) {
+      return combine(state, State::CONTINUE);
+    } else if(is_complete(children_state)) {
+      return combine(state, State::COMPLETE);
+    }
+    return state;
+  }
+
+  template<typename F, typename... A>
+  template<bool B, typename>
+  Batch<typename Lift<F, A...>::Type> Lift<F, A...>::eval_batch() const {
+    return Batch<Type>(m_batch.data(), m_batch.size());
+  }
+
   template<typename F, typename... A>
   State Lift<F, A...>::invoke() {
-    try {
-      return Details::FunctionEvaluator<Type>()(m_value, m_function, m_handler);
-    } catch(...) {
+    return invoke(m_handler);
+  }
+
+  template<typename F, typename... A>
+  template<typename P>
+  State Lift<F, A...>::invoke(const P& pack) {
+    ASPEN_TRY {
+      return Details::FunctionEvaluator<Type>()(m_value, m_function, pack);
+    } ASPEN_CATCH(...) {
       if constexpr(!is_noexcept) {
-        m_value = std::current_exception();
+        m_value = current_error();
       }
       return State::EVALUATED;
     }
   }
 
+  template<typename F, typename... A>
+  void Lift<F, A...>::append_batch() {
+    if constexpr(std::is_same_v<decltype(m_value), Maybe<Type>>) {
+      m_batch.push_back(m_value);
+    } else {
+      m_batch.emplace_back(*m_value);
+    }
+  }
+
   template<typename F>
   template<typename FF, typename>
   Lift<F>::Lift(FF&& function)
     : m_function(std::forward<FF>(function)) {}
 
   template<typename F>
-  State Lift<F>::commit(int sequence) noexcept {
+  State Lift<F>::commit(int) noexcept {
     auto invocation = invoke();
     if(has_evaluation(invocation)) {
       if(has_continuation(invocation)) {
@@ -481,14 +805,23 @@ namespace Details {
     return *m_value;
   }
 
+  template<typename F>
+  Error Lift<F>::get_error() const noexcept {
+    if constexpr(std::is_same_v<decltype(m_value), Maybe<Type>>) {
+      return m_value.get_exception();
+    } else {
+      return Error();
+    }
+  }
+
   template<typename F>
   State Lift<F>::invoke() {
-    try {
+    ASPEN_TRY {
       return Details::FunctionEvaluator<Type>()(m_value, m_function,
         std::tuple<>());
-    } catch(...) {
+    } ASPEN_CATCH(...) {
       if constexpr(!is_noexcept) {
-        m_value = std::current_exception();
+        m_value = current_error();
       }
       return State::EVALUATED;
     }
@@ -5,6 +5,7 @@
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include "Aspen/Error.hpp"
 #include "Aspen/LocalPtr.hpp"
 
 namespace Aspen {
@@ -39,7 +40,7 @@ namespace Aspen {
        * Constructs a Maybe initialized to an exception.
        * @param exception The exception to throw.
        */
-      Maybe(std::exception_ptr exception) noexcept;
+      Maybe(Error exception) noexcept;
 
       /**
        * Converts a Maybe of one type to this Maybe.
@@ -76,7 +77,7 @@ namespace Aspen {
       Type& get();
 
       /** Returns the exception. */
-      std::exception_ptr get_exception() const noexcept;
+      Error get_exception() const noexcept;
 
       //! Returns a reference to the value.
       const Type& operator *() const;
@@ -108,7 +109,7 @@ namespace Aspen {
 
     private:
       template<typename> friend class Maybe;
-      std::variant<std::exception_ptr, Type> m_value;
+      std::variant<Error, Type> m_value;
   };
 
   template<>
@@ -118,7 +119,7 @@ namespace Aspen {
 
       Maybe() = default;
 
-      Maybe(std::exception_ptr exception) noexcept;
+      Maybe(Error exception) noexcept;
 
       template<typename U>
       Maybe(const Maybe<U>& maybe) noexcept;
@@ -127,7 +128,7 @@ namespace Aspen {
 
       void get() const;
 
-      std::exception_ptr get_exception() const noexcept;
+      Error get_exception() const noexcept;
 
       void operator *() const;
 
@@ -137,7 +138,7 @@ namespace Aspen {
       Maybe& operator =(const Maybe<U>& rhs) noexcept;
 
     private:
-      std::exception_ptr m_exception;
+      Error m_exception;
   };
 
   /**
@@ -170,15 +171,15 @@ namespace Aspen {
         return f();
       }
     } else {
-      try {
+      ASPEN_TRY {
         if constexpr(std::is_same_v<Type, void>) {
           f();
           return Maybe<Type>();
         } else {
           return Maybe<Type>(f());
         }
-      } catch(...) {
-        return Maybe<Type>(std::current_exception());
+      } ASPEN_CATCH(...) {
+        return Maybe<Type>(current_error());
       }
     }
   }
@@ -194,14 +195,14 @@ namespace Aspen {
     : m_value(std::move(value)) {}
 
   template<typename T>
-  Maybe<T>::Maybe(std::exception_ptr exception) noexcept
+  Maybe<T>::Maybe(Error exception) noexcept
     : m_value(std::move(exception)) {}
 
   template<typename T>
   template<typename U>
   Maybe<T>::Maybe(const Maybe<U>& maybe) noexcept(
     std::is_nothrow_constructible_v<Type, const U&>)
-    : m_value([&] () -> std::variant<std::exception_ptr, Type> {
+    : m_value([&] () -> std::variant<Error, Type> {
         if(maybe.has_value()) {
           return static_cast<Type>(static_cast<const U&>(maybe));
         } else {
@@ -213,7 +214,7 @@ namespace Aspen {
   template<typename U>
   Maybe<T>::Maybe(Maybe<U>&& maybe) noexcept(
     std::is_nothrow_constructible_v<Type, U&&>)
-    : m_value([&] () -> std::variant<std::exception_ptr, Type> {
+    : m_value([&] () -> std::variant<Error, Type> {
         if(maybe.has_value()) {
           return std::move(static_cast<U&>(maybe));
         } else {
@@ -246,11 +247,11 @@ namespace Aspen {
     if(has_value()) {
       return std::get<Type>(m_value);
     }
-    auto& e = std::get<std::exception_ptr>(m_value);
-    if(e != nullptr) {
-      std::rethrow_exception(e);
+    auto& e = std::get<Error>(m_value);
+    if(e) {
+      raise(e);
     }
-    throw std::runtime_error("Uninitialized.");
+    ASPEN_THROW(std::runtime_error("Uninitialized."));
   }
 
   template<typename T>
@@ -258,17 +259,17 @@ namespace Aspen {
     if(has_value()) {
       return std::get<Type>(m_value);
     }
-    auto& e = std::get<std::exception_ptr>(m_value);
-    if(e != nullptr) {
-      std::rethrow_exception(e);
+    auto& e = std::get<Error>(m_value);
+    if(e) {
+      raise(e);
     }
-    throw std::runtime_error("Uninitialized.");
+    ASPEN_THROW(std::runtime_error("Uninitialized."));
   }
 
   template<typename T>
-  std::exception_ptr Maybe<T>::get_exception() const noexcept {
+  Error Maybe<T>::get_exception() const noexcept {
     if(has_exception()) {
-      return std::get<std::exception_ptr>(m_value);
+      return std::get<Error>(m_value);
     }
     return {};
   }
@@ -325,7 +326,7 @@ namespace Aspen {
     return *this;
   }
 
-  inline Maybe<void>::Maybe(std::exception_ptr exception) noexcept
+  inline Maybe<void>::Maybe(Error exception) noexcept
     : m_exception(std::move(exception)) {}
 
   template<typename U>
@@ -336,16 +337,16 @@ namespace Aspen {
   }
 
   inline bool Maybe<void>::has_exception() const noexcept {
-    return m_exception != nullptr;
+    return static_cast<bool>(m_exception);
   }
 
   inline void Maybe<void>::get() const {
-    if(m_exception != nullptr) {
-      std::rethrow_exception(m_exception);
+    if(m_exception) {
+      raise(m_exception);
     }
   }
 
-  inline std::exception_ptr Maybe<void>::get_exception() const noexcept {
+  inline Error Maybe<void>::get_exception() const noexcept {
     return m_exception;
   }
 
@@ -362,7 +363,7 @@ namespace Aspen {
     if(rhs.has_exception()) {
       m_exception = rhs.get_exception();
     } else {
-      m_exception = nullptr;
+      m_exception = Error();
     }
     return *this;
   }
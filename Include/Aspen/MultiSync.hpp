@@ -1,5 +1,6 @@
 #ifndef ASPEN_MULTI_SYNC_HPP
 #define ASPEN_MULTI_SYNC_HPP
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/StaticCommitHandler.hpp"
 #include "Aspen/Sync.hpp"
@@ -37,6 +38,9 @@ namespace Details {
 
       const Type& eval() const noexcept(is_noexcept);
 
+      /** Returns the error a reactor last evaluated to, if any. */
+      Error get_error() const noexcept;
+
     private:
       Type* m_value;
       StaticCommitHandler<R...> m_reactors;
@@ -52,13 +56,21 @@ namespace Details {
     auto state = m_reactors.commit(sequence);
     if constexpr(!is_noexcept) {
       if(has_evaluation(state)) {
-        try {
-          apply([] (const auto&... reactors) {
-            (reactors.eval(), ...);
-          }, m_reactors);
-          this->m_exception = nullptr;
-        } catch(...) {
-          this->m_exception = std::current_exception();
+        auto error = Error();
+        apply([&] (const auto&... reactors) {
+          ((error = error ? error : eval_error(reactors)), ...);
+        }, m_reactors);
+        if(error) {
+          this->m_exception = std::move(error);
+        } else {
+          ASPEN_TRY {
+            apply([] (const auto&... reactors) {
+              (reactors.eval(), ...);
+            }, m_reactors);
+            this->m_exception = Error();
+          } ASPEN_CATCH(...) {
+            this->m_exception = current_error();
+          }
         }
       }
     }
@@ -70,11 +82,20 @@ namespace Details {
       noexcept(is_noexcept) {
     if constexpr(!is_noexcept) {
       if(this->m_exception) {
-        std::rethrow_exception(this->m_exception);
+        raise(this->m_exception);
       }
     }
     return *m_value;
   }
+
+  template<typename V, typename... R>
+  Error MultiSync<V, R...>::get_error() const noexcept {
+    if constexpr(is_noexcept) {
+      return Error();
+    } else {
+      return this->m_exception;
+    }
+  }
 }
 
 #endif
@@ -0,0 +1,288 @@
+#ifndef ASPEN_MULTIPLEX_EXECUTOR_HPP
+#define ASPEN_MULTIPLEX_EXECUTOR_HPP
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Aspen/Box.hpp"
+#include "Aspen/ExecutorStatistics.hpp"
+#include "Aspen/TimerWheel.hpp"
+#include "Aspen/Trigger.hpp"
+
+namespace Aspen {
+
+  /**
+   * Runs any number of top-level reactors on a single thread, committing only
+   * those reactors that have signalled an update. Timers committed by the
+   * reactors are scheduled on a TimerWheel owned by the executor.
+   */
+  class MultiplexExecutor {
+    public:
+
+      /** Identifies a reactor added to a MultiplexExecutor. */
+      using Id = int;
+
+      /** Constructs an empty MultiplexExecutor. */
+      MultiplexExecutor();
+
+      /**
+       * Adds a reactor to execute, this may be called from any thread.
+       * @param reactor The reactor to execute.
+       * @return The id used to identify the reactor.
+       */
+      template<typename R>
+      Id add(R&& reactor);
+
+      /**
+       * Removes a reactor, this may be called from any thread. The reactor is
+       * destroyed on the thread running this executor, the Trigger it was
+       * committed with remains valid for as long as this executor exists and
+       * is reused by subsequently added reactors.
+       * @param id The id of the reactor to remove.
+       */
+      void remove(Id id);
+
+      /** Returns the number of reactors that have not completed. */
+      std::size_t get_size() const;
+
+      /** Repeatedly commits ready reactors until none are ready. */
+      void run_until_none();
+
+      /**
+       * Repeatedly commits ready reactors until every reactor completes or
+       * this executor is closed.
+       */
+      void run_until_complete();
+
+      /** Causes run_until_complete to return. */
+      void close();
+
+      /**
+       * Returns a snapshot of the work this executor has performed, may be
+       * called from any thread. Ready reactors are committed in turn, so a
+       * continuation chain always spans a single commit.
+       */
+      ExecutorStatistics get_statistics() const noexcept;
+
+    private:
+      struct Slot {
+        std::atomic<Id> m_id;
+        Trigger m_trigger;
+
+        explicit Slot(MultiplexExecutor& executor);
+      };
+      struct Entry {
+        Id m_id;
+        Box<void> m_reactor;
+        Slot* m_slot;
+        int m_sequence;
+        bool m_is_ready;
+        bool m_is_removed;
+
+        template<typename R>
+        Entry(Id id, Slot& slot, R&& reactor);
+      };
+      mutable std::mutex m_mutex;
+      std::condition_variable m_update_condition;
+      TimerWheel m_timers;
+      std::deque<Slot> m_slots;
+      std::vector<Slot*> m_free_slots;
+      std::unordered_map<Id, std::unique_ptr<Entry>> m_entries;
+      std::vector<Id> m_ready;
+      std::vector<Id> m_removals;
+      std::vector<Id> m_batch;
+      std::vector<Entry*> m_active;
+      Id m_next_id;
+      bool m_is_closed;
+      Details::StatisticsRecorder m_statistics;
+
+      MultiplexExecutor(const MultiplexExecutor&) = delete;
+      MultiplexExecutor& operator =(const MultiplexExecutor&) = delete;
+      void on_update(Id id);
+      bool run_ready();
+  };
+
+  inline MultiplexExecutor::MultiplexExecutor()
+    : m_next_id(0),
+      m_is_closed(false) {}
+
+  template<typename R>
+  MultiplexExecutor::Id MultiplexExecutor::add(R&& reactor) {
+    auto id = [&] {
+      auto lock = std::lock_guard(m_mutex);
+      auto id = m_next_id;
+      auto slot = [&] {
+        if(m_free_slots.empty()) {
+          return &m_slots.emplace_back(*this);
+        }
+        auto slot = m_free_slots.back();
+        m_free_slots.pop_back();
+        return slot;
+      }();
+      m_entries.emplace(id,
+        std::make_unique<Entry>(id, *slot, std::forward<R>(reactor)));
+      slot->m_id.store(id);
+      ++m_next_id;
+      return id;
+    }();
+    on_update(id);
+    return id;
+  }
+
+  inline void MultiplexExecutor::remove(Id id) {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      auto entry = m_entries.find(id);
+      if(entry == m_entries.end() || entry->second->m_is_removed) {
+        return;
+      }
+      entry->second->m_is_removed = true;
+      m_removals.push_back(id);
+    }
+    m_update_condition.notify_one();
+  }
+
+  inline std::size_t MultiplexExecutor::get_size() const {
+    auto lock = std::lock_guard(m_mutex);
+    return m_entries.size() - m_removals.size();
+  }
+
+  inline void MultiplexExecutor::run_until_none() {
+    auto old_trigger = Trigger::get_trigger();
+    auto old_wheel = TimerWheel::get_wheel();
+    TimerWheel::set_wheel(&m_timers);
+    while(run_ready()) {}
+    TimerWheel::set_wheel(old_wheel);
+    Trigger::set_trigger(old_trigger);
+  }
+
+  inline void MultiplexExecutor::run_until_complete() {
+    auto old_trigger = Trigger::get_trigger();
+    auto old_wheel = TimerWheel::get_wheel();
+    TimerWheel::set_wheel(&m_timers);
+    while(true) {
+      if(run_ready()) {
+        continue;
+      }
+      auto lock = std::unique_lock(m_mutex);
+      auto is_idle = [&] {
+        return m_ready.empty() && m_removals.empty() && !m_is_closed &&
+          !m_entries.empty();
+      };
+      if(is_idle()) {
+        auto start = Details::StatisticsRecorder::Clock::now();
+        while(is_idle()) {
+          if(auto expiry = m_timers.get_next_expiry()) {
+            if(m_update_condition.wait_until(lock, *expiry) ==
+                std::cv_status::timeout) {
+              break;
+            }
+          } else {
+            m_update_condition.wait(lock);
+          }
+        }
+        m_statistics.record_wakeup(
+          Details::StatisticsRecorder::Clock::now() - start);
+      }
+      if(m_is_closed || m_entries.empty()) {
+        break;
+      }
+    }
+    TimerWheel::set_wheel(old_wheel);
+    Trigger::set_trigger(old_trigger);
+  }
+
+  inline void MultiplexExecutor::close() {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      m_is_closed = true;
+    }
+    m_update_condition.notify_one();
+  }
+
+  inline ExecutorStatistics MultiplexExecutor::get_statistics() const
+      noexcept {
+    return m_statistics.load();
+  }
+
+  inline MultiplexExecutor::Slot::Slot(MultiplexExecutor& executor)
+    : m_id(-1),
+      m_trigger([this, &executor] { executor.on_update(m_id.load()); }) {}
+
+  template<typename R>
+  MultiplexExecutor::Entry::Entry(Id id, Slot& slot, R&& reactor)
+    : m_id(id),
+      m_reactor(std::forward<R>(reactor)),
+      m_slot(&slot),
+      m_sequence(0),
+      m_is_ready(false),
+      m_is_removed(false) {}
+
+  inline void MultiplexExecutor::on_update(Id id) {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      auto entry = m_entries.find(id);
+      if(entry == m_entries.end() || entry->second->m_is_ready ||
+          entry->second->m_is_removed) {
+        return;
+      }
+      entry->second->m_is_ready = true;
+      m_ready.push_back(id);
+      if(m_ready.size() != 1) {
+        return;
+      }
+    }
+    m_update_condition.notify_one();
+  }
+
+  inline bool MultiplexExecutor::run_ready() {
+    m_timers.advance(TimerWheel::Clock::now());
+    auto removed = std::vector<std::unique_ptr<Entry>>();
+    {
+      auto lock = std::lock_guard(m_mutex);
+      for(auto id : m_removals) {
+        auto entry = m_entries.find(id);
+        entry->second->m_slot->m_id.store(-1);
+        m_free_slots.push_back(entry->second->m_slot);
+        removed.push_back(std::move(entry->second));
+        m_entries.erase(entry);
+      }
+      m_removals.clear();
+      m_batch.swap(m_ready);
+      for(auto id : m_batch) {
+        auto entry = m_entries.find(id);
+        if(entry != m_entries.end() && !entry->second->m_is_removed) {
+          entry->second->m_is_ready = false;
+          m_active.push_back(entry->second.get());
+        }
+      }
+      m_batch.clear();
+    }
+    if(m_active.empty()) {
+      return false;
+    }
+    for(auto entry : m_active) {
+      Trigger::set_trigger(entry->m_slot->m_trigger);
+      auto start = Details::StatisticsRecorder::Clock::now();
+      auto state = entry->m_reactor.commit(entry->m_sequence);
+      ++entry->m_sequence;
+      m_statistics.record_commit(state,
+        Details::StatisticsRecorder::Clock::now() - start);
+      m_statistics.end_chain();
+      if(is_complete(state)) {
+        remove(entry->m_id);
+      } else if(has_continuation(state)) {
+        on_update(entry->m_id);
+      }
+    }
+    m_active.clear();
+    return true;
+  }
+}
+
+#endif
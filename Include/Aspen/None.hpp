@@ -1,6 +1,7 @@
 #ifndef ASPEN_NONE_HPP
 #define ASPEN_NONE_HPP
 #include <exception>
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -40,7 +41,7 @@ namespace Aspen {
 
   template<typename T>
   constexpr eval_result_t<typename None<T>::Type> None<T>::eval() const {
-    throw std::runtime_error("No evaluation.");
+    ASPEN_THROW(std::runtime_error("No evaluation."));
   }
 }
 
@@ -1,11 +1,336 @@
 #ifndef ASPEN_OPERATORS_HPP
 #define ASPEN_OPERATORS_HPP
+#include <cstddef>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include "Aspen/Constant.hpp"
 #include "Aspen/Lift.hpp"
 #include "Aspen/Traits.hpp"
 
 namespace Aspen {
+namespace Details {
+
+  struct AddOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left + right)) {
+      return left + right;
+    }
+  };
+
+  struct SubtractOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left - right)) {
+      return left - right;
+    }
+  };
+
+  struct MultiplyOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left * right)) {
+      return left * right;
+    }
+  };
+
+  struct DivideOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left / right)) {
+      return left / right;
+    }
+  };
+
+  struct ModulusOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left % right)) {
+      return left % right;
+    }
+  };
+
+  struct BitwiseXorOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left ^ right)) {
+      return left ^ right;
+    }
+  };
+
+  struct BitwiseAndOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left & right)) {
+      return left & right;
+    }
+  };
+
+  struct BitwiseOrOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left | right)) {
+      return left | right;
+    }
+  };
+
+  struct LeftShiftOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left << right)) {
+      return left << right;
+    }
+  };
+
+  struct RightShiftOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left >> right)) {
+      return left >> right;
+    }
+  };
+
+  struct LessOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left < right)) {
+      return left < right;
+    }
+  };
+
+  struct LessOrEqualOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left <= right)) {
+      return left <= right;
+    }
+  };
+
+  struct EqualOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left == right)) {
+      return left == right;
+    }
+  };
+
+  struct NotEqualOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left != right)) {
+      return left != right;
+    }
+  };
+
+  struct GreaterOrEqualOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left >= right)) {
+      return left >= right;
+    }
+  };
+
+  struct GreaterOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left > right)) {
+      return left > right;
+    }
+  };
+
+  struct LogicalAndOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left && right)) {
+      return left && right;
+    }
+  };
+
+  struct LogicalOrOperator {
+    template<typename L, typename R>
+    auto operator ()(const L& left, const R& right) const
+        noexcept(noexcept(left || right)) {
+      return left || right;
+    }
+  };
+
+  struct BitwiseNotOperator {
+    template<typename T>
+    auto operator ()(const T& value) const noexcept(noexcept(~value)) {
+      return ~value;
+    }
+  };
+
+  struct LogicalNotOperator {
+    template<typename T>
+    auto operator ()(const T& value) const noexcept(noexcept(!value)) {
+      return !value;
+    }
+  };
+
+  struct NegateOperator {
+    template<typename T>
+    auto operator ()(const T& value) const noexcept(noexcept(-value)) {
+      return -value;
+    }
+  };
+
+  struct PlusOperator {
+    template<typename T>
+    auto operator ()(const T& value) const noexcept(noexcept(+value)) {
+      return +value;
+    }
+  };
+
+  /**
+   * An operand of a fused expression that refers to one of the arguments of
+   * the Lift evaluating the expression.
+   * @param <T> The type of the argument.
+   */
+  template<typename T>
+  struct ExpressionLeaf {
+    static constexpr auto ARITY = std::size_t(1);
+
+    template<std::size_t O, typename A>
+    const T& evaluate(const A& arguments) const noexcept(
+        noexcept(static_cast<const T&>(std::get<O>(arguments)))) {
+      return static_cast<const T&>(std::get<O>(arguments));
+    }
+  };
+
+  /**
+   * Applies a unary operator to a fused expression.
+   * @param <O> The operator to apply.
+   * @param <N> The operand.
+   */
+  template<typename O, typename N>
+  struct UnaryExpression {
+    static constexpr auto ARITY = N::ARITY;
+    N m_operand;
+
+    template<std::size_t I, typename A>
+    decltype(auto) evaluate(const A& arguments) const noexcept(noexcept(
+        O()(m_operand.template evaluate<I>(arguments)))) {
+      return O()(m_operand.template evaluate<I>(arguments));
+    }
+  };
+
+  /**
+   * Applies a binary operator to two fused expressions.
+   * @param <O> The operator to apply.
+   * @param <L> The left hand operand.
+   * @param <R> The right hand operand.
+   */
+  template<typename O, typename L, typename R>
+  struct BinaryExpression {
+    static constexpr auto ARITY = L::ARITY + R::ARITY;
+    L m_left;
+    R m_right;
+
+    template<std::size_t I, typename A>
+    decltype(auto) evaluate(const A& arguments) const noexcept(noexcept(
+        O()(m_left.template evaluate<I>(arguments),
+        m_right.template evaluate<I + L::ARITY>(arguments)))) {
+      return O()(m_left.template evaluate<I>(arguments),
+        m_right.template evaluate<I + L::ARITY>(arguments));
+    }
+  };
+
+  /**
+   * The function of a Lift that evaluates a tree of operators over its
+   * arguments in a single call.
+   * @param <N> The root of the expression.
+   */
+  template<typename N>
+  struct Expression {
+    N m_root;
+
+    template<typename... A>
+    decltype(auto) operator ()(const A&... arguments) const noexcept(noexcept(
+        m_root.template evaluate<0>(std::forward_as_tuple(arguments...)))) {
+      return m_root.template evaluate<0>(std::forward_as_tuple(arguments...));
+    }
+  };
+
+  /**
+   * Splits an operand into an expression and the reactors it's evaluated
+   * over. A Lift of an Expression contributes its expression and arguments,
+   * so that nested operators collapse into a single Lift.
+   */
+  template<typename T>
+  struct ExpressionOperand {
+    using Node = ExpressionLeaf<reactor_result_t<T>>;
+
+    template<typename Q>
+    static auto get_arguments(Q&& operand) {
+      return std::tuple<std::decay_t<T>>(std::forward<Q>(operand));
+    }
+  };
+
+  template<typename N, typename... A>
+  struct ExpressionOperand<Lift<Expression<N>, A...>> {
+    using Node = N;
+
+    template<typename Q>
+    static auto get_arguments(Q&& operand) {
+      return apply([] (auto&&... arguments) {
+        return std::tuple<A...>(std::forward<
+          std::conditional_t<std::is_lvalue_reference_v<Q>,
+          decltype(arguments), std::decay_t<decltype(arguments)>>>(
+          arguments)...);
+      }, operand.m_handler);
+    }
+  };
+
+  template<typename N, typename A>
+  auto make_expression(A&& arguments) {
+    return std::apply([] (auto&&... arguments) {
+      return Lift(Expression<N>(), std::move(arguments)...);
+    }, std::forward<A>(arguments));
+  }
+
+  /**
+   * Applies a unary operator, fusing it with its operand's expression. A
+   * Constant operand is folded into a Constant when the operator can't
+   * throw.
+   * @param series The operand.
+   */
+  template<typename O, typename T>
+  auto fuse(T&& series) {
+    if constexpr(is_constant_v<std::decay_t<T>> && std::is_nothrow_invocable_v<
+        O, const reactor_result_t<T>&>) {
+      return Constant(O()(series.eval()));
+    } else {
+      using Operand = ExpressionOperand<std::decay_t<T>>;
+      return make_expression<UnaryExpression<O, typename Operand::Node>>(
+        Operand::get_arguments(std::forward<T>(series)));
+    }
+  }
+
+  /**
+   * Applies a binary operator, fusing it with its operands' expressions.
+   * Constant operands are folded into a Constant when the operator can't
+   * throw.
+   * @param left The left hand operand.
+   * @param right The right hand operand.
+   */
+  template<typename O, typename L, typename R>
+  auto fuse(L&& left, R&& right) {
+    if constexpr(is_constant_v<std::decay_t<L>> &&
+        is_constant_v<std::decay_t<R>> && std::is_nothrow_invocable_v<O,
+        const reactor_result_t<L>&, const reactor_result_t<R>&>) {
+      return Constant(O()(left.eval(), right.eval()));
+    } else {
+      using Left = ExpressionOperand<std::decay_t<L>>;
+      using Right = ExpressionOperand<std::decay_t<R>>;
+      return make_expression<BinaryExpression<O, typename Left::Node,
+        typename Right::Node>>(std::tuple_cat(
+        Left::get_arguments(std::forward<L>(left)),
+        Right::get_arguments(std::forward<R>(right))));
+    }
+  }
+}
 
   /**
    * Adds two reactors together.
@@ -16,12 +341,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator +(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left + right)) {
-      return left + right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::AddOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -33,12 +354,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator -(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left - right)) {
-      return left - right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::SubtractOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -50,12 +367,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator *(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left * right)) {
-      return left * right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::MultiplyOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -67,12 +380,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator /(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left / right)) {
-      return left / right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::DivideOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -84,12 +393,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator %(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left % right)) {
-      return left % right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::ModulusOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -101,12 +406,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator ^(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left ^ right)) {
-      return left ^ right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::BitwiseXorOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -118,12 +419,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator &(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left & right)) {
-      return left & right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::BitwiseAndOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -135,12 +432,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator |(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left | right)) {
-      return left | right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::BitwiseOrOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -150,10 +443,7 @@ namespace Aspen {
    */
   template<typename T, typename = std::enable_if_t<is_reactor_v<T>>>
   auto operator ~(T&& series) {
-    using Type = reactor_result_t<T>;
-    return lift([] (const Type& value) noexcept(noexcept(~value)) {
-      return ~value;
-    }, std::forward<T>(series));
+    return Details::fuse<Details::BitwiseNotOperator>(std::forward<T>(series));
   }
 
   /**
@@ -163,10 +453,7 @@ namespace Aspen {
    */
   template<typename T, typename = std::enable_if_t<is_reactor_v<T>>>
   auto operator !(T&& series) {
-    using Type = reactor_result_t<T>;
-    return lift([] (const Type& value) noexcept(noexcept(!value)) {
-      return !value;
-    }, std::forward<T>(series));
+    return Details::fuse<Details::LogicalNotOperator>(std::forward<T>(series));
   }
 
   /**
@@ -178,12 +465,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator <<(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left << right)) {
-      return left << right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::LeftShiftOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -195,12 +478,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator >>(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left >> right)) {
-      return left >> right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::RightShiftOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -213,12 +492,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator <(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left < right)) {
-      return left < right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::LessOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -231,12 +506,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator <=(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left <= right)) {
-      return left <= right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::LessOrEqualOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -248,12 +519,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator ==(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left == right)) {
-      return left == right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::EqualOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -265,12 +532,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator !=(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left != right)) {
-      return left != right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::NotEqualOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -283,12 +546,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator >=(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left >= right)) {
-      return left >= right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::GreaterOrEqualOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -301,12 +560,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator >(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left > right)) {
-      return left > right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::GreaterOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -316,10 +571,7 @@ namespace Aspen {
    */
   template<typename T, typename = std::enable_if_t<is_reactor_v<T>>>
   auto operator -(T&& series) {
-    using Type = reactor_result_t<T>;
-    return lift([] (const Type& value) noexcept(noexcept(-value)) {
-      return -value;
-    }, std::forward<T>(series));
+    return Details::fuse<Details::NegateOperator>(std::forward<T>(series));
   }
 
   /**
@@ -329,10 +581,7 @@ namespace Aspen {
    */
   template<typename T, typename = std::enable_if_t<is_reactor_v<T>>>
   auto operator +(T&& series) {
-    using Type = reactor_result_t<T>;
-    return lift([] (const Type& value) noexcept(noexcept(+value)) {
-      return +value;
-    }, std::forward<T>(series));
+    return Details::fuse<Details::PlusOperator>(std::forward<T>(series));
   }
 
   /**
@@ -344,12 +593,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator &&(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left && right)) {
-      return left && right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::LogicalAndOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 
   /**
@@ -361,12 +606,8 @@ namespace Aspen {
   template<typename L, typename R, typename =
     std::enable_if_t<is_reactor_v<L> && is_reactor_v<R>>>
   auto operator ||(L&& left, R&& right) {
-    using Left = reactor_result_t<L>;
-    using Right = reactor_result_t<R>;
-    return lift([] (const Left& left, const Right& right)
-        noexcept(noexcept(left || right)) {
-      return left || right;
-    }, std::forward<L>(left), std::forward<R>(right));
+    return Details::fuse<Details::LogicalOrOperator>(std::forward<L>(left),
+      std::forward<R>(right));
   }
 }
 
@@ -1,29 +1,118 @@
 #ifndef ASPEN_OVERRIDE_HPP
 #define ASPEN_OVERRIDE_HPP
+#include <optional>
+#include <type_traits>
 #include <utility>
-#include "Aspen/Concat.hpp"
-#include "Aspen/Count.hpp"
-#include "Aspen/Lift.hpp"
-#include "Aspen/Operators.hpp"
-#include "Aspen/Shared.hpp"
+#include "Aspen/Error.hpp"
+#include "Aspen/Maybe.hpp"
+#include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
-#include "Aspen/Until.hpp"
 
 namespace Aspen {
 
+  /**
+   * Implements a reactor that evaluates to the reactors produced by its child,
+   * where each successively produced reactor overrides the previous.
+   * @param <R> The type of reactor producing the reactors to evaluate.
+   */
+  template<typename R>
+  class Override {
+    public:
+      using Reactor = R;
+      using Child = reactor_result_t<Reactor>;
+      using Type = reactor_result_t<Child>;
+      static constexpr auto is_noexcept = is_noexcept_reactor_v<Child>;
+
+      /**
+       * Constructs an Override.
+       * @param producer The reactor producing the reactors to evaluate.
+       */
+      template<typename RF, typename = std::enable_if_t<
+        !std::is_base_of_v<Override, std::decay_t<RF>>>>
+      explicit Override(RF&& producer);
+
+      State commit(int sequence) noexcept;
+
+      eval_result_t<Type> eval() const noexcept(is_noexcept);
+
+      /** Returns the error the current child evaluated to, if any. */
+      Error get_error() const noexcept;
+
+    private:
+      Reactor m_producer;
+      bool m_is_producer_complete;
+      std::optional<Child> m_child;
+      try_maybe_t<Type, !is_noexcept> m_value;
+  };
+
+  template<typename R>
+  Override(R&&) -> Override<to_reactor_t<R>>;
+
   /**
    * Implements a reactor that evaluates to the reactors produced by its child,
    * where each successively produced reactor overrides the previous.
    */
   template<typename T>
   auto override(T&& producer) {
-    using Reactor = reactor_result_t<T>;
-    auto producer_handle = Shared(std::forward<T>(producer));
-    auto counter = Shared(count(producer_handle));
-    return concat(lift(
-      [=] (const Reactor& reactor, int count) mutable {
-        return Shared(until(counter != constant(count), reactor));
-      }, std::move(producer_handle), std::move(counter)));
+    return Override(std::forward<T>(producer));
+  }
+
+  template<typename R>
+  template<typename RF, typename>
+  Override<R>::Override(RF&& producer)
+    : m_producer(std::forward<RF>(producer)),
+      m_is_producer_complete(false) {}
+
+  template<typename R>
+  State Override<R>::commit(int sequence) noexcept {
+    auto state = State::NONE;
+    auto has_producer_continuation = false;
+    if(!m_is_producer_complete) {
+      auto producer_state = m_producer.commit(sequence);
+      if(has_evaluation(producer_state)) {
+        m_child = std::nullopt;
+        if(!eval_error(m_producer)) {
+          ASPEN_TRY {
+            m_child.emplace(m_producer.eval());
+          } ASPEN_CATCH(...) {}
+        }
+      }
+      m_is_producer_complete = is_complete(producer_state);
+      has_producer_continuation = has_continuation(producer_state);
+    }
+    if(m_child.has_value()) {
+      auto child_state = m_child->commit(sequence);
+      if(has_evaluation(child_state)) {
+        m_value = try_eval(*m_child);
+        state = State::EVALUATED;
+      }
+      if(is_complete(child_state)) {
+        m_child = std::nullopt;
+      } else if(has_continuation(child_state)) {
+        state = combine(state, State::CONTINUE);
+      }
+    }
+    if(m_is_producer_complete && !m_child.has_value()) {
+      state = combine(state, State::COMPLETE);
+    } else if(has_producer_continuation) {
+      state = combine(state, State::CONTINUE);
+    }
+    return state;
+  }
+
+  template<typename R>
+  eval_result_t<typename Override<R>::Type> Override<R>::eval() const
+      noexcept(is_noexcept) {
+    return *m_value;
+  }
+
+  template<typename R>
+  Error Override<R>::get_error() const noexcept {
+    if constexpr(is_noexcept) {
+      return Error();
+    } else {
+      return m_value.get_exception();
+    }
   }
 }
 
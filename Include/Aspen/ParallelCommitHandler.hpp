@@ -0,0 +1,410 @@
+#ifndef ASPEN_PARALLEL_COMMIT_HANDLER_HPP
+#define ASPEN_PARALLEL_COMMIT_HANDLER_HPP
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Aspen/Batch.hpp"
+#include "Aspen/CommitHandler.hpp"
+#include "Aspen/CommitPool.hpp"
+#include "Aspen/Constant.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/StaticCommitHandler.hpp"
+#include "Aspen/Traits.hpp"
+#include "Aspen/Trigger.hpp"
+
+namespace Aspen {
+
+  /**
+   * Commits a list of reactors on a CommitPool and evaluates to their
+   * aggregate state, as a CommitHandler does. When committing in parallel,
+   * every child is committed even if one of them completes without
+   * evaluating. Children must not share any reactors with one another.
+   * @param <R> The type of reactor to manage.
+   */
+  template<typename R>
+  class ParallelCommitHandler {
+    public:
+
+      /**
+       * Constructs a ParallelCommitHandler.
+       * @param parallel The conditions under which to commit in parallel.
+       * @param children The reactors whose commits are to be managed.
+       * @param policy Specifies which children are committed.
+       */
+      template<typename A = std::allocator<R>>
+      ParallelCommitHandler(ParallelCommit parallel,
+        std::vector<R, A> children, CommitPolicy policy = CommitPolicy::ALL);
+
+      /**
+       * Commits all children and returns their aggregate State.
+       * @param sequence The commit's sequence.
+       * @return The aggregate State of all children.
+       */
+      State commit(int sequence) noexcept;
+
+      /** Returns the number of reactors managed. */
+      std::size_t size() const noexcept;
+
+      /** Returns the reactor at the specified index. */
+      const R& get(std::size_t i) const noexcept;
+
+      /** Returns the reactor at the specified index. */
+      R& get(std::size_t i) noexcept;
+
+    private:
+      CommitHandler<R> m_handler;
+      ParallelCommit m_parallel;
+
+      State commit_dirty(int sequence) noexcept;
+  };
+
+  /**
+   * Commits a list of reactors on a CommitPool and evaluates to their
+   * aggregate state, as a StaticCommitHandler does. When committing in
+   * parallel, every child is committed even if one of them completes without
+   * evaluating. Children must not share any reactors with one another.
+   * @param <R> The types of each reactor to manage.
+   */
+  template<typename... R>
+  class ParallelStaticCommitHandler {
+    public:
+
+      /**
+       * Constructs a ParallelStaticCommitHandler.
+       * @param parallel The conditions under which to commit in parallel.
+       * @param children The reactors whose commits are to be managed.
+       */
+      template<typename... A>
+      explicit ParallelStaticCommitHandler(ParallelCommit parallel,
+        A&&... children);
+
+      /**
+       * Commits all children and returns their aggregate State.
+       * @param sequence The commit's sequence.
+       * @return The aggregate State of all children.
+       */
+      State commit(int sequence) noexcept;
+
+      /**
+       * Commits all children, allowing batch-aware children to evaluate to a
+       * batch, and returns their aggregate State.
+       * @param sequence The commit's sequence.
+       * @return The aggregate State of all children.
+       */
+      State commit_batch(int sequence) noexcept;
+
+      /**
+       * Returns a mask of the children that evaluated during the last commit.
+       * Constant children are never included.
+       */
+      std::bitset<sizeof...(R)> get_evaluations() const noexcept;
+
+      /**
+       * Returns the State the reactor at the specified index reported on its
+       * last commit. Constant children are always COMPLETE_EVALUATED.
+       */
+      template<std::size_t I>
+      State get_state() const noexcept;
+
+      /** Returns the reactor at the specified index. */
+      template<std::size_t I>
+      const std::tuple_element_t<I, std::tuple<R...>>& get() const noexcept;
+
+      /** Returns the reactor at the specified index. */
+      template<std::size_t I>
+      std::tuple_element_t<I, std::tuple<R...>>& get() noexcept;
+
+    private:
+      StaticCommitHandler<R...> m_handler;
+      ParallelCommit m_parallel;
+
+      template<typename C>
+      State commit(int sequence, C&& committer) noexcept;
+  };
+
+  template<typename... A>
+  ParallelStaticCommitHandler(ParallelCommit, A&&...) ->
+    ParallelStaticCommitHandler<std::decay_t<A>...>;
+
+  template<typename R>
+  template<typename A>
+  ParallelCommitHandler<R>::ParallelCommitHandler(ParallelCommit parallel,
+    std::vector<R, A> children, CommitPolicy policy)
+    : m_handler(std::move(children), policy),
+      m_parallel(std::move(parallel)) {}
+
+  template<typename R>
+  State ParallelCommitHandler<R>::commit(int sequence) noexcept {
+    auto& children = m_handler.m_children;
+    if(children.empty()) {
+      return State::COMPLETE;
+    }
+    if(m_handler.m_dirty_set) {
+      return commit_dirty(sequence);
+    }
+    m_parallel.run(children.size(), [&] (std::size_t i) noexcept {
+      auto& child = children[i];
+      if(is_complete(child.m_state)) {
+        child.m_state = State::COMPLETE;
+      } else {
+        child.m_state = child.m_reactor.commit(sequence);
+      }
+    });
+    auto state = State::NONE;
+    auto evaluation_count = std::size_t(0);
+    auto completion_count = std::size_t(0);
+    auto has_continue = false;
+    for(auto& child : children) {
+      if(m_handler.m_is_initializing) {
+        child.m_has_evaluation |= has_evaluation(child.m_state);
+        if(child.m_has_evaluation) {
+          ++evaluation_count;
+        }
+      } else if(has_evaluation(child.m_state)) {
+        ++evaluation_count;
+      }
+      if(is_complete(child.m_state)) {
+        ++completion_count;
+        if(!child.m_has_evaluation) {
+          return State::COMPLETE;
+        }
+      } else {
+        has_continue |= has_continuation(child.m_state);
+      }
+    }
+    if(m_handler.m_is_initializing) {
+      if(evaluation_count == children.size()) {
+        m_handler.m_is_initializing = false;
+        state = combine(state, State::EVALUATED);
+      }
+    } else if(evaluation_count != 0) {
+      state = combine(state, State::EVALUATED);
+    }
+    if(completion_count == children.size()) {
+      state = combine(state, State::COMPLETE);
+    } else if(has_continue) {
+      state = combine(state, State::CONTINUE);
+    }
+    return state;
+  }
+
+  template<typename R>
+  State ParallelCommitHandler<R>::commit_dirty(int sequence) noexcept {
+    static constexpr auto SKIPPED = std::numeric_limits<std::size_t>::max();
+    auto& children = m_handler.m_children;
+    auto& dirty_set = *m_handler.m_dirty_set;
+    if(dirty_set.m_parent == nullptr) {
+      dirty_set.m_parent = Trigger::get_trigger();
+    }
+    dirty_set.m_dirty.clear();
+    {
+      auto lock = std::lock_guard(dirty_set.m_mutex);
+      dirty_set.m_dirty.swap(dirty_set.m_signals);
+    }
+    for(auto i : dirty_set.m_continuations) {
+      if(!dirty_set.m_is_dirty[i].exchange(true, std::memory_order_acq_rel)) {
+        dirty_set.m_dirty.push_back(i);
+      }
+    }
+    dirty_set.m_continuations.clear();
+    std::sort(dirty_set.m_dirty.begin(), dirty_set.m_dirty.end());
+    m_parallel.run(dirty_set.m_dirty.size(), [&] (std::size_t j) noexcept {
+      auto i = dirty_set.m_dirty[j];
+      dirty_set.m_is_dirty[i].store(false, std::memory_order_release);
+      auto& child = children[i];
+      if(is_complete(child.m_state)) {
+        dirty_set.m_dirty[j] = SKIPPED;
+        return;
+      }
+      auto parent = Trigger::get_trigger();
+      Trigger::set_trigger(dirty_set.m_triggers[i]);
+      child.m_state = child.m_reactor.commit(sequence);
+      Trigger::set_trigger(parent);
+    });
+    auto evaluation_count = std::size_t(0);
+    for(auto i : dirty_set.m_dirty) {
+      if(i == SKIPPED) {
+        continue;
+      }
+      auto& child = children[i];
+      if(has_evaluation(child.m_state)) {
+        ++evaluation_count;
+        if(!child.m_has_evaluation) {
+          child.m_has_evaluation = true;
+          ++dirty_set.m_evaluation_count;
+        }
+      }
+      if(is_complete(child.m_state)) {
+        ++dirty_set.m_completion_count;
+        if(!child.m_has_evaluation) {
+          return State::COMPLETE;
+        }
+      } else if(has_continuation(child.m_state)) {
+        dirty_set.m_continuations.push_back(i);
+      }
+    }
+    auto state = State::NONE;
+    if(m_handler.m_is_initializing) {
+      if(dirty_set.m_evaluation_count == children.size()) {
+        m_handler.m_is_initializing = false;
+        state = State::EVALUATED;
+      }
+    } else if(evaluation_count != 0) {
+      state = State::EVALUATED;
+    }
+    if(dirty_set.m_completion_count == children.size()) {
+      state = combine(state, State::COMPLETE);
+    } else if(!dirty_set.m_continuations.empty()) {
+      state = combine(state, State::CONTINUE);
+    }
+    return state;
+  }
+
+  template<typename R>
+  std::size_t ParallelCommitHandler<R>::size() const noexcept {
+    return m_handler.size();
+  }
+
+  template<typename R>
+  const R& ParallelCommitHandler<R>::get(std::size_t i) const noexcept {
+    return m_handler.get(i);
+  }
+
+  template<typename R>
+  R& ParallelCommitHandler<R>::get(std::size_t i) noexcept {
+    return m_handler.get(i);
+  }
+
+  template<typename... R>
+  template<typename... A>
+  ParallelStaticCommitHandler<R...>::ParallelStaticCommitHandler(
+    ParallelCommit parallel, A&&... children)
+    : m_handler(std::forward<A>(children)...),
+      m_parallel(std::move(parallel)) {}
+
+  template<typename... R>
+  State ParallelStaticCommitHandler<R...>::commit(int sequence) noexcept {
+    return commit(sequence, [] (auto& reactor, int sequence) noexcept {
+      return reactor.commit(sequence);
+    });
+  }
+
+  template<typename... R>
+  State ParallelStaticCommitHandler<R...>::commit_batch(int sequence)
+      noexcept {
+    return commit(sequence, [] (auto& reactor, int sequence) noexcept {
+      return Aspen::commit_batch(reactor, sequence);
+    });
+  }
+
+  template<typename... R>
+  template<typename C>
+  State ParallelStaticCommitHandler<R...>::commit(int sequence,
+      C&& committer) noexcept {
+    if(sizeof...(R) == 0) {
+      return State::COMPLETE;
+    }
+    auto& children = m_handler.m_children;
+    m_parallel.run(sizeof...(R), [&] (std::size_t i) noexcept {
+      for_each<0, sizeof...(R)>([&] (auto index) noexcept {
+        constexpr auto I = decltype(index)::value;
+        if(I != i) {
+          return;
+        }
+        auto& child = std::get<I>(children);
+        if constexpr(!is_constant_v<
+            std::decay_t<decltype(child.m_reactor)>>) {
+          if(is_complete(child.m_state)) {
+            child.m_state = State::COMPLETE;
+          } else {
+            child.m_state = committer(child.m_reactor, sequence);
+          }
+        }
+      });
+    });
+    auto& is_initializing = m_handler.m_is_initializing;
+    auto state = State::NONE;
+    auto evaluation_count = std::size_t(0);
+    auto completion_count = std::size_t(0);
+    auto has_continue = false;
+    for_each(children, [&] (auto& child) noexcept {
+      if constexpr(is_constant_v<
+          std::decay_t<decltype(child.m_reactor)>>) {
+        ++completion_count;
+        if(is_initializing) {
+          ++evaluation_count;
+        }
+      } else {
+        if(is_initializing) {
+          child.m_has_evaluation |= has_evaluation(child.m_state);
+          if(child.m_has_evaluation) {
+            ++evaluation_count;
+          }
+        } else if(has_evaluation(child.m_state)) {
+          ++evaluation_count;
+        }
+        if(is_complete(child.m_state)) {
+          ++completion_count;
+          if(!child.m_has_evaluation) {
+            state = State::COMPLETE;
+          }
+        } else {
+          has_continue |= has_continuation(child.m_state);
+        }
+      }
+    });
+    if(state == State::COMPLETE) {
+      return State::COMPLETE;
+    }
+    if(is_initializing) {
+      if(evaluation_count == sizeof...(R)) {
+        is_initializing = false;
+        state = combine(state, State::EVALUATED);
+      }
+    } else if(evaluation_count != 0) {
+      state = combine(state, State::EVALUATED);
+    }
+    if(completion_count == sizeof...(R)) {
+      state = combine(state, State::COMPLETE);
+    } else if(has_continue) {
+      state = combine(state, State::CONTINUE);
+    }
+    return state;
+  }
+
+  template<typename... R>
+  std::bitset<sizeof...(R)>
+      ParallelStaticCommitHandler<R...>::get_evaluations() const noexcept {
+    return m_handler.get_evaluations();
+  }
+
+  template<typename... R>
+  template<std::size_t I>
+  State ParallelStaticCommitHandler<R...>::get_state() const noexcept {
+    return m_handler.template get_state<I>();
+  }
+
+  template<typename... R>
+  template<std::size_t I>
+  std::tuple_element_t<I, std::tuple<R...>>&
+      ParallelStaticCommitHandler<R...>::get() noexcept {
+    return m_handler.template get<I>();
+  }
+
+  template<typename... R>
+  template<std::size_t I>
+  const std::tuple_element_t<I, std::tuple<R...>>&
+      ParallelStaticCommitHandler<R...>::get() const noexcept {
+    return m_handler.template get<I>();
+  }
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef ASPEN_PARALLEL_LIFT_HPP
+#define ASPEN_PARALLEL_LIFT_HPP
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "Aspen/CommitPool.hpp"
+#include "Aspen/Error.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/Traits.hpp"
+
+namespace Aspen {
+namespace Details {
+
+  /**
+   * Wraps a reactor that's committed ahead of its parent, reporting the State
+   * of that commit when the parent commits it.
+   * @param <R> The type of reactor to wrap.
+   */
+  template<typename R>
+  struct DeferredCommit {
+    using Type = reactor_result_t<R>;
+    using Result = decltype(std::declval<const R&>().eval());
+    static constexpr auto is_noexcept = is_noexcept_reactor_v<R>;
+    R m_reactor;
+    State m_state;
+
+    template<typename RF, typename = std::enable_if_t<
+      !std::is_base_of_v<DeferredCommit, std::decay_t<RF>>>>
+    explicit DeferredCommit(RF&& reactor);
+
+    State commit(int sequence) noexcept;
+
+    Result eval() const noexcept(is_noexcept);
+
+    Error get_error() const noexcept;
+  };
+
+  template<typename R>
+  template<typename RF, typename>
+  DeferredCommit<R>::DeferredCommit(RF&& reactor)
+    : m_reactor(std::forward<RF>(reactor)),
+      m_state(State::NONE) {}
+
+  template<typename R>
+  State DeferredCommit<R>::commit(int) noexcept {
+    return m_state;
+  }
+
+  template<typename R>
+  typename DeferredCommit<R>::Result DeferredCommit<R>::eval() const
+      noexcept(is_noexcept) {
+    return m_reactor.eval();
+  }
+
+  template<typename R>
+  Error DeferredCommit<R>::get_error() const noexcept {
+    return eval_error(m_reactor);
+  }
+}
+
+  /**
+   * A Lift whose arguments are committed on a CommitPool. The arguments must
+   * not share any reactors with one another.
+   * @param <F> The type of function to apply.
+   * @param <A> The type of arguments to apply the function to.
+   */
+  template<typename F, typename... A>
+  class ParallelLift {
+    public:
+      using Reactor = Lift<F, Details::DeferredCommit<A>...>;
+      using Type = typename Reactor::Type;
+
+      /** Whether this reactor's eval is noexcept. */
+      static constexpr auto is_noexcept = Reactor::is_noexcept;
+
+      /**
+       * Constructs a ParallelLift.
+       * @param parallel The conditions under which to commit the arguments in
+       *        parallel.
+       * @param function The function to apply.
+       * @param arguments The arguments to apply the <i>function</i> to.
+       */
+      template<typename FF, typename... AF>
+      ParallelLift(ParallelCommit parallel, FF&& function,
+        AF&&... arguments);
+
+      State commit(int sequence) noexcept;
+
+      eval_result_t<Type> eval() const noexcept(is_noexcept);
+
+      /** Returns the error this reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
+    private:
+      Reactor m_reactor;
+      ParallelCommit m_parallel;
+  };
+
+  template<typename F, typename AF, typename... AR>
+  ParallelLift(ParallelCommit, F&&, AF&&, AR&&...) ->
+    ParallelLift<std::decay_t<F>, to_reactor_t<AF>, to_reactor_t<AR>...>;
+
+  /**
+   * Lifts a function to operate on reactors that are committed in parallel
+   * on a CommitPool. The arguments must not share any reactors with one
+   * another.
+   * @param parallel The conditions under which to commit the arguments in
+   *        parallel.
+   * @param function The function to lift.
+   * @param argument The first reactor used as an argument to the function.
+   * @param arguments The remaining reactors used as arguments.
+   */
+  template<typename F, typename A, typename... B>
+  auto parallel_lift(ParallelCommit parallel, F&& function, A&& argument,
+      B&&... arguments) {
+    return ParallelLift(std::move(parallel), std::forward<F>(function),
+      std::forward<A>(argument), std::forward<B>(arguments)...);
+  }
+
+  template<typename F, typename... A>
+  template<typename FF, typename... AF>
+  ParallelLift<F, A...>::ParallelLift(ParallelCommit parallel,
+    FF&& function, AF&&... arguments)
+    : m_reactor(std::forward<FF>(function), std::forward<AF>(arguments)...),
+      m_parallel(std::move(parallel)) {}
+
+  template<typename F, typename... A>
+  State ParallelLift<F, A...>::commit(int sequence) noexcept {
+    auto& handler = m_reactor.m_handler;
+    m_parallel.run(sizeof...(A), [&] (std::size_t i) noexcept {
+      for_each<0, sizeof...(A)>([&] (auto index) noexcept {
+        constexpr auto I = decltype(index)::value;
+        if(I != i) {
+          return;
+        }
+        auto& argument = handler.template get<I>();
+        if(!is_complete(argument.m_state)) {
+          argument.m_state = argument.m_reactor.commit(sequence);
+        }
+      });
+    });
+    return m_reactor.commit(sequence);
+  }
+
+  template<typename F, typename... A>
+  eval_result_t<typename ParallelLift<F, A...>::Type>
+      ParallelLift<F, A...>::eval() const noexcept(is_noexcept) {
+    return m_reactor.eval();
+  }
+
+  template<typename F, typename... A>
+  Error ParallelLift<F, A...>::get_error() const noexcept {
+    return m_reactor.get_error();
+  }
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef ASPEN_PROXY_HPP
 #define ASPEN_PROXY_HPP
 #include <optional>
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -27,6 +28,9 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const noexcept(is_noexcept);
 
+      /** Returns the error the proxied reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       std::optional<T> m_reactor;
       bool m_has_cycle;
@@ -73,6 +77,11 @@ namespace Aspen {
       const noexcept(is_noexcept) {
     return m_reactor->eval();
   }
+
+  template<typename T>
+  Error Proxy<T>::get_error() const noexcept {
+    return eval_error(*m_reactor);
+  }
 }
 
 #endif
@@ -28,8 +28,8 @@ namespace Aspen {
           return pybind11::object(pybind11::none());
         }, std::forward<R>(reactor)));
     } else {
-      return shared_box(ConversionReactor(std::forward<R>(reactor),
-        [] (auto&& value) {
+      return shared_box(convert<EvalPolicy::CACHED>(
+        std::forward<R>(reactor), [] (auto&& value) {
           return pybind11::cast(std::forward<decltype(value)>(value));
         }));
     }
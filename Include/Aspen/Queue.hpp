@@ -2,10 +2,15 @@
 #define ASPEN_QUEUE_HPP
 #include <deque>
 #include <exception>
+#include <memory>
 #include <mutex>
+#include <vector>
+#include "Aspen/Batch.hpp"
+#include "Aspen/Error.hpp"
 #include "Aspen/Maybe.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
+#include "Aspen/Transaction.hpp"
 #include "Aspen/Trigger.hpp"
 
 namespace Aspen {
@@ -43,7 +48,7 @@ namespace Aspen {
        * Sets an exception and brings this reactor to a completion state.
        * @param exception The exception to throw.
        */
-      void set_complete(std::exception_ptr exception);
+      void set_complete(Error exception);
 
       /**
        * Brings this reactor to a completion state by throwing an exception.
@@ -56,37 +61,69 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const;
 
+      /** Returns the error this reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
+      /**
+       * Commits this reactor, evaluating to every value pushed since the
+       * previous commit. Until the next commit, eval and get_error reflect
+       * the last value in the batch, so a consumer that doesn't batch sees
+       * only the most recent value.
+       * @param sequence The commit's sequence.
+       */
+      State commit_batch(int sequence) noexcept;
+
+      /** Returns the values evaluated by the last call to commit_batch. */
+      Batch<Type> eval_batch() const;
+
       Queue& operator =(Queue&& queue);
 
     private:
+      friend class Transaction;
       mutable std::mutex m_mutex;
       bool m_is_complete;
       bool m_has_commit;
+      bool m_is_batch;
       std::deque<Type> m_entries;
-      std::exception_ptr m_exception;
+      std::vector<Maybe<Type>> m_batch;
+      std::deque<Details::StagedValue<Type>> m_staged;
+      Error m_exception;
       Trigger* m_trigger;
+      int m_sequence;
+
+      bool claim_staged(int sequence);
+      void append(Type value);
+      void stage(const std::shared_ptr<Details::TransactionState>& transaction,
+        Type value);
+      Trigger* load_trigger();
   };
 
   template<typename T>
   Queue<T>::Queue()
     : m_is_complete(false),
       m_has_commit(false),
-      m_trigger(nullptr) {}
+      m_is_batch(false),
+      m_trigger(nullptr),
+      m_sequence(-1) {}
 
   template<typename T>
   Queue<T>::Queue(Queue&& queue) {
     auto lock = std::lock_guard(queue.m_mutex);
     m_is_complete = std::move(queue.m_is_complete);
     m_has_commit = std::move(queue.m_has_commit);
+    m_is_batch = std::move(queue.m_is_batch);
     m_entries = std::move(queue.m_entries);
+    m_batch = std::move(queue.m_batch);
+    m_staged = std::move(queue.m_staged);
     m_exception = std::move(queue.m_exception);
     m_trigger = std::move(queue.m_trigger);
+    m_sequence = queue.m_sequence;
   }
 
   template<typename T>
   void Queue<T>::push(Type value) {
     auto lock = std::lock_guard(m_mutex);
-    m_entries.emplace_back(std::move(value));
+    append(std::move(value));
     if(m_trigger != nullptr) {
       m_trigger->signal();
     }
@@ -105,14 +142,14 @@ namespace Aspen {
   void Queue<T>::set_complete(Type value) {
     auto lock = std::lock_guard(m_mutex);
     m_is_complete = true;
-    m_entries.emplace_back(std::move(value));
+    append(std::move(value));
     if(m_trigger != nullptr) {
       m_trigger->signal();
     }
   }
 
   template<typename T>
-  void Queue<T>::set_complete(std::exception_ptr exception) {
+  void Queue<T>::set_complete(Error exception) {
     auto lock = std::lock_guard(m_mutex);
     m_exception = std::move(exception);
     if(m_trigger != nullptr) {
@@ -123,59 +160,163 @@ namespace Aspen {
   template<typename T>
   template<typename E>
   void Queue<T>::set_complete(const E& exception) {
-    set_complete(std::make_exception_ptr(exception));
+    set_complete(make_error(exception));
   }
 
   template<typename T>
   State Queue<T>::commit(int sequence) noexcept {
     auto lock = std::lock_guard(m_mutex);
-    if(m_trigger == nullptr) {
-      m_trigger = Trigger::get_trigger();
-    }
+    auto has_continuation = claim_staged(sequence);
+    auto is_complete = m_is_complete && m_staged.empty();
     auto state = [&] {
       if(m_entries.size() > 1 || m_entries.size() == 1 && !m_has_commit) {
+        m_is_batch = false;
         if(m_has_commit) {
           m_entries.pop_front();
         } else {
           m_has_commit = true;
         }
-        if(m_entries.size() > 1 || m_exception != nullptr) {
+        if(m_entries.size() > 1 || m_exception) {
           return State::CONTINUE_EVALUATED;
-        } else if(m_is_complete) {
+        } else if(is_complete) {
           return State::COMPLETE_EVALUATED;
         } else {
           return State::EVALUATED;
         }
-      } else if(m_exception != nullptr) {
+      } else if(m_exception) {
+        m_is_batch = false;
         m_entries.clear();
         return State::COMPLETE_EVALUATED;
-      } else if(m_is_complete) {
+      } else if(is_complete) {
         return State::COMPLETE;
       } else {
         return State::NONE;
       }
     }();
+    if(has_continuation) {
+      state = combine(state, State::CONTINUE);
+    }
     return state;
   }
 
   template<typename T>
   eval_result_t<typename Queue<T>::Type> Queue<T>::eval() const {
     auto lock = std::lock_guard(m_mutex);
+    if(m_is_batch) {
+      return m_batch.back().get();
+    }
     if(m_entries.empty()) {
-      std::rethrow_exception(m_exception);
+      raise(m_exception);
     }
     return m_entries.front();
   }
 
+  template<typename T>
+  Error Queue<T>::get_error() const noexcept {
+    auto lock = std::lock_guard(m_mutex);
+    if(m_is_batch) {
+      return m_batch.back().get_exception();
+    }
+    if(m_entries.empty()) {
+      return m_exception;
+    }
+    return Error();
+  }
+
+  template<typename T>
+  State Queue<T>::commit_batch(int sequence) noexcept {
+    auto lock = std::lock_guard(m_mutex);
+    auto has_continuation = claim_staged(sequence);
+    auto is_complete = m_is_complete && m_staged.empty();
+    auto delivered = static_cast<std::size_t>(m_has_commit);
+    if(m_entries.size() <= delivered && !m_exception) {
+      if(is_complete) {
+        return State::COMPLETE;
+      } else if(has_continuation) {
+        return State::CONTINUE;
+      }
+      return State::NONE;
+    }
+    if(m_has_commit && !m_entries.empty()) {
+      m_entries.pop_front();
+    }
+    m_has_commit = false;
+    m_batch.clear();
+    m_batch.reserve(m_entries.size() + 1);
+    for(auto& entry : m_entries) {
+      m_batch.emplace_back(std::move(entry));
+    }
+    m_entries.clear();
+    m_is_batch = true;
+    if(m_exception) {
+      m_batch.emplace_back(m_exception);
+      return State::COMPLETE_EVALUATED;
+    } else if(is_complete) {
+      return State::COMPLETE_EVALUATED;
+    } else if(has_continuation) {
+      return State::CONTINUE_EVALUATED;
+    }
+    return State::EVALUATED;
+  }
+
+  template<typename T>
+  Batch<typename Queue<T>::Type> Queue<T>::eval_batch() const {
+    auto lock = std::lock_guard(m_mutex);
+    return Batch<Type>(m_batch.data(), m_batch.size());
+  }
+
+  template<typename T>
+  bool Queue<T>::claim_staged(int sequence) {
+    if(m_trigger == nullptr) {
+      m_trigger = Trigger::get_trigger();
+    }
+    m_sequence = sequence;
+    auto has_continuation = false;
+    while(!m_staged.empty() &&
+        Details::is_ready(m_staged.front(), sequence, has_continuation)) {
+      m_entries.emplace_back(std::move(m_staged.front().m_value));
+      m_staged.pop_front();
+    }
+    return has_continuation;
+  }
+
+  template<typename T>
+  void Queue<T>::append(Type value) {
+    if(m_staged.empty()) {
+      m_entries.emplace_back(std::move(value));
+    } else {
+      m_staged.push_back({nullptr, std::move(value)});
+    }
+  }
+
+  template<typename T>
+  void Queue<T>::stage(
+      const std::shared_ptr<Details::TransactionState>& transaction,
+      Type value) {
+    auto lock = std::lock_guard(m_mutex);
+    transaction->observe(m_sequence);
+    m_staged.push_back({transaction, std::move(value)});
+  }
+
+  template<typename T>
+  Trigger* Queue<T>::load_trigger() {
+    auto lock = std::lock_guard(m_mutex);
+    return m_trigger;
+  }
+
   template<typename T>
   Queue<T>& Queue<T>::operator =(Queue&& queue) {
     {
       auto lock = std::lock_guard(queue.m_mutex);
       m_is_complete = std::move(queue.m_is_complete);
       m_has_commit = std::move(queue.m_has_commit);
+      m_is_batch = std::move(queue.m_is_batch);
       m_entries = std::move(queue.m_entries);
+      m_batch = std::move(queue.m_batch);
+      m_staged = std::move(queue.m_staged);
       m_exception = std::move(queue.m_exception);
       m_trigger = std::move(queue.m_trigger);
+      m_sequence = queue.m_sequence;
     }
     return *this;
   }
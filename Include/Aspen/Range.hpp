@@ -2,68 +2,90 @@
 #define ASPEN_RANGE_HPP
 #include <algorithm>
 #include <optional>
+#include <type_traits>
 #include <utility>
 #include "Aspen/Constant.hpp"
-#include "Aspen/Lift.hpp"
+#include "Aspen/Error.hpp"
+#include "Aspen/LocalPtr.hpp"
 #include "Aspen/Maybe.hpp"
-#include "Aspen/Shared.hpp"
 #include "Aspen/State.hpp"
-#include "Aspen/StateReactor.hpp"
+#include "Aspen/StaticCommitHandler.hpp"
 #include "Aspen/Traits.hpp"
 
 namespace Aspen {
+namespace Details {
+  template<typename T>
+  Error get_range_error(const LocalPtr<T>&) noexcept {
+    return Error();
+  }
+
+  template<typename T>
+  Error get_range_error(const Maybe<T>& value) noexcept {
+    return value.get_exception();
+  }
+}
+
+  /**
+   * Implements a reactor that counts from a starting value to an end value
+   * (exclusive), evaluating to one value per commit.
+   * @param <S> The type of reactor producing the starting value.
+   * @param <E> The type of reactor producing the end value.
+   * @param <T> The type of reactor producing the increment.
+   */
+  template<typename S, typename E, typename T>
+  class Range {
+    public:
+      using Type = reactor_result_t<S>;
+      static constexpr auto is_noexcept = is_noexcept_reactor_v<S> &&
+        is_noexcept_reactor_v<E> && is_noexcept_reactor_v<T>;
+
+      /**
+       * Constructs a Range.
+       * @param start The first value to evaluate to.
+       * @param stop The value to stop evaluating at (exclusive).
+       * @param step The value to increment the evaluation by.
+       */
+      template<typename SF, typename EF, typename TF>
+      Range(SF&& start, EF&& stop, TF&& step);
+
+      State commit(int sequence) noexcept;
+
+      eval_result_t<Type> eval() const noexcept(is_noexcept);
+
+      /** Returns the error the range evaluates to, if any. */
+      Error get_error() const noexcept;
+
+    private:
+      StaticCommitHandler<S, E, T> m_handler;
+      std::optional<Type> m_value;
+      Error m_error;
+      bool m_is_initialized;
+      bool m_is_stop_complete;
+      bool m_has_continuation;
+
+      State advance() noexcept;
+  };
+
+  template<typename S, typename E, typename T>
+  Range(S&&, E&&, T&&) -> Range<to_reactor_t<S>, to_reactor_t<E>,
+    to_reactor_t<T>>;
 
   /**
    * Makes a reactor that counts from a starting value to an end value
-   * (inclusive).
+   * (exclusive).
    * @param start The first value to evaluate to.
    * @param stop The value to stop evaluating at (exclusive).
    * @param step The value to increment the evaluation by.
    */
   template<typename S, typename E, typename T>
   auto range(S&& start, E&& stop, T&& step) {
-    using Type = reactor_result_t<S>;
-    auto start_reactor = Shared(std::forward<S>(start));
-    auto start_updates = StateReactor(start_reactor);
-    auto stop_reactor = Shared(std::forward<E>(stop));
-    auto stop_updates = StateReactor(stop_reactor);
-    auto step_reactor = Shared(std::forward<T>(step));
-    auto step_updates = StateReactor(step_reactor);
-    return lift(
-      [value = std::optional<Type>()](const reactor_result_t<S>& start,
-          State start_state, const reactor_result_t<E>& end, State end_state,
-          const reactor_result_t<T>& step, State step_state) mutable noexcept {
-        auto c = [&] {
-          if(!value.has_value()) {
-            return start;
-          } else {
-            auto increment = *value + step;
-            return std::max(start, increment);
-          }
-        }();
-        if(c >= end) {
-          if(is_complete(end_state)) {
-            return FunctionEvaluation<Type>(State::COMPLETE);
-          }
-          return FunctionEvaluation<Type>(State::NONE);
-        }
-        value = c;
-        if(*value + step >= end) {
-          if(is_complete(end_state)) {
-            return FunctionEvaluation(*value, State::COMPLETE);
-          } else {
-            return FunctionEvaluation(*value);
-          }
-        }
-        return FunctionEvaluation(*value, State::CONTINUE_EVALUATED);
-      }, std::move(start_reactor), std::move(start_updates),
-      std::move(stop_reactor), std::move(stop_updates), std::move(step_reactor),
-      std::move(step_updates));
+    return Range(std::forward<S>(start), std::forward<E>(stop),
+      std::forward<T>(step));
   }
 
   /**
    * Makes a reactor that counts from a starting value to an end value
-   * (inclusive).
+   * (exclusive).
    * @param start The first value to evaluate to.
    * @param stop The value to stop evaluating at (exclusive).
    */
@@ -71,6 +93,105 @@ namespace Aspen {
   auto range(S&& start, E&& stop) {
     return range(std::forward<S>(start), std::forward<E>(stop), 1);
   }
+
+  template<typename S, typename E, typename T>
+  template<typename SF, typename EF, typename TF>
+  Range<S, E, T>::Range(SF&& start, EF&& stop, TF&& step)
+    : m_handler(std::forward<SF>(start), std::forward<EF>(stop),
+        std::forward<TF>(step)),
+      m_is_initialized(false),
+      m_is_stop_complete(false),
+      m_has_continuation(false) {}
+
+  template<typename S, typename E, typename T>
+  State Range<S, E, T>::commit(int sequence) noexcept {
+    auto children_state = m_handler.commit(sequence);
+    m_is_initialized |= has_evaluation(children_state);
+    auto is_stop_completion = false;
+    if(m_is_initialized && !m_is_stop_complete &&
+        is_complete(m_handler.template get_state<1>())) {
+      m_is_stop_complete = true;
+      is_stop_completion = true;
+    }
+    if(!has_evaluation(children_state) && !m_has_continuation &&
+        !is_stop_completion) {
+      return children_state;
+    }
+    m_has_continuation = false;
+    auto state = advance();
+    if(state == State::NONE) {
+      if(is_complete(children_state)) {
+        return State::COMPLETE;
+      } else if(has_continuation(children_state)) {
+        return State::CONTINUE;
+      }
+      return State::NONE;
+    } else if(is_complete(state)) {
+      return state;
+    }
+    m_has_continuation = has_continuation(state);
+    if(has_continuation(children_state)) {
+      state = combine(state, State::CONTINUE);
+    } else if(is_complete(children_state) && !m_has_continuation) {
+      state = combine(state, State::COMPLETE);
+    }
+    return state;
+  }
+
+  template<typename S, typename E, typename T>
+  eval_result_t<typename Range<S, E, T>::Type> Range<S, E, T>::eval() const
+      noexcept(is_noexcept) {
+    if constexpr(!is_noexcept) {
+      if(m_error) {
+        raise(m_error);
+      }
+    }
+    return *m_value;
+  }
+
+  template<typename S, typename E, typename T>
+  Error Range<S, E, T>::get_error() const noexcept {
+    return m_error;
+  }
+
+  template<typename S, typename E, typename T>
+  State Range<S, E, T>::advance() noexcept {
+    auto start = try_eval(m_handler.template get<0>());
+    auto stop = try_eval(m_handler.template get<1>());
+    auto step = try_eval(m_handler.template get<2>());
+    if constexpr(!is_noexcept) {
+      m_error = Details::get_range_error(start);
+      if(!m_error) {
+        m_error = Details::get_range_error(stop);
+      }
+      if(!m_error) {
+        m_error = Details::get_range_error(step);
+      }
+      if(m_error) {
+        return State::EVALUATED;
+      }
+    }
+    auto value = [&] {
+      if(!m_value.has_value()) {
+        return static_cast<Type>(*start);
+      }
+      return std::max<Type>(*start, *m_value + *step);
+    }();
+    if(value >= *stop) {
+      if(m_is_stop_complete) {
+        return State::COMPLETE;
+      }
+      return State::NONE;
+    }
+    m_value = std::move(value);
+    if(*m_value + *step >= *stop) {
+      if(m_is_stop_complete) {
+        return State::COMPLETE_EVALUATED;
+      }
+      return State::EVALUATED;
+    }
+    return State::CONTINUE_EVALUATED;
+  }
 }
 
 #endif
@@ -0,0 +1,93 @@
+#ifndef ASPEN_SAMPLE_HPP
+#define ASPEN_SAMPLE_HPP
+#include <type_traits>
+#include <utility>
+#include "Aspen/Error.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/Traits.hpp"
+
+namespace Aspen {
+
+  /**
+   * Reads the current value of a reactor without reporting its subsequent
+   * evaluations, so that a reactor using it as a child only recomputes when
+   * its other children change.
+   * @param <R> The type of reactor to sample.
+   */
+  template<typename R>
+  class Sample {
+    public:
+      using Reactor = R;
+      using Type = reactor_result_t<Reactor>;
+      using Result = decltype(std::declval<const Reactor&>().eval());
+      static constexpr auto is_noexcept = is_noexcept_reactor_v<Reactor>;
+
+      /**
+       * Constructs a Sample.
+       * @param reactor The reactor to sample.
+       */
+      template<typename RF, typename = std::enable_if_t<
+        !std::is_base_of_v<Sample, std::decay_t<RF>>>>
+      explicit Sample(RF&& reactor);
+
+      State commit(int sequence) noexcept;
+
+      Result eval() const noexcept(is_noexcept);
+
+      /** Returns the error the sampled reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
+    private:
+      Reactor m_reactor;
+      bool m_has_evaluation;
+  };
+
+  template<typename R>
+  Sample(R&&) -> Sample<to_reactor_t<R>>;
+
+  /**
+   * Samples a reactor, only reporting its first evaluation.
+   * @param reactor The reactor to sample.
+   */
+  template<typename R>
+  auto sample(R&& reactor) {
+    return Sample(std::forward<R>(reactor));
+  }
+
+  template<typename R>
+  template<typename RF, typename>
+  Sample<R>::Sample(RF&& reactor)
+    : m_reactor(std::forward<RF>(reactor)),
+      m_has_evaluation(false) {}
+
+  template<typename R>
+  State Sample<R>::commit(int sequence) noexcept {
+    auto state = m_reactor.commit(sequence);
+    if(m_has_evaluation) {
+      if(is_complete(state)) {
+        return State::COMPLETE;
+      } else if(has_continuation(state)) {
+        return State::CONTINUE;
+      }
+      return State::NONE;
+    }
+    m_has_evaluation = has_evaluation(state);
+    return state;
+  }
+
+  template<typename R>
+  typename Sample<R>::Result Sample<R>::eval() const noexcept(is_noexcept) {
+    return m_reactor.eval();
+  }
+
+  template<typename R>
+  Error Sample<R>::get_error() const noexcept {
+    if constexpr(has_error_v<Reactor>) {
+      return m_reactor.get_error();
+    } else {
+      return Error();
+    }
+  }
+}
+
+#endif
@@ -1,8 +1,13 @@
 #ifndef ASPEN_SHARED_HPP
 #define ASPEN_SHARED_HPP
 #include <memory>
+#include <new>
+#include <optional>
 #include <utility>
+#include <variant>
+#include "Aspen/Batch.hpp"
 #include "Aspen/Box.hpp"
+#include "Aspen/SharedPolicy.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 #include "Aspen/Unique.hpp"
@@ -13,35 +18,164 @@ namespace Details {
     State m_state;
     int m_sequence;
     int m_last_evaluation;
+    bool m_is_batch;
 
     SharedState();
   };
 
-  template<typename R>
-  struct SharedEvaluator {
-    std::shared_ptr<SharedState> m_state;
-    std::weak_ptr<R> m_reactor;
+  /**
+   * Stores the reference counts and commit state of a Shared reactor. The
+   * block is released once both the Shared and Weak references are gone.
+   * @param <P> The policy used to count references.
+   */
+  template<SharedPolicy P>
+  struct SharedControl {
+    SharedCount<P> m_count;
+    SharedCount<P> m_weak_count;
+    SharedState m_local_state;
+    SharedState* m_state;
+    SharedControl* m_state_owner;
+
+    SharedControl(SharedControl* state_owner) noexcept;
+    SharedControl(const SharedControl&) = delete;
+    virtual ~SharedControl();
+    void release_weak() noexcept;
+    SharedControl& operator =(const SharedControl&) = delete;
+  };
+
+  template<typename R, SharedPolicy P>
+  struct SharedBlock : SharedControl<P> {
+    R* m_reactor;
     std::optional<try_maybe_t<reactor_result_t<R>,
       !is_noexcept_reactor_v<R>>> m_evaluation;
 
-    SharedEvaluator(std::shared_ptr<SharedState> state);
+    SharedBlock(SharedControl<P>* state_owner) noexcept;
+    void release() noexcept;
+    virtual void destroy() noexcept = 0;
   };
 
+  /** Stores the shared reactor in the same allocation as its block. */
+  template<typename R, SharedPolicy P>
+  struct InlineSharedBlock final : SharedBlock<R, P> {
+    alignas(R) unsigned char m_storage[sizeof(R)];
+
+    template<typename... A>
+    InlineSharedBlock(SharedControl<P>* state_owner, A&&... args);
+    void destroy() noexcept override;
+  };
+
+  /** Stores a shared reactor that was allocated by a Unique reactor. */
+  template<typename R, SharedPolicy P>
+  struct AdoptedSharedBlock final : SharedBlock<R, P> {
+    std::unique_ptr<R> m_adopted;
+
+    AdoptedSharedBlock(std::unique_ptr<R> reactor) noexcept;
+    void destroy() noexcept override;
+  };
+
+  /**
+   * Allocates a block and emplaces the shared reactor within it.
+   * @param state_owner The block whose state is shared, or
+   *        <code>nullptr</code> if the block has its own state.
+   * @param args The arguments used to emplace the shared reactor.
+   */
+  template<typename R, SharedPolicy P, typename... A>
+  SharedBlock<R, P>* make_shared_block(SharedControl<P>* state_owner,
+      A&&... args) {
+    return new InlineSharedBlock<R, P>(state_owner, std::forward<A>(args)...);
+  }
+
+  /**
+   * Allocates a block that takes ownership of an existing reactor.
+   * @param reactor The reactor to own.
+   */
+  template<SharedPolicy P, typename R>
+  SharedBlock<R, P>* adopt_shared_block(std::unique_ptr<R> reactor) {
+    return new AdoptedSharedBlock<R, P>(std::move(reactor));
+  }
+
   inline SharedState::SharedState()
     : m_state(State::NONE),
       m_sequence(-1),
-      m_last_evaluation(-1) {}
+      m_last_evaluation(-1),
+      m_is_batch(false) {}
+
+  template<SharedPolicy P>
+  SharedControl<P>::SharedControl(SharedControl* state_owner) noexcept
+      : m_state(&m_local_state),
+        m_state_owner(state_owner) {
+    if(m_state_owner) {
+      m_state_owner->m_weak_count.increment();
+      m_state = m_state_owner->m_state;
+    }
+  }
 
-  template<typename R>
-  SharedEvaluator<R>::SharedEvaluator(std::shared_ptr<SharedState> state)
-    : m_state(std::move(state)) {}
+  template<SharedPolicy P>
+  SharedControl<P>::~SharedControl() {
+    if(m_state_owner) {
+      m_state_owner->release_weak();
+    }
+  }
+
+  template<SharedPolicy P>
+  void SharedControl<P>::release_weak() noexcept {
+    if(m_weak_count.decrement()) {
+      delete this;
+    }
+  }
+
+  template<typename R, SharedPolicy P>
+  SharedBlock<R, P>::SharedBlock(SharedControl<P>* state_owner) noexcept
+    : SharedControl<P>(state_owner),
+      m_reactor(nullptr) {}
+
+  template<typename R, SharedPolicy P>
+  void SharedBlock<R, P>::release() noexcept {
+    if(!this->m_count.decrement()) {
+      return;
+    }
+    if(this->m_weak_count.get() != 1 &&
+        this->m_state->m_last_evaluation != -1) {
+      m_evaluation = try_eval(*m_reactor);
+    }
+    destroy();
+    this->release_weak();
+  }
+
+  template<typename R, SharedPolicy P>
+  template<typename... A>
+  InlineSharedBlock<R, P>::InlineSharedBlock(SharedControl<P>* state_owner,
+      A&&... args)
+      : SharedBlock<R, P>(state_owner) {
+    this->m_reactor = new(m_storage) R(std::forward<A>(args)...);
+  }
+
+  template<typename R, SharedPolicy P>
+  void InlineSharedBlock<R, P>::destroy() noexcept {
+    this->m_reactor->~R();
+  }
+
+  template<typename R, SharedPolicy P>
+  AdoptedSharedBlock<R, P>::AdoptedSharedBlock(
+      std::unique_ptr<R> reactor) noexcept
+      : SharedBlock<R, P>(nullptr),
+        m_adopted(std::move(reactor)) {
+    this->m_reactor = m_adopted.get();
+  }
+
+  template<typename R, SharedPolicy P>
+  void AdoptedSharedBlock<R, P>::destroy() noexcept {
+    m_adopted.reset();
+  }
 }
 
   /**
-   * Used to share a reactor as a child among multiple reactors.
+   * Used to share a reactor as a child among multiple reactors. The reactor,
+   * its reference counts and its commit state live in a single allocation.
    * @param <R> The type of reactor being shared.
+   * @param <P> The policy used to count references.
    */
-  template<typename R>
+  template<typename R, SharedPolicy P = SharedPolicy::ATOMIC>
   class Shared {
     public:
       using Reactor = R;
@@ -49,6 +183,9 @@ namespace Details {
       using Result = decltype(std::declval<Reactor>().eval());
       static constexpr auto is_noexcept = is_noexcept_reactor_v<Reactor>;
 
+      /** The policy used to count references. */
+      static constexpr auto POLICY = P;
+
       /** Constructs a Shared reactor. */
       Shared();
 
@@ -79,11 +216,11 @@ namespace Details {
        * @param reactor The reactor to share ownership with.
        */
       template<typename U>
-      Shared(Shared<U> reactor);
+      Shared(Shared<U, P> reactor);
 
       Shared(const Shared& shared) noexcept;
 
-      Shared(Shared&& shared) = default;
+      Shared(Shared&& shared) noexcept;
 
       ~Shared();
 
@@ -103,27 +240,57 @@ namespace Details {
 
       Result eval() const noexcept(is_noexcept);
 
+      /** Returns the error the shared reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
+      /**
+       * Commits the shared reactor through its batch protocol. If another
+       * reference last evaluated it without batching, the batch consists of
+       * that single evaluation. References that commit without batching see
+       * the last value of a batch. Only available if the shared reactor is
+       * batch-aware.
+       * @param sequence The commit's sequence.
+       */
+      template<bool B = is_batch_reactor_v<Reactor>,
+        typename = std::enable_if_t<B>>
+      State commit_batch(int sequence) noexcept;
+
+      /** Returns the values evaluated by the last call to commit_batch. */
+      template<bool B = is_batch_reactor_v<Reactor>,
+        typename = std::enable_if_t<B>>
+      Batch<Type> eval_batch() const;
+
       Shared& operator =(const Shared& shared) noexcept;
 
-      Shared& operator =(Shared&& shared) = default;
+      Shared& operator =(Shared&& shared) noexcept;
 
     private:
-      template<typename> friend class Shared;
-      template<typename> friend class Weak;
-      std::shared_ptr<Details::SharedEvaluator<Reactor>> m_evaluator;
-      std::shared_ptr<Reactor> m_reactor;
+      template<typename, SharedPolicy> friend class Shared;
+      template<typename, SharedPolicy> friend class Weak;
+      Details::SharedBlock<Reactor, P>* m_block;
       int m_last_evaluation;
-
-      Shared(std::shared_ptr<Details::SharedEvaluator<Reactor>> evaluator,
-        std::shared_ptr<Reactor> reactor);
-      static State commit_state(int sequence, Reactor& reactor,
-        Details::SharedEvaluator<Reactor>& evaluator, int& last_evaluation);
+      std::conditional_t<is_batch_reactor_v<Reactor>,
+        std::optional<Maybe<Type>>, std::monostate> m_sample;
+
+      Shared(Details::SharedBlock<Reactor, P>* block) noexcept;
+      static State commit_state(int sequence,
+        Details::SharedBlock<Reactor, P>& block, int& last_evaluation);
+      static State commit_state(int sequence,
+        Details::SharedBlock<Reactor, P>& block, int& last_evaluation,
+        bool is_batch);
   };
 
   /** Type alias for a Shared<Box<T>>. */
   template<typename T>
   using SharedBox = Shared<Box<T>>;
 
+  /**
+   * Type alias for a Shared reactor whose references are confined to a
+   * single thread.
+   */
+  template<typename R>
+  using LocalShared = Shared<R, SharedPolicy::LOCAL>;
+
   /**
    * Boxes a reactor into a copyable generic interface.
    * @param reactor The reactor to wrap.
@@ -133,6 +300,15 @@ namespace Details {
     return SharedBox<reactor_result_t<R>>(std::forward<R>(reactor));
   }
 
+  /**
+   * Shares a reactor whose references are confined to a single thread.
+   * @param reactor The reactor to share.
+   */
+  template<typename R>
+  auto local_shared(R&& reactor) {
+    return LocalShared<to_reactor_t<R>>(std::forward<R>(reactor));
+  }
+
   /**
    * A type trait that provides the type Shared<T> if T is not already wrapped
    * in a Shared, otherwise provides the type T.
@@ -142,9 +318,14 @@ namespace Details {
     using type = Shared<T>;
   };
 
-  template<typename T>
-  struct collapse_shared<Shared<T>> {
-    using type = typename collapse_shared<T>::type;
+  template<typename T, SharedPolicy P>
+  struct collapse_shared<Shared<T, P>> {
+    using type = Shared<T, P>;
+  };
+
+  template<typename T, SharedPolicy P, SharedPolicy Q>
+  struct collapse_shared<Shared<Shared<T, P>, Q>> {
+    using type = typename collapse_shared<Shared<T, P>>::type;
   };
 
   template<typename T>
@@ -154,130 +335,187 @@ namespace Details {
     !std::is_base_of_v<Shared<to_reactor_t<A>>, std::decay_t<A>>>>
   Shared(A&&) -> Shared<to_reactor_t<A>>;
 
-  template<typename R>
-  Shared<R>::Shared()
-    : Shared(std::make_shared<Details::SharedEvaluator<Reactor>>(
-        std::make_shared<Details::SharedState>()),
-        std::make_shared<Reactor>()) {
-    m_evaluator->m_reactor = m_reactor;
-  }
+  template<typename R, SharedPolicy P>
+  Shared<R, P>::Shared()
+    : Shared(Details::make_shared_block<Reactor, P>(nullptr)) {}
 
-  template<typename R>
+  template<typename R, SharedPolicy P>
   template<typename A, typename>
-  Shared<R>::Shared(A&& args)
-    : Shared(std::make_shared<Details::SharedEvaluator<Reactor>>(
-        std::make_shared<Details::SharedState>()),
-        std::make_shared<Reactor>(std::forward<A>(args))) {
-    m_evaluator->m_reactor = m_reactor;
-  }
+  Shared<R, P>::Shared(A&& args)
+    : Shared(Details::make_shared_block<Reactor, P>(nullptr,
+        std::forward<A>(args))) {}
 
-  template<typename R>
+  template<typename R, SharedPolicy P>
   template<typename A, typename... B, typename>
-  Shared<R>::Shared(A&& a, B&&... args)
-    : Shared(std::make_shared<Details::SharedEvaluator<Reactor>>(
-        std::make_shared<Details::SharedState>()),
-        std::make_shared<Reactor>(std::forward<A>(a),
-        std::forward<B>(args)...)) {
-    m_evaluator->m_reactor = m_reactor;
-  }
+  Shared<R, P>::Shared(A&& a, B&&... args)
+    : Shared(Details::make_shared_block<Reactor, P>(nullptr,
+        std::forward<A>(a), std::forward<B>(args)...)) {}
 
-  template<typename R>
-  Shared<R>::Shared(Unique<Reactor> reactor)
-    : Shared(std::make_shared<Details::SharedEvaluator<Reactor>>(
-        std::make_shared<Details::SharedState>()),
-        std::shared_ptr<Reactor>(std::move(reactor.m_reactor))) {
-    m_evaluator->m_reactor = m_reactor;
-  }
+  template<typename R, SharedPolicy P>
+  Shared<R, P>::Shared(Unique<Reactor> reactor)
+    : Shared(Details::adopt_shared_block<P>(std::move(reactor.m_reactor))) {}
 
-  template<typename R>
+  template<typename R, SharedPolicy P>
   template<typename U>
-  Shared<R>::Shared(Shared<U> reactor)
-    : Shared(std::make_shared<Details::SharedEvaluator<Reactor>>(
-        reactor.m_evaluator->m_state), std::make_shared<Reactor>(reactor)) {
-    m_evaluator->m_reactor = m_reactor;
+  Shared<R, P>::Shared(Shared<U, P> reactor)
+    : Shared(Details::make_shared_block<Reactor, P>(reactor.m_block,
+        std::move(reactor))) {}
+
+  template<typename R, SharedPolicy P>
+  Shared<R, P>::Shared(const Shared& shared) noexcept
+      : Shared(shared.m_block) {
+    if(m_block) {
+      m_block->m_count.increment();
+    }
   }
 
-  template<typename R>
-  Shared<R>::Shared(const Shared& shared) noexcept
-    : Shared(shared.m_evaluator, shared.m_reactor) {}
+  template<typename R, SharedPolicy P>
+  Shared<R, P>::Shared(Shared&& shared) noexcept
+      : m_block(shared.m_block),
+        m_last_evaluation(shared.m_last_evaluation),
+        m_sample(std::move(shared.m_sample)) {
+    shared.m_block = nullptr;
+  }
 
-  template<typename R>
-  Shared<R>::~Shared() {
-    if(m_reactor.unique() && m_evaluator->m_state->m_last_evaluation != -1) {
-      m_evaluator->m_evaluation = try_eval(*m_reactor);
+  template<typename R, SharedPolicy P>
+  Shared<R, P>::~Shared() {
+    if(m_block) {
+      m_block->release();
     }
   }
 
-  template<typename R>
-  const typename Shared<R>::Reactor& Shared<R>::operator *() const noexcept {
-    return *m_reactor;
+  template<typename R, SharedPolicy P>
+  const typename Shared<R, P>::Reactor& Shared<R, P>::operator *() const
+      noexcept {
+    return *m_block->m_reactor;
   }
 
-  template<typename R>
-  const typename Shared<R>::Reactor* Shared<R>::operator ->() const noexcept {
-    return &*m_reactor;
+  template<typename R, SharedPolicy P>
+  const typename Shared<R, P>::Reactor* Shared<R, P>::operator ->() const
+      noexcept {
+    return m_block->m_reactor;
   }
 
-  template<typename R>
-  typename Shared<R>::Reactor& Shared<R>::operator *() noexcept {
-    return *m_reactor;
+  template<typename R, SharedPolicy P>
+  typename Shared<R, P>::Reactor& Shared<R, P>::operator *() noexcept {
+    return *m_block->m_reactor;
   }
 
-  template<typename R>
-  typename Shared<R>::Reactor* Shared<R>::operator ->() noexcept {
-    return &*m_reactor;
+  template<typename R, SharedPolicy P>
+  typename Shared<R, P>::Reactor* Shared<R, P>::operator ->() noexcept {
+    return m_block->m_reactor;
   }
 
-  template<typename R>
-  State Shared<R>::commit(int sequence) noexcept {
-    return commit_state(sequence, *m_reactor, *m_evaluator, m_last_evaluation);
+  template<typename R, SharedPolicy P>
+  State Shared<R, P>::commit(int sequence) noexcept {
+    return commit_state(sequence, *m_block, m_last_evaluation);
   }
 
-  template<typename R>
-  typename Shared<R>::Result Shared<R>::eval() const noexcept(is_noexcept) {
-    return m_reactor->eval();
+  template<typename R, SharedPolicy P>
+  typename Shared<R, P>::Result Shared<R, P>::eval() const
+      noexcept(is_noexcept) {
+    return m_block->m_reactor->eval();
   }
 
-  template<typename R>
-  Shared<R>& Shared<R>::operator =(const Shared& shared) noexcept {
-    m_evaluator = shared.m_evaluator;
-    m_reactor = shared.m_reactor;
+  template<typename R, SharedPolicy P>
+  Error Shared<R, P>::get_error() const noexcept {
+    if constexpr(has_error_v<Reactor>) {
+      return m_block->m_reactor->get_error();
+    } else {
+      return Error();
+    }
+  }
+
+  template<typename R, SharedPolicy P>
+  template<bool B, typename>
+  State Shared<R, P>::commit_batch(int sequence) noexcept {
+    auto state = commit_state(sequence, *m_block, m_last_evaluation, true);
+    if(has_evaluation(state)) {
+      if(m_block->m_state->m_is_batch) {
+        m_sample.reset();
+      } else {
+        m_sample = try_eval_maybe(*m_block->m_reactor);
+      }
+    }
+    return state;
+  }
+
+  template<typename R, SharedPolicy P>
+  template<bool B, typename>
+  Batch<typename Shared<R, P>::Type> Shared<R, P>::eval_batch() const {
+    if(m_sample.has_value()) {
+      return Batch<Type>(&*m_sample, 1);
+    }
+    return m_block->m_reactor->eval_batch();
+  }
+
+  template<typename R, SharedPolicy P>
+  Shared<R, P>& Shared<R, P>::operator =(const Shared& shared) noexcept {
+    if(shared.m_block) {
+      shared.m_block->m_count.increment();
+    }
+    if(m_block) {
+      m_block->release();
+    }
+    m_block = shared.m_block;
     m_last_evaluation = -1;
     return *this;
   }
 
-  template<typename R>
-  Shared<R>::Shared(
-    std::shared_ptr<Details::SharedEvaluator<Reactor>> evaluator,
-    std::shared_ptr<Reactor> reactor)
-    : m_evaluator(std::move(evaluator)),
-      m_reactor(std::move(reactor)),
+  template<typename R, SharedPolicy P>
+  Shared<R, P>& Shared<R, P>::operator =(Shared&& shared) noexcept {
+    std::swap(m_block, shared.m_block);
+    m_last_evaluation = shared.m_last_evaluation;
+    m_sample = std::move(shared.m_sample);
+    return *this;
+  }
+
+  template<typename R, SharedPolicy P>
+  Shared<R, P>::Shared(Details::SharedBlock<Reactor, P>* block) noexcept
+    : m_block(block),
       m_last_evaluation(-1) {}
 
-  template<typename R>
-  State Shared<R>::commit_state(int sequence, Reactor& reactor,
-      Details::SharedEvaluator<Reactor>& evaluator, int& last_evaluation) {
-    if(sequence <= evaluator.m_state->m_sequence) {
-      if(last_evaluation < evaluator.m_state->m_last_evaluation) {
-        last_evaluation = evaluator.m_state->m_last_evaluation;
-        return combine(evaluator.m_state->m_state, State::EVALUATED);
+  template<typename R, SharedPolicy P>
+  State Shared<R, P>::commit_state(int sequence,
+      Details::SharedBlock<Reactor, P>& block, int& last_evaluation) {
+    return commit_state(sequence, block, last_evaluation, false);
+  }
+
+  template<typename R, SharedPolicy P>
+  State Shared<R, P>::commit_state(int sequence,
+      Details::SharedBlock<Reactor, P>& block, int& last_evaluation,
+      bool is_batch) {
+    auto& state = *block.m_state;
+    if(sequence <= state.m_sequence) {
+      if(last_evaluation < state.m_last_evaluation) {
+        last_evaluation = state.m_last_evaluation;
+        return combine(state.m_state, State::EVALUATED);
       }
-      return evaluator.m_state->m_state;
+      return state.m_state;
     }
-    auto reactor_state = reactor.commit(sequence);
-    if(sequence == evaluator.m_state->m_sequence) {
-      if(last_evaluation < evaluator.m_state->m_last_evaluation) {
-        last_evaluation = evaluator.m_state->m_last_evaluation;
+    auto& reactor = *block.m_reactor;
+    auto reactor_state = [&] {
+      if constexpr(is_batch_reactor_v<Reactor>) {
+        if(is_batch) {
+          return reactor.commit_batch(sequence);
+        }
+      }
+      return reactor.commit(sequence);
+    }();
+    if(sequence == state.m_sequence) {
+      if(last_evaluation < state.m_last_evaluation) {
+        last_evaluation = state.m_last_evaluation;
         reactor_state = combine(reactor_state, State::EVALUATED);
       }
     } else {
-      evaluator.m_state->m_state = reactor_state;
-      evaluator.m_state->m_sequence = sequence;
+      state.m_state = reactor_state;
+      state.m_sequence = sequence;
       if(has_evaluation(reactor_state)) {
-        evaluator.m_state->m_last_evaluation = sequence;
+        state.m_is_batch = is_batch;
+        state.m_last_evaluation = sequence;
         last_evaluation = sequence;
-      } else if(last_evaluation < evaluator.m_state->m_last_evaluation) {
-        last_evaluation = evaluator.m_state->m_last_evaluation;
+      } else if(last_evaluation < state.m_last_evaluation) {
+        last_evaluation = state.m_last_evaluation;
         reactor_state = combine(reactor_state, State::EVALUATED);
       }
     }
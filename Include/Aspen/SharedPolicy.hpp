@@ -0,0 +1,129 @@
+#ifndef ASPEN_SHARED_POLICY_HPP
+#define ASPEN_SHARED_POLICY_HPP
+#include <atomic>
+
+namespace Aspen {
+
+  /** Specifies how a Shared reactor counts its references. */
+  enum class SharedPolicy {
+
+    /** References may be copied and released from any thread. */
+    ATOMIC,
+
+    /**
+     * References are copied and released from a single thread, avoiding
+     * atomic operations.
+     */
+    LOCAL
+  };
+
+namespace Details {
+
+  /**
+   * Stores a reference count.
+   * @param <P> The policy used to update the count.
+   */
+  template<SharedPolicy P>
+  class SharedCount {
+    public:
+
+      /** Constructs a SharedCount with a count of one. */
+      SharedCount() noexcept;
+
+      /** Returns the current count. */
+      int get() const noexcept;
+
+      /** Increments the count. */
+      void increment() noexcept;
+
+      /**
+       * Increments the count unless it's zero.
+       * @return <code>true</code> iff the count was incremented.
+       */
+      bool increment_if_nonzero() noexcept;
+
+      /**
+       * Decrements the count.
+       * @return <code>true</code> iff the count reached zero.
+       */
+      bool decrement() noexcept;
+
+    private:
+      int m_count;
+  };
+
+  template<>
+  class SharedCount<SharedPolicy::ATOMIC> {
+    public:
+      SharedCount() noexcept;
+
+      int get() const noexcept;
+
+      void increment() noexcept;
+
+      bool increment_if_nonzero() noexcept;
+
+      bool decrement() noexcept;
+
+    private:
+      std::atomic_int m_count;
+  };
+
+  template<SharedPolicy P>
+  SharedCount<P>::SharedCount() noexcept
+    : m_count(1) {}
+
+  template<SharedPolicy P>
+  int SharedCount<P>::get() const noexcept {
+    return m_count;
+  }
+
+  template<SharedPolicy P>
+  void SharedCount<P>::increment() noexcept {
+    ++m_count;
+  }
+
+  template<SharedPolicy P>
+  bool SharedCount<P>::increment_if_nonzero() noexcept {
+    if(m_count == 0) {
+      return false;
+    }
+    ++m_count;
+    return true;
+  }
+
+  template<SharedPolicy P>
+  bool SharedCount<P>::decrement() noexcept {
+    return --m_count == 0;
+  }
+
+  inline SharedCount<SharedPolicy::ATOMIC>::SharedCount() noexcept
+    : m_count(1) {}
+
+  inline int SharedCount<SharedPolicy::ATOMIC>::get() const noexcept {
+    return m_count.load(std::memory_order_acquire);
+  }
+
+  inline void SharedCount<SharedPolicy::ATOMIC>::increment() noexcept {
+    m_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  inline bool SharedCount<SharedPolicy::ATOMIC>::increment_if_nonzero()
+      noexcept {
+    auto count = m_count.load(std::memory_order_relaxed);
+    while(count != 0) {
+      if(m_count.compare_exchange_weak(count, count + 1,
+          std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  inline bool SharedCount<SharedPolicy::ATOMIC>::decrement() noexcept {
+    return m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+}
+}
+
+#endif
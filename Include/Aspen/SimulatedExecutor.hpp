@@ -0,0 +1,215 @@
+#ifndef ASPEN_SIMULATED_EXECUTOR_HPP
+#define ASPEN_SIMULATED_EXECUTOR_HPP
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "Aspen/Box.hpp"
+#include "Aspen/ExecutorStatistics.hpp"
+#include "Aspen/TimerWheel.hpp"
+#include "Aspen/Trigger.hpp"
+
+namespace Aspen {
+
+  /**
+   * Runs a single reactor against a virtual clock, advancing time directly to
+   * the next scheduled event or timer instead of waiting for it. Events
+   * scheduled for the same time run in the order they were scheduled, so a
+   * simulation is fully reproducible. All sources must be driven from the
+   * executor's thread, typically by scheduled events.
+   */
+  class SimulatedExecutor {
+    public:
+
+      /** The type used to represent a point in virtual time. */
+      using TimePoint = TimerWheel::TimePoint;
+
+      /** The type used to represent a duration of virtual time. */
+      using Duration = TimerWheel::Duration;
+
+      /**
+       * Constructs a SimulatedExecutor starting at the clock's epoch with a
+       * timer resolution of one microsecond.
+       * @param reactor The reactor to execute.
+       */
+      template<typename R>
+      explicit SimulatedExecutor(R&& reactor);
+
+      /**
+       * Constructs a SimulatedExecutor.
+       * @param reactor The reactor to execute.
+       * @param start The initial virtual time.
+       * @param resolution The resolution of timers committed by the reactor.
+       */
+      template<typename R>
+      SimulatedExecutor(R&& reactor, TimePoint start, Duration resolution);
+
+      /** Returns the current virtual time. */
+      TimePoint get_time() const noexcept;
+
+      /**
+       * Schedules a callback to run once virtual time reaches a given point.
+       * Callbacks scheduled in the past run at the current time.
+       * @param time The time at which to run the callback.
+       * @param callback The callback to run.
+       */
+      template<typename F>
+      void schedule(TimePoint time, F&& callback);
+
+      /**
+       * Repeatedly executes the reactor until it completes or evaluates to
+       * NONE, without advancing virtual time.
+       */
+      void run_until_none();
+
+      /**
+       * Repeatedly executes the reactor, advancing virtual time whenever it
+       * has nothing left to do, until it completes or no events or timers
+       * remain.
+       */
+      void run_until_complete();
+
+      /**
+       * Returns a snapshot of the work this executor has performed. Commit
+       * times are measured in real time, idle time is the virtual time
+       * skipped while waiting for the next event or timer.
+       */
+      ExecutorStatistics get_statistics() const noexcept;
+
+    private:
+      struct Event {
+        TimePoint m_time;
+        std::uint64_t m_sequence;
+        std::function<void ()> m_callback;
+      };
+      struct EventComparator {
+        bool operator ()(const Event& left, const Event& right) const noexcept;
+      };
+      TimePoint m_time;
+      std::uint64_t m_next_event;
+      std::vector<Event> m_events;
+      bool m_has_update;
+      Trigger m_trigger;
+      int m_sequence;
+      TimerWheel m_timers;
+      Box<void> m_reactor;
+      Details::StatisticsRecorder m_statistics;
+
+      SimulatedExecutor(const SimulatedExecutor&) = delete;
+      SimulatedExecutor& operator =(const SimulatedExecutor&) = delete;
+      bool step();
+  };
+
+  template<typename R>
+  SimulatedExecutor::SimulatedExecutor(R&& reactor)
+    : SimulatedExecutor(std::forward<R>(reactor), TimePoint(),
+        std::chrono::microseconds(1)) {}
+
+  template<typename R>
+  SimulatedExecutor::SimulatedExecutor(R&& reactor, TimePoint start,
+    Duration resolution)
+    : m_time(start),
+      m_next_event(0),
+      m_has_update(false),
+      m_trigger([=] { m_has_update = true; }),
+      m_sequence(0),
+      m_timers(start, resolution),
+      m_reactor(std::forward<R>(reactor)) {}
+
+  inline SimulatedExecutor::TimePoint
+      SimulatedExecutor::get_time() const noexcept {
+    return m_time;
+  }
+
+  template<typename F>
+  void SimulatedExecutor::schedule(TimePoint time, F&& callback) {
+    m_events.push_back(Event{std::max(time, m_time), m_next_event,
+      std::forward<F>(callback)});
+    std::push_heap(m_events.begin(), m_events.end(), EventComparator());
+    ++m_next_event;
+  }
+
+  inline void SimulatedExecutor::run_until_none() {
+    auto old_trigger = Trigger::get_trigger();
+    auto old_wheel = TimerWheel::get_wheel();
+    Trigger::set_trigger(m_trigger);
+    TimerWheel::set_wheel(&m_timers);
+    while(true) {
+      m_has_update = false;
+      auto start = Details::StatisticsRecorder::Clock::now();
+      auto state = m_reactor.commit(m_sequence);
+      ++m_sequence;
+      m_statistics.record_commit(state,
+        Details::StatisticsRecorder::Clock::now() - start);
+      if(!has_continuation(state)) {
+        break;
+      }
+    }
+    TimerWheel::set_wheel(old_wheel);
+    Trigger::set_trigger(old_trigger);
+  }
+
+  inline void SimulatedExecutor::run_until_complete() {
+    auto old_trigger = Trigger::get_trigger();
+    auto old_wheel = TimerWheel::get_wheel();
+    Trigger::set_trigger(m_trigger);
+    TimerWheel::set_wheel(&m_timers);
+    while(true) {
+      m_has_update = false;
+      auto start = Details::StatisticsRecorder::Clock::now();
+      auto state = m_reactor.commit(m_sequence);
+      ++m_sequence;
+      m_statistics.record_commit(state,
+        Details::StatisticsRecorder::Clock::now() - start);
+      if(is_complete(state)) {
+        break;
+      } else if(has_continuation(state)) {
+        continue;
+      }
+      auto idle_start = m_time;
+      while(!m_has_update && step()) {}
+      if(!m_has_update) {
+        break;
+      }
+      m_statistics.record_wakeup(m_time - idle_start);
+    }
+    TimerWheel::set_wheel(old_wheel);
+    Trigger::set_trigger(old_trigger);
+  }
+
+  inline ExecutorStatistics SimulatedExecutor::get_statistics() const
+      noexcept {
+    return m_statistics.load();
+  }
+
+  inline bool SimulatedExecutor::EventComparator::operator ()(
+      const Event& left, const Event& right) const noexcept {
+    if(left.m_time != right.m_time) {
+      return left.m_time > right.m_time;
+    }
+    return left.m_sequence > right.m_sequence;
+  }
+
+  inline bool SimulatedExecutor::step() {
+    auto timer = m_timers.get_next_deadline();
+    if(m_events.empty() && !timer) {
+      return false;
+    }
+    if(timer && (m_events.empty() || *timer <= m_events.front().m_time)) {
+      m_time = std::max(m_time, *timer);
+      m_timers.advance(*timer);
+      return true;
+    }
+    std::pop_heap(m_events.begin(), m_events.end(), EventComparator());
+    auto event = std::move(m_events.back());
+    m_events.pop_back();
+    m_time = event.m_time;
+    m_timers.advance(m_time);
+    event.m_callback();
+    return true;
+  }
+}
+
+#endif
@@ -1,15 +1,60 @@
 #ifndef ASPEN_STATIC_COMMIT_HANDLER_HPP
 #define ASPEN_STATIC_COMMIT_HANDLER_HPP
+#include <bitset>
 #include <functional>
 #include <optional>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include "Aspen/Batch.hpp"
+#include "Aspen/Constant.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
 namespace Aspen {
+  template<typename... R> class ParallelStaticCommitHandler;
+
 namespace Details {
+
+  /**
+   * Stores a child reactor along with the bookkeeping needed to aggregate
+   * its commits.
+   * @param <R> The type of reactor stored.
+   */
+  template<typename R>
+  struct StaticChild {
+    R m_reactor;
+    State m_state;
+    bool m_has_evaluation;
+
+    template<typename RF>
+    StaticChild(RF&& reactor);
+  };
+
+  /**
+   * Stores a Constant child, which never needs to be committed since it's
+   * always complete and evaluated.
+   */
+  template<typename T>
+  struct StaticChild<Constant<T>> {
+    Constant<T> m_reactor;
+
+    template<typename RF>
+    StaticChild(RF&& reactor);
+  };
+
+  template<typename R>
+  template<typename RF>
+  StaticChild<R>::StaticChild(RF&& reactor)
+    : m_reactor(std::forward<RF>(reactor)),
+      m_state(State::NONE),
+      m_has_evaluation(false) {}
+
+  template<typename T>
+  template<typename RF>
+  StaticChild<Constant<T>>::StaticChild(RF&& reactor)
+    : m_reactor(std::forward<RF>(reactor)) {}
+
   template<typename F, typename H, std::size_t... I>
   decltype(auto) apply_impl(F&& f, const H& handler,
       std::index_sequence<I...>) {
@@ -57,6 +102,27 @@ namespace Details {
        */
       State commit(int sequence) noexcept;
 
+      /**
+       * Commits all children, allowing batch-aware children to evaluate to a
+       * batch, and returns their aggregate State.
+       * @param sequence The commit's sequence.
+       * @return The aggregate State of all children.
+       */
+      State commit_batch(int sequence) noexcept;
+
+      /**
+       * Returns a mask of the children that evaluated during the last commit.
+       * Constant children are never included.
+       */
+      std::bitset<sizeof...(R)> get_evaluations() const noexcept;
+
+      /**
+       * Returns the State the reactor at the specified index reported on its
+       * last commit. Constant children are always COMPLETE_EVALUATED.
+       */
+      template<std::size_t I>
+      State get_state() const noexcept;
+
       /** Returns the reactor at the specified index. */
       template<std::size_t I>
       const std::tuple_element_t<I, std::tuple<R...>>& get() const noexcept;
@@ -72,20 +138,12 @@ namespace Details {
       StaticCommitHandler& operator =(StaticCommitHandler&&) = default;
 
     private:
-      template<typename C>
-      struct Child {
-        C m_reactor;
-        State m_state;
-        bool m_has_evaluation;
-
-        template<typename CF>
-        Child(CF&& reactor);
-      };
-      std::tuple<Child<R>...> m_children;
+      template<typename...> friend class ParallelStaticCommitHandler;
+      std::tuple<Details::StaticChild<R>...> m_children;
       bool m_is_initializing;
 
-      template<typename CF>
-      static auto make_child(CF&& reactor);
+      template<typename C>
+      State commit(int sequence, C&& committer) noexcept;
   };
 
   /** Applies a callable on every reactor represented by a
@@ -120,14 +178,6 @@ namespace Details {
   StaticCommitHandler(A1&&, A2&&) -> StaticCommitHandler<std::decay_t<A1>,
     std::decay_t<A2>>;
 
-  template<typename... R>
-  template<typename C>
-  template<typename CF>
-  StaticCommitHandler<R...>::Child<C>::Child(CF&& reactor)
-    : m_reactor(std::forward<CF>(reactor)),
-      m_state(State::NONE),
-      m_has_evaluation(false) {}
-
   template<typename... R>
   StaticCommitHandler<R...>::StaticCommitHandler(const R&... children)
     : m_children(children...),
@@ -141,6 +191,22 @@ namespace Details {
 
   template<typename... R>
   State StaticCommitHandler<R...>::commit(int sequence) noexcept {
+    return commit(sequence, [] (auto& reactor, int sequence) noexcept {
+      return reactor.commit(sequence);
+    });
+  }
+
+  template<typename... R>
+  State StaticCommitHandler<R...>::commit_batch(int sequence) noexcept {
+    return commit(sequence, [] (auto& reactor, int sequence) noexcept {
+      return Aspen::commit_batch(reactor, sequence);
+    });
+  }
+
+  template<typename... R>
+  template<typename C>
+  State StaticCommitHandler<R...>::commit(int sequence, C&& committer)
+      noexcept {
     if(sizeof...(R) == 0) {
       return State::COMPLETE;
     }
@@ -152,13 +218,20 @@ namespace Details {
       if(state == State::COMPLETE) {
         return;
       }
-      if(is_complete(child.m_state)) {
+      if constexpr(is_constant_v<
+          std::decay_t<decltype(child.m_reactor)>>) {
+        ++completion_count;
+        if(m_is_initializing) {
+          ++evaluation_count;
+        }
+      } else if(is_complete(child.m_state)) {
+        child.m_state = State::COMPLETE;
         ++completion_count;
         if(m_is_initializing && child.m_has_evaluation) {
           ++evaluation_count;
         }
       } else {
-        child.m_state = child.m_reactor.commit(sequence);
+        child.m_state = committer(child.m_reactor, sequence);
         if(m_is_initializing) {
           child.m_has_evaluation |= has_evaluation(child.m_state);
           if(child.m_has_evaluation) {
@@ -196,6 +269,31 @@ namespace Details {
     return state;
   }
 
+  template<typename... R>
+  std::bitset<sizeof...(R)> StaticCommitHandler<R...>::get_evaluations()
+      const noexcept {
+    auto evaluations = std::bitset<sizeof...(R)>();
+    for_each<0, sizeof...(R)>([&] (auto index) {
+      constexpr auto I = decltype(index)::value;
+      auto& child = std::get<I>(m_children);
+      if constexpr(!is_constant_v<std::decay_t<decltype(child.m_reactor)>>) {
+        evaluations[I] = has_evaluation(child.m_state);
+      }
+    });
+    return evaluations;
+  }
+
+  template<typename... R>
+  template<std::size_t I>
+  State StaticCommitHandler<R...>::get_state() const noexcept {
+    auto& child = std::get<I>(m_children);
+    if constexpr(is_constant_v<std::decay_t<decltype(child.m_reactor)>>) {
+      return State::COMPLETE_EVALUATED;
+    } else {
+      return child.m_state;
+    }
+  }
+
   template<typename... R>
   template<std::size_t I>
   std::tuple_element_t<I, std::tuple<R...>>&
@@ -209,12 +307,6 @@ namespace Details {
       StaticCommitHandler<R...>::get() const noexcept {
     return std::get<I>(m_children).m_reactor;
   }
-
-  template<typename... R>
-  template<typename CF>
-  auto StaticCommitHandler<R...>::make_child(CF&& reactor) {
-    return Child<std::decay_t<CF>>(std::forward<CF>(reactor));
-  }
 }
 
 #endif
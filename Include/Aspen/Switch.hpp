@@ -3,6 +3,7 @@
 #include <optional>
 #include <type_traits>
 #include <utility>
+#include "Aspen/Error.hpp"
 #include "Aspen/Maybe.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
@@ -37,6 +38,9 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const noexcept(is_noexcept);
 
+      /** Returns the error this reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       T m_toggle;
       S m_series;
@@ -71,12 +75,19 @@ namespace Aspen {
     auto toggle_state = m_toggle.commit(sequence);
     auto flipped = !m_is_on;
     if(has_evaluation(toggle_state)) {
-      try {
-        m_is_on = m_toggle.eval();
-      } catch(...) {
+      if(auto error = eval_error(m_toggle)) {
         m_is_on = false;
         if constexpr(!is_noexcept) {
-          m_value = std::current_exception();
+          m_value = std::move(error);
+        }
+      } else {
+        ASPEN_TRY {
+          m_is_on = m_toggle.eval();
+        } ASPEN_CATCH(...) {
+          m_is_on = false;
+          if constexpr(!is_noexcept) {
+            m_value = current_error();
+          }
         }
       }
     }
@@ -103,6 +114,15 @@ namespace Aspen {
       const noexcept(is_noexcept) {
     return *m_value;
   }
+
+  template<typename T, typename S>
+  Error Switch<T, S>::get_error() const noexcept {
+    if constexpr(is_noexcept) {
+      return Error();
+    } else {
+      return m_value.get_exception();
+    }
+  }
 }
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef ASPEN_SYNC_HPP
 #define ASPEN_SYNC_HPP
 #include <exception>
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -8,7 +9,7 @@ namespace Aspen {
 namespace Details {
   struct Empty {};
   struct Exception {
-    std::exception_ptr m_exception;
+    Error m_exception;
   };
 }
 
@@ -37,6 +38,9 @@ namespace Details {
 
       const Type& eval() const noexcept(is_noexcept);
 
+      /** Returns the error the reactor last evaluated to, if any. */
+      Error get_error() const noexcept;
+
     private:
       Type* m_value;
       Reactor m_reactor;
@@ -53,12 +57,14 @@ namespace Details {
     if(has_evaluation(state)) {
       if constexpr(is_noexcept) {
         *m_value = m_reactor.eval();
+      } else if(auto error = eval_error(m_reactor)) {
+        this->m_exception = std::move(error);
       } else {
-        try {
+        ASPEN_TRY {
           *m_value = m_reactor.eval();
-          this->m_exception = nullptr;
-        } catch(...) {
-          this->m_exception = std::current_exception();
+          this->m_exception = Error();
+        } ASPEN_CATCH(...) {
+          this->m_exception = current_error();
         }
       }
     }
@@ -70,11 +76,20 @@ namespace Details {
       noexcept(is_noexcept) {
     if constexpr(!is_noexcept) {
       if(this->m_exception) {
-        std::rethrow_exception(this->m_exception);
+        raise(this->m_exception);
       }
     }
     return *m_value;
   }
+
+  template<typename R, typename V>
+  Error Sync<R, V>::get_error() const noexcept {
+    if constexpr(is_noexcept) {
+      return Error();
+    } else {
+      return this->m_exception;
+    }
+  }
 }
 
 #endif
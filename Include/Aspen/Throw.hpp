@@ -3,6 +3,7 @@
 #include <exception>
 #include <type_traits>
 #include <utility>
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -21,7 +22,7 @@ namespace Aspen {
        * Constructs a Throw.
        * @param exception The exception to throw.
        */
-      explicit Throw(std::exception_ptr exception);
+      explicit Throw(Error exception);
 
       /**
        * Constructs a Throw.
@@ -34,8 +35,11 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const;
 
+      /** Returns the error this reactor evaluates to. */
+      Error get_error() const noexcept;
+
     private:
-      std::exception_ptr m_exception;
+      Error m_exception;
   };
 
   /**
@@ -43,7 +47,7 @@ namespace Aspen {
    * @param exception The exception to throw.
    */
   template<typename T>
-  auto throws(std::exception_ptr exception) {
+  auto throws(Error exception) {
     return Throw<T>(std::move(exception));
   }
 
@@ -57,13 +61,13 @@ namespace Aspen {
   }
 
   template<typename T>
-  Throw<T>::Throw(std::exception_ptr exception)
+  Throw<T>::Throw(Error exception)
     : m_exception(std::move(exception)) {}
 
   template<typename T>
   template<typename E>
   Throw<T>::Throw(E exception)
-    : Throw(std::make_exception_ptr(std::move(exception))) {}
+    : Throw(make_error(std::move(exception))) {}
 
   template<typename T>
   State Throw<T>::commit(int sequence) noexcept {
@@ -72,11 +76,16 @@ namespace Aspen {
 
   template<typename T>
   eval_result_t<typename Throw<T>::Type> Throw<T>::eval() const {
-    std::rethrow_exception(m_exception);
+    raise(m_exception);
     if constexpr(!std::is_same_v<Type, void>) {
       return *static_cast<const Type*>(nullptr);
     }
   }
+
+  template<typename T>
+  Error Throw<T>::get_error() const noexcept {
+    return m_exception;
+  }
 }
 
 #endif
@@ -0,0 +1,204 @@
+#ifndef ASPEN_TIMER_HPP
+#define ASPEN_TIMER_HPP
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include "Aspen/Error.hpp"
+#include "Aspen/State.hpp"
+#include "Aspen/TimerWheel.hpp"
+#include "Aspen/Trigger.hpp"
+
+namespace Aspen {
+
+  /**
+   * A reactor that evaluates to the time it expires at and then completes.
+   * Timers are scheduled on the TimerWheel of the thread committing them,
+   * which every executor installs while committing its reactors. A Timer
+   * committed without one completes with an error. A CommitPool installs the
+   * committing thread's TimerWheel on its workers.
+   */
+  class Timer {
+    public:
+      using Type = TimerWheel::TimePoint;
+
+      /**
+       * Constructs a Timer that expires a given duration after it's first
+       * committed.
+       * @param duration The duration after which the timer expires.
+       */
+      explicit Timer(TimerWheel::Duration duration);
+
+      /**
+       * Constructs a Timer that expires at a given point in time.
+       * @param expiry The time at which the timer expires.
+       */
+      explicit Timer(TimerWheel::TimePoint expiry);
+
+      Timer(Timer&&) = default;
+
+      State commit(int sequence) noexcept;
+
+      const Type& eval() const;
+
+      /** Returns the error this timer completed with, if any. */
+      Error get_error() const noexcept;
+
+      Timer& operator =(Timer&&) = default;
+
+    private:
+      TimerWheel::Duration m_duration;
+      std::optional<TimerWheel::TimePoint> m_expiry;
+      std::unique_ptr<TimerWheel::Entry> m_entry;
+      Error m_exception;
+  };
+
+  /**
+   * A reactor that evaluates to the number of periods elapsed every time a
+   * period elapses. Like a Timer, an Interval completes with an error if it's
+   * committed without a TimerWheel.
+   */
+  class Interval {
+    public:
+      using Type = int;
+
+      /**
+       * Constructs an Interval.
+       * @param period The period between evaluations.
+       */
+      explicit Interval(TimerWheel::Duration period);
+
+      Interval(Interval&&) = default;
+
+      State commit(int sequence) noexcept;
+
+      const Type& eval() const;
+
+      /** Returns the error this interval completed with, if any. */
+      Error get_error() const noexcept;
+
+      Interval& operator =(Interval&&) = default;
+
+    private:
+      TimerWheel::Duration m_period;
+      TimerWheel::TimePoint m_expiry;
+      std::unique_ptr<TimerWheel::Entry> m_entry;
+      int m_count;
+      Error m_exception;
+  };
+
+  /**
+   * Returns a reactor that evaluates once a duration has elapsed.
+   * @param duration The duration after which the reactor evaluates.
+   */
+  inline auto timer(TimerWheel::Duration duration) {
+    return Timer(duration);
+  }
+
+  /**
+   * Returns a reactor that evaluates once a point in time has been reached.
+   * @param expiry The time at which the reactor evaluates.
+   */
+  inline auto deadline(TimerWheel::TimePoint expiry) {
+    return Timer(expiry);
+  }
+
+  /**
+   * Returns a reactor that evaluates every time a period elapses.
+   * @param period The period between evaluations.
+   */
+  inline auto interval(TimerWheel::Duration period) {
+    return Interval(period);
+  }
+
+namespace Details {
+  inline Error make_missing_wheel_exception() {
+    return make_error(
+      std::runtime_error("No TimerWheel available."));
+  }
+}
+
+  inline Timer::Timer(TimerWheel::Duration duration)
+    : m_duration(duration) {}
+
+  inline Timer::Timer(TimerWheel::TimePoint expiry)
+    : m_duration(TimerWheel::Duration::zero()),
+      m_expiry(expiry) {}
+
+  inline State Timer::commit(int) noexcept {
+    if(m_entry == nullptr) {
+      auto wheel = TimerWheel::get_wheel();
+      if(wheel == nullptr) {
+        m_exception = Details::make_missing_wheel_exception();
+        return State::COMPLETE_EVALUATED;
+      }
+      if(!m_expiry.has_value()) {
+        m_expiry = wheel->get_time() + m_duration;
+      }
+      if(wheel->get_time() >= *m_expiry) {
+        return State::COMPLETE_EVALUATED;
+      }
+      m_entry = std::make_unique<TimerWheel::Entry>();
+      wheel->add(*m_entry, *m_expiry, Trigger::get_trigger());
+      return State::NONE;
+    } else if(m_entry->is_expired()) {
+      return State::COMPLETE_EVALUATED;
+    }
+    return State::NONE;
+  }
+
+  inline const Timer::Type& Timer::eval() const {
+    if(m_exception) {
+      raise(m_exception);
+    }
+    return *m_expiry;
+  }
+
+  inline Error Timer::get_error() const noexcept {
+    return m_exception;
+  }
+
+  inline Interval::Interval(TimerWheel::Duration period)
+    : m_period(period),
+      m_count(0) {}
+
+  inline State Interval::commit(int) noexcept {
+    if(m_entry == nullptr) {
+      auto wheel = TimerWheel::get_wheel();
+      if(wheel == nullptr) {
+        m_exception = Details::make_missing_wheel_exception();
+        return State::COMPLETE_EVALUATED;
+      }
+      m_expiry = wheel->get_time() + m_period;
+      m_entry = std::make_unique<TimerWheel::Entry>();
+      wheel->add(*m_entry, m_expiry, Trigger::get_trigger());
+      return State::NONE;
+    } else if(!m_entry->is_expired()) {
+      return State::NONE;
+    }
+    auto wheel = TimerWheel::get_wheel();
+    if(wheel == nullptr) {
+      m_exception = Details::make_missing_wheel_exception();
+      return State::COMPLETE_EVALUATED;
+    }
+    auto periods = 1 + static_cast<int>((wheel->get_time() - m_expiry) /
+      m_period);
+    m_count += periods;
+    m_expiry += periods * m_period;
+    wheel->add(*m_entry, m_expiry, Trigger::get_trigger());
+    return State::EVALUATED;
+  }
+
+  inline const Interval::Type& Interval::eval() const {
+    if(m_exception) {
+      raise(m_exception);
+    }
+    return m_count;
+  }
+
+  inline Error Interval::get_error() const noexcept {
+    return m_exception;
+  }
+}
+
+#endif
@@ -0,0 +1,432 @@
+#ifndef ASPEN_TIMER_WHEEL_HPP
+#define ASPEN_TIMER_WHEEL_HPP
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include "Aspen/Trigger.hpp"
+
+namespace Aspen {
+
+  /**
+   * A hierarchical timing wheel used to schedule timers with constant time
+   * insertion and cancellation. A wheel is only ever accessed by the thread
+   * that advances it, except while it's shared, during which entries may also
+   * be added and removed by other threads.
+   */
+  class TimerWheel {
+    public:
+
+      /** The clock used to measure time. */
+      using Clock = std::chrono::steady_clock;
+
+      /** The type used to represent a point in time. */
+      using TimePoint = Clock::time_point;
+
+      /** The type used to represent a duration. */
+      using Duration = Clock::duration;
+
+      /** A timer that can be scheduled on a TimerWheel. */
+      class Entry {
+        public:
+
+          /** Constructs an unscheduled Entry. */
+          Entry() noexcept;
+
+          /** Cancels this Entry if it's scheduled. */
+          ~Entry();
+
+          /** Returns <code>true</code> iff this Entry is scheduled. */
+          bool is_pending() const noexcept;
+
+          /** Returns <code>true</code> iff this Entry has expired since it was
+           *  last scheduled.
+           */
+          bool is_expired() const noexcept;
+
+        private:
+          friend class TimerWheel;
+          Entry* m_next;
+          Entry* m_previous;
+          TimerWheel* m_wheel;
+          Trigger* m_trigger;
+          std::int64_t m_expiry;
+          int m_level;
+          int m_slot;
+          bool m_is_expired;
+
+          Entry(const Entry&) = delete;
+          Entry& operator =(const Entry&) = delete;
+      };
+
+      /** Returns the TimerWheel used by the calling thread. */
+      static TimerWheel* get_wheel() noexcept;
+
+      /** Sets the TimerWheel used by the calling thread. */
+      static void set_wheel(TimerWheel* wheel) noexcept;
+
+      /**
+       * Constructs a TimerWheel starting at the current time with a
+       * resolution of one millisecond.
+       */
+      TimerWheel();
+
+      /**
+       * Constructs a TimerWheel.
+       * @param start The wheel's initial time.
+       * @param resolution The duration of a single tick.
+       */
+      TimerWheel(TimePoint start, Duration resolution);
+
+      /** Cancels all scheduled entries. */
+      ~TimerWheel();
+
+      /** Returns the time the wheel was last advanced to. */
+      TimePoint get_time() const noexcept;
+
+      /** Returns <code>true</code> iff no entries are scheduled. */
+      bool is_empty() const noexcept;
+
+      /**
+       * Returns the earliest time the wheel needs to be advanced to in order
+       * to make progress on its scheduled entries.
+       */
+      std::optional<TimePoint> get_next_expiry() const noexcept;
+
+      /**
+       * Returns the earliest time at which a scheduled entry expires. Unlike
+       * get_next_expiry, this never returns a tick at which entries are only
+       * moved between levels of the wheel.
+       */
+      std::optional<TimePoint> get_next_deadline() const noexcept;
+
+      /**
+       * Schedules an entry, rescheduling it if it's already pending.
+       * @param entry The entry to schedule.
+       * @param expiry The time at which the entry expires.
+       * @param trigger The Trigger to signal when the entry expires.
+       */
+      void add(Entry& entry, TimePoint expiry, Trigger* trigger) noexcept;
+
+      /**
+       * Cancels an entry.
+       * @param entry The entry to cancel.
+       */
+      void remove(Entry& entry) noexcept;
+
+      /**
+       * Advances the wheel, expiring every entry scheduled on or before a
+       * given time and signalling each expired entry's Trigger.
+       * @param time The time to advance to.
+       */
+      void advance(TimePoint time) noexcept;
+
+      /**
+       * Shares this wheel until a matching call to unshare, allowing threads
+       * other than the one advancing it to add and remove entries. Used by a
+       * CommitPool for the duration of a job.
+       */
+      void share() noexcept;
+
+      /** Ends a previous call to share. */
+      void unshare() noexcept;
+
+    private:
+      static constexpr auto BITS = 6;
+      static constexpr auto SLOTS = std::int64_t(1) << BITS;
+      static constexpr auto LEVELS = 4;
+      static constexpr auto SPAN = std::int64_t(1) << (BITS * LEVELS);
+      static inline thread_local TimerWheel* m_current = nullptr;
+      TimePoint m_start;
+      Duration m_resolution;
+      std::int64_t m_tick;
+      std::size_t m_size;
+      std::array<std::array<Entry*, SLOTS>, LEVELS> m_slots;
+      std::array<std::uint64_t, LEVELS> m_occupancy;
+      std::atomic_int m_share_count;
+      std::mutex m_mutex;
+
+      TimerWheel(const TimerWheel&) = delete;
+      TimerWheel& operator =(const TimerWheel&) = delete;
+      std::int64_t to_tick(TimePoint time, bool round_up) const noexcept;
+      std::int64_t get_next_tick() const noexcept;
+      std::unique_lock<std::mutex> lock_shared() noexcept;
+      void link(Entry& entry) noexcept;
+      void unlink(Entry& entry) noexcept;
+      void process(std::int64_t tick) noexcept;
+  };
+
+  inline TimerWheel::Entry::Entry() noexcept
+    : m_next(nullptr),
+      m_previous(nullptr),
+      m_wheel(nullptr),
+      m_trigger(nullptr),
+      m_expiry(0),
+      m_level(0),
+      m_slot(0),
+      m_is_expired(false) {}
+
+  inline TimerWheel::Entry::~Entry() {
+    if(m_wheel != nullptr) {
+      m_wheel->remove(*this);
+    }
+  }
+
+  inline bool TimerWheel::Entry::is_pending() const noexcept {
+    return m_wheel != nullptr;
+  }
+
+  inline bool TimerWheel::Entry::is_expired() const noexcept {
+    return m_is_expired;
+  }
+
+  inline TimerWheel* TimerWheel::get_wheel() noexcept {
+    return m_current;
+  }
+
+  inline void TimerWheel::set_wheel(TimerWheel* wheel) noexcept {
+    m_current = wheel;
+  }
+
+  inline TimerWheel::TimerWheel()
+    : TimerWheel(Clock::now(), std::chrono::milliseconds(1)) {}
+
+  inline TimerWheel::TimerWheel(TimePoint start, Duration resolution)
+      : m_start(start),
+        m_resolution(resolution),
+        m_tick(0),
+        m_size(0),
+        m_occupancy(),
+        m_share_count(0) {
+    for(auto& level : m_slots) {
+      level.fill(nullptr);
+    }
+  }
+
+  inline TimerWheel::~TimerWheel() {
+    for(auto& level : m_slots) {
+      for(auto slot : level) {
+        while(slot != nullptr) {
+          auto next = slot->m_next;
+          slot->m_wheel = nullptr;
+          slot->m_next = nullptr;
+          slot->m_previous = nullptr;
+          slot = next;
+        }
+      }
+    }
+  }
+
+  inline TimerWheel::TimePoint TimerWheel::get_time() const noexcept {
+    return m_start + m_tick * m_resolution;
+  }
+
+  inline bool TimerWheel::is_empty() const noexcept {
+    return m_size == 0;
+  }
+
+  inline std::optional<TimerWheel::TimePoint>
+      TimerWheel::get_next_expiry() const noexcept {
+    if(m_size == 0) {
+      return std::nullopt;
+    }
+    return m_start + get_next_tick() * m_resolution;
+  }
+
+  inline std::optional<TimerWheel::TimePoint>
+      TimerWheel::get_next_deadline() const noexcept {
+    if(m_size == 0) {
+      return std::nullopt;
+    }
+    auto deadline = std::numeric_limits<std::int64_t>::max();
+    for(auto level = 0; level != LEVELS; ++level) {
+      auto occupancy = m_occupancy[level];
+      auto shift = BITS * level;
+      auto block = m_tick >> shift;
+      auto first = std::numeric_limits<std::int64_t>::max();
+      auto first_slot = SLOTS;
+      for(auto slot = std::int64_t(0); slot != SLOTS; ++slot) {
+        if((occupancy & (std::uint64_t(1) << slot)) == 0) {
+          continue;
+        }
+        auto candidate = (block & ~(SLOTS - 1)) + slot;
+        if(candidate <= block) {
+          candidate += SLOTS;
+        }
+        if(candidate < first) {
+          first = candidate;
+          first_slot = slot;
+        }
+      }
+      if(first_slot == SLOTS) {
+        continue;
+      }
+      for(auto entry = m_slots[level][first_slot]; entry != nullptr;
+          entry = entry->m_next) {
+        deadline = std::min(deadline, entry->m_expiry);
+      }
+    }
+    return m_start + deadline * m_resolution;
+  }
+
+  inline void TimerWheel::add(Entry& entry, TimePoint expiry,
+      Trigger* trigger) noexcept {
+    if(entry.m_wheel != nullptr) {
+      entry.m_wheel->remove(entry);
+    }
+    auto lock = lock_shared();
+    entry.m_wheel = this;
+    entry.m_trigger = trigger;
+    entry.m_is_expired = false;
+    entry.m_expiry = std::max(to_tick(expiry, true), m_tick + 1);
+    link(entry);
+    ++m_size;
+  }
+
+  inline void TimerWheel::remove(Entry& entry) noexcept {
+    if(entry.m_wheel != this) {
+      return;
+    }
+    auto lock = lock_shared();
+    unlink(entry);
+    entry.m_wheel = nullptr;
+    --m_size;
+  }
+
+  inline void TimerWheel::advance(TimePoint time) noexcept {
+    auto target = to_tick(time, false);
+    while(m_tick < target) {
+      if(m_size == 0) {
+        m_tick = target;
+        break;
+      }
+      auto next = get_next_tick();
+      if(next > target) {
+        m_tick = target;
+        break;
+      }
+      m_tick = next;
+      process(next);
+    }
+  }
+
+  inline void TimerWheel::share() noexcept {
+    m_share_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  inline void TimerWheel::unshare() noexcept {
+    m_share_count.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  inline std::int64_t TimerWheel::to_tick(TimePoint time,
+      bool round_up) const noexcept {
+    auto elapsed = time - m_start;
+    auto tick = elapsed / m_resolution;
+    if(round_up && tick * m_resolution < elapsed) {
+      ++tick;
+    }
+    return tick;
+  }
+
+  inline std::int64_t TimerWheel::get_next_tick() const noexcept {
+    auto next = std::numeric_limits<std::int64_t>::max();
+    for(auto level = 0; level != LEVELS; ++level) {
+      auto occupancy = m_occupancy[level];
+      auto shift = BITS * level;
+      auto block = m_tick >> shift;
+      for(auto slot = std::int64_t(0); slot != SLOTS; ++slot) {
+        if((occupancy & (std::uint64_t(1) << slot)) == 0) {
+          continue;
+        }
+        auto candidate = (block & ~(SLOTS - 1)) + slot;
+        if(candidate <= block) {
+          candidate += SLOTS;
+        }
+        next = std::min(next, candidate << shift);
+      }
+    }
+    return next;
+  }
+
+  inline std::unique_lock<std::mutex> TimerWheel::lock_shared() noexcept {
+    if(m_share_count.load(std::memory_order_relaxed) == 0) {
+      return std::unique_lock<std::mutex>();
+    }
+    return std::unique_lock(m_mutex);
+  }
+
+  inline void TimerWheel::link(Entry& entry) noexcept {
+    auto delta = entry.m_expiry - m_tick;
+    auto expiry = entry.m_expiry;
+    if(delta >= SPAN) {
+      expiry = m_tick + SPAN - 1;
+      delta = SPAN - 1;
+    }
+    auto level = 0;
+    while(delta >= (std::int64_t(1) << (BITS * (level + 1)))) {
+      ++level;
+    }
+    auto slot = static_cast<int>((expiry >> (BITS * level)) & (SLOTS - 1));
+    auto& head = m_slots[level][slot];
+    entry.m_level = level;
+    entry.m_slot = slot;
+    entry.m_previous = nullptr;
+    entry.m_next = head;
+    if(head != nullptr) {
+      head->m_previous = &entry;
+    }
+    head = &entry;
+    m_occupancy[level] |= std::uint64_t(1) << slot;
+  }
+
+  inline void TimerWheel::unlink(Entry& entry) noexcept {
+    if(entry.m_previous != nullptr) {
+      entry.m_previous->m_next = entry.m_next;
+    } else {
+      m_slots[entry.m_level][entry.m_slot] = entry.m_next;
+      if(entry.m_next == nullptr) {
+        m_occupancy[entry.m_level] &= ~(std::uint64_t(1) << entry.m_slot);
+      }
+    }
+    if(entry.m_next != nullptr) {
+      entry.m_next->m_previous = entry.m_previous;
+    }
+    entry.m_next = nullptr;
+    entry.m_previous = nullptr;
+  }
+
+  inline void TimerWheel::process(std::int64_t tick) noexcept {
+    for(auto level = LEVELS - 1; level >= 0; --level) {
+      auto shift = BITS * level;
+      if(level != 0 && (tick & ((std::int64_t(1) << shift) - 1)) != 0) {
+        continue;
+      }
+      auto slot = (tick >> shift) & (SLOTS - 1);
+      auto entry = m_slots[level][slot];
+      m_slots[level][slot] = nullptr;
+      m_occupancy[level] &= ~(std::uint64_t(1) << slot);
+      while(entry != nullptr) {
+        auto next = entry->m_next;
+        entry->m_next = nullptr;
+        entry->m_previous = nullptr;
+        if(entry->m_expiry <= tick) {
+          entry->m_wheel = nullptr;
+          entry->m_is_expired = true;
+          --m_size;
+          if(entry->m_trigger != nullptr) {
+            entry->m_trigger->signal();
+          }
+        } else {
+          link(*entry);
+        }
+        entry = next;
+      }
+    }
+  }
+}
+
+#endif
@@ -73,6 +73,38 @@ namespace Aspen {
   template<typename R>
   constexpr auto is_noexcept_reactor_v = is_noexcept_reactor<R>::value;
 
+  /**
+   * Tests if a reactor can report the error it evaluates to without raising
+   * it, through a <code>get_error() const noexcept</code> method that returns
+   * an empty Error when the reactor evaluates to a value. When built with
+   * ASPEN_NO_EXCEPTIONS, errors only propagate through reactors satisfying
+   * this trait.
+   */
+  template<typename R, typename=void>
+  struct has_error : std::false_type {};
+
+  template<typename R>
+  struct has_error<R, std::enable_if_t<std::is_same_v<
+    decltype(std::declval<const R&>().get_error()), Error>>> :
+    std::true_type {};
+
+  template<typename R>
+  constexpr auto has_error_v = has_error<R>::value;
+
+  /**
+   * Returns the error a reactor evaluates to without raising it, or an empty
+   * Error if the reactor evaluates to a value or can't report its error.
+   * @param reactor The reactor to test.
+   */
+  template<typename R>
+  Error eval_error(const R& reactor) noexcept {
+    if constexpr(has_error_v<R>) {
+      return reactor.get_error();
+    } else {
+      return Error();
+    }
+  }
+
   template<std::size_t I = 0, typename... T, typename F>
   void for_each(std::tuple<T...>& t, F&& f) {
     if constexpr(I != sizeof...(T)) {
@@ -89,6 +121,22 @@ namespace Aspen {
     }
   }
 
+  /**
+   * Evaluates a reactor into a Maybe, capturing the error it evaluates to.
+   * Without exceptions, the error is read through the reactor's get_error
+   * method instead.
+   * @param reactor The reactor to evaluate.
+   */
+  template<typename R>
+  auto try_eval_maybe(const R& reactor) noexcept {
+#ifdef ASPEN_NO_EXCEPTIONS
+    if(auto error = eval_error(reactor)) {
+      return Maybe<std::decay_t<decltype(reactor.eval())>>(std::move(error));
+    }
+#endif
+    return try_call([&] { return reactor.eval(); });
+  }
+
   template<typename R>
   auto try_eval(const R& reactor) noexcept {
     if constexpr(is_noexcept_reactor_v<R>) {
@@ -99,7 +147,7 @@ namespace Aspen {
         return LocalPtr(reactor.eval());
       }
     } else {
-      return try_call([&] { return reactor.eval(); });
+      return try_eval_maybe(reactor);
     }
   }
 }
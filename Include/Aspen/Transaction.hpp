@@ -0,0 +1,243 @@
+#ifndef ASPEN_TRANSACTION_HPP
+#define ASPEN_TRANSACTION_HPP
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Aspen/Error.hpp"
+#include "Aspen/Trigger.hpp"
+
+namespace Aspen {
+  template<typename T> class Cell;
+  template<typename T> class Queue;
+
+namespace Details {
+
+  /** Stores the publication state shared by every update in a Transaction. */
+  struct TransactionState {
+
+    /** Protects the remaining members. */
+    std::mutex m_mutex;
+
+    /** Whether the transaction has been published. */
+    bool m_is_published;
+
+    /**
+     * The latest sequence in which an updated source was committed without
+     * the transaction's updates, or -1.
+     */
+    int m_last_sequence;
+
+    /**
+     * The first sequence in which the transaction's updates may be applied,
+     * or -1 if no source has observed the published transaction.
+     */
+    int m_sequence;
+
+    /** Constructs an unpublished TransactionState. */
+    TransactionState() noexcept;
+
+    /**
+     * Records that an updated source was committed without the transaction's
+     * updates.
+     * @param sequence The sequence the source was committed in.
+     */
+    void observe(int sequence) noexcept;
+  };
+
+  /**
+   * Stores an update to a source that may belong to a Transaction.
+   * @param <T> The type of value staged.
+   */
+  template<typename T>
+  struct StagedValue {
+
+    /** The transaction the update belongs to, or null if it's direct. */
+    std::shared_ptr<TransactionState> m_transaction;
+
+    /** The value to apply. */
+    T m_value;
+  };
+
+  inline TransactionState::TransactionState() noexcept
+    : m_is_published(false),
+      m_last_sequence(-1),
+      m_sequence(-1) {}
+
+  inline void TransactionState::observe(int sequence) noexcept {
+    auto lock = std::lock_guard(m_mutex);
+    m_last_sequence = std::max(m_last_sequence, sequence);
+  }
+
+  /**
+   * Determines whether a staged update can be applied within a sequence. The
+   * first source to observe a published transaction claims the sequence
+   * being committed for it, or the following sequence if another updated
+   * source was already committed in it without the update, so that no
+   * sequence sees only part of the transaction.
+   * @param staged The staged update to test.
+   * @param sequence The sequence being committed.
+   * @param has_continuation Set to <code>true</code> if the update can be
+   *        applied in a later sequence.
+   * @return <code>true</code> iff the update can be applied now.
+   */
+  template<typename T>
+  bool is_ready(const StagedValue<T>& staged, int sequence,
+      bool& has_continuation) noexcept {
+    if(staged.m_transaction == nullptr) {
+      return true;
+    }
+    auto& state = *staged.m_transaction;
+    auto lock = std::lock_guard(state.m_mutex);
+    if(!state.m_is_published) {
+      state.m_last_sequence = std::max(state.m_last_sequence, sequence);
+      return false;
+    } else if(state.m_sequence == -1) {
+      if(state.m_last_sequence >= sequence) {
+        state.m_sequence = sequence + 1;
+      } else {
+        state.m_sequence = sequence;
+      }
+    }
+    if(state.m_sequence > sequence) {
+      has_continuation = true;
+      return false;
+    }
+    return true;
+  }
+}
+
+  /**
+   * Stages updates to any number of Cells and Queues and publishes them
+   * atomically, signalling each distinct Trigger once. Every source committed
+   * in the same sequence either observes all of a transaction's updates or
+   * none of them. Sequences are only comparable within one executor, so every
+   * source updated by a Transaction must be committed by the same executor.
+   */
+  class Transaction {
+    public:
+
+      /** Constructs an empty Transaction. */
+      Transaction();
+
+      /**
+       * Stages setting a Cell's value.
+       * @param cell The Cell to update.
+       * @param value The value to set.
+       */
+      template<typename T>
+      void set(Cell<T>& cell, T value);
+
+      /**
+       * Stages pushing a value onto a Queue.
+       * @param queue The Queue to update.
+       * @param value The value to push.
+       */
+      template<typename T>
+      void push(Queue<T>& queue, T value);
+
+      /**
+       * Publishes all staged updates, after which this Transaction is empty
+       * and may be reused. Updates that are never published are discarded.
+       * Throws, discarding the staged updates, if the updated sources have
+       * been committed by more than one executor.
+       */
+      void publish();
+
+    private:
+      struct BaseStage {
+        virtual ~BaseStage() = default;
+        virtual void stage(
+          const std::shared_ptr<Details::TransactionState>& state) = 0;
+        virtual Trigger* load_trigger() = 0;
+      };
+      template<typename S, typename T>
+      struct Stage final : BaseStage {
+        S* m_source;
+        T m_value;
+
+        Stage(S& source, T value);
+        void stage(
+          const std::shared_ptr<Details::TransactionState>& state) override;
+        Trigger* load_trigger() override;
+      };
+      std::shared_ptr<Details::TransactionState> m_state;
+      std::vector<std::unique_ptr<BaseStage>> m_stages;
+
+      Transaction(const Transaction&) = delete;
+      Transaction& operator =(const Transaction&) = delete;
+      std::vector<Trigger*> load_triggers() const;
+  };
+
+  inline Transaction::Transaction()
+    : m_state(std::make_shared<Details::TransactionState>()) {}
+
+  template<typename T>
+  void Transaction::set(Cell<T>& cell, T value) {
+    m_stages.push_back(
+      std::make_unique<Stage<Cell<T>, T>>(cell, std::move(value)));
+  }
+
+  template<typename T>
+  void Transaction::push(Queue<T>& queue, T value) {
+    m_stages.push_back(
+      std::make_unique<Stage<Queue<T>, T>>(queue, std::move(value)));
+  }
+
+  inline void Transaction::publish() {
+    if(m_stages.empty()) {
+      return;
+    }
+    if(load_triggers().size() > 1) {
+      m_stages.clear();
+      ASPEN_THROW(std::runtime_error(
+        "Transaction updates sources of more than one executor."));
+    }
+    for(auto& stage : m_stages) {
+      stage->stage(m_state);
+    }
+    {
+      auto lock = std::lock_guard(m_state->m_mutex);
+      m_state->m_is_published = true;
+    }
+    auto triggers = load_triggers();
+    m_stages.clear();
+    m_state = std::make_shared<Details::TransactionState>();
+    for(auto trigger : triggers) {
+      trigger->signal();
+    }
+  }
+
+  inline std::vector<Trigger*> Transaction::load_triggers() const {
+    auto triggers = std::vector<Trigger*>();
+    for(auto& stage : m_stages) {
+      auto trigger = stage->load_trigger();
+      if(trigger != nullptr &&
+          std::find(triggers.begin(), triggers.end(), trigger) ==
+          triggers.end()) {
+        triggers.push_back(trigger);
+      }
+    }
+    return triggers;
+  }
+
+  template<typename S, typename T>
+  Transaction::Stage<S, T>::Stage(S& source, T value)
+    : m_source(&source),
+      m_value(std::move(value)) {}
+
+  template<typename S, typename T>
+  void Transaction::Stage<S, T>::stage(
+      const std::shared_ptr<Details::TransactionState>& state) {
+    m_source->stage(state, std::move(m_value));
+  }
+
+  template<typename S, typename T>
+  Trigger* Transaction::Stage<S, T>::load_trigger() {
+    return m_source->load_trigger();
+  }
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define ASPEN_UNIQUE_HPP
 #include <memory>
 #include <utility>
+#include "Aspen/Error.hpp"
+#include "Aspen/SharedPolicy.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -50,8 +52,11 @@ namespace Aspen {
 
       Result eval() const noexcept(is_noexcept);
 
+      /** Returns the error the reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
-      template<typename> friend class Shared;
+      template<typename, SharedPolicy> friend class Shared;
       std::unique_ptr<Reactor> m_reactor;
   };
 
@@ -92,6 +97,11 @@ namespace Aspen {
   typename Unique<R>::Result Unique<R>::eval() const noexcept(is_noexcept) {
     return m_reactor->eval();
   }
+
+  template<typename R>
+  Error Unique<R>::get_error() const noexcept {
+    return eval_error(*m_reactor);
+  }
 }
 
 #endif
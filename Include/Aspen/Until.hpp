@@ -1,6 +1,7 @@
 #ifndef ASPEN_UNTIL_HPP
 #define ASPEN_UNTIL_HPP
 #include <optional>
+#include "Aspen/Error.hpp"
 #include "Aspen/Maybe.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
@@ -32,6 +33,9 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const noexcept(is_noexcept);
 
+      /** Returns the error this reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       C m_condition;
       std::optional<T> m_series;
@@ -67,14 +71,20 @@ namespace Aspen {
     if(!m_is_condition_complete) {
       auto condition_state = m_condition.commit(sequence);
       if(has_evaluation(condition_state)) {
-        try {
-          if(m_condition.eval()) {
-            m_series = std::nullopt;
-            state = State::COMPLETE;
-          }
-        } catch(...) {
+        if(auto error = eval_error(m_condition)) {
           if constexpr(!is_noexcept) {
-            m_value = std::current_exception();
+            m_value = std::move(error);
+          }
+        } else {
+          ASPEN_TRY {
+            if(m_condition.eval()) {
+              m_series = std::nullopt;
+              state = State::COMPLETE;
+            }
+          } ASPEN_CATCH(...) {
+            if constexpr(!is_noexcept) {
+              m_value = current_error();
+            }
           }
         }
       }
@@ -100,6 +110,15 @@ namespace Aspen {
       is_noexcept) {
     return *m_value;
   }
+
+  template<typename C, typename T>
+  Error Until<C, T>::get_error() const noexcept {
+    if constexpr(is_noexcept) {
+      return Error();
+    } else {
+      return m_value.get_exception();
+    }
+  }
 }
 
 #endif
@@ -0,0 +1,142 @@
+#ifndef ASPEN_VARIANT_BOX_HPP
+#define ASPEN_VARIANT_BOX_HPP
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "Aspen/State.hpp"
+#include "Aspen/Traits.hpp"
+
+namespace Aspen {
+
+  /**
+   * Wraps one of a closed set of reactors within a common interface. Unlike a
+   * Box, the reactor is stored inline and calls are dispatched on the index of
+   * the active alternative rather than through a virtual call, allowing the
+   * compiler to inline each alternative.
+   * @param <R> The types of reactors that can be wrapped.
+   */
+  template<typename... R>
+  class VariantBox {
+    public:
+      using Type = reactor_result_t<std::tuple_element_t<0, std::tuple<R...>>>;
+      static_assert((std::is_same_v<reactor_result_t<R>, Type> && ...),
+        "All reactors must evaluate to the same type.");
+
+      /**
+       * The type returned by eval, a reference only if every alternative
+       * evaluates to the same reference type.
+       */
+      using Result = std::conditional_t<(std::is_same_v<
+        decltype(std::declval<const R&>().eval()), eval_result_t<Type>> &&
+        ...), eval_result_t<Type>, Type>;
+      static constexpr auto is_noexcept = (is_noexcept_reactor_v<R> && ...);
+
+      /**
+       * Constructs a VariantBox.
+       * @param reactor The reactor to wrap, which must be one of R.
+       */
+      template<typename Q, typename = std::enable_if_t<
+        !std::is_base_of_v<VariantBox, std::decay_t<Q>>>>
+      VariantBox(Q&& reactor);
+
+      /**
+       * Constructs a VariantBox by emplacing one of its alternatives.
+       * @param type The type of reactor to emplace.
+       * @param args The arguments used to emplace the reactor.
+       */
+      template<typename Q, typename... A>
+      explicit VariantBox(std::in_place_type_t<Q> type, A&&... args);
+
+      /** Returns the index of the wrapped reactor's type within R. */
+      std::size_t index() const noexcept;
+
+      State commit(int sequence) noexcept;
+
+      Result eval() const noexcept(is_noexcept);
+
+      /** Returns the error this reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
+    private:
+      std::variant<R...> m_reactor;
+
+      template<std::size_t I = 0, typename F>
+      decltype(auto) visit(F&& f);
+      template<std::size_t I = 0, typename F>
+      decltype(auto) visit(F&& f) const;
+  };
+
+  template<typename... R>
+  template<typename Q, typename>
+  VariantBox<R...>::VariantBox(Q&& reactor)
+    : m_reactor(std::forward<Q>(reactor)) {}
+
+  template<typename... R>
+  template<typename Q, typename... A>
+  VariantBox<R...>::VariantBox(std::in_place_type_t<Q> type, A&&... args)
+    : m_reactor(type, std::forward<A>(args)...) {}
+
+  template<typename... R>
+  std::size_t VariantBox<R...>::index() const noexcept {
+    return m_reactor.index();
+  }
+
+  template<typename... R>
+  State VariantBox<R...>::commit(int sequence) noexcept {
+    return visit([&] (auto& reactor) noexcept {
+      return reactor.commit(sequence);
+    });
+  }
+
+  template<typename... R>
+  typename VariantBox<R...>::Result VariantBox<R...>::eval() const
+      noexcept(is_noexcept) {
+    return visit([] (const auto& reactor) noexcept(is_noexcept) -> Result {
+      return reactor.eval();
+    });
+  }
+
+  template<typename... R>
+  Error VariantBox<R...>::get_error() const noexcept {
+    return visit([] (const auto& reactor) noexcept {
+      if constexpr(has_error_v<std::decay_t<decltype(reactor)>>) {
+        return reactor.get_error();
+      } else {
+        return Error();
+      }
+    });
+  }
+
+  template<typename... R>
+  template<std::size_t I, typename F>
+  decltype(auto) VariantBox<R...>::visit(F&& f) {
+    if constexpr(I + 1 == sizeof...(R)) {
+      assert(m_reactor.index() == I);
+      return f(*std::get_if<I>(&m_reactor));
+    } else {
+      if(m_reactor.index() == I) {
+        return f(*std::get_if<I>(&m_reactor));
+      }
+      return visit<I + 1>(std::forward<F>(f));
+    }
+  }
+
+  template<typename... R>
+  template<std::size_t I, typename F>
+  decltype(auto) VariantBox<R...>::visit(F&& f) const {
+    if constexpr(I + 1 == sizeof...(R)) {
+      assert(m_reactor.index() == I);
+      return f(*std::get_if<I>(&m_reactor));
+    } else {
+      if(m_reactor.index() == I) {
+        return f(*std::get_if<I>(&m_reactor));
+      }
+      return visit<I + 1>(std::forward<F>(f));
+    }
+  }
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define ASPEN_VECTOR_SYNC_HPP
 #include <vector>
 #include "Aspen/CommitHandler.hpp"
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Sync.hpp"
 #include "Aspen/Traits.hpp"
@@ -25,20 +26,26 @@ namespace Aspen {
           @param value The vector to keep synchronized.
           @param reactors The vector of reactors used to synchronize the
                  <i>value</i>.
+          @param policy Specifies which reactors are committed.
        */
-      VectorSync(Type& value, std::vector<R> reactors);
+      VectorSync(Type& value, std::vector<R> reactors,
+        CommitPolicy policy = CommitPolicy::ALL);
 
       State commit(int sequence) noexcept;
 
       const Type& eval() const noexcept(is_noexcept);
 
+      /** Returns the error a reactor last evaluated to, if any. */
+      Error get_error() const noexcept;
+
     private:
       Type* m_value;
       CommitHandler<Sync<R>> m_reactors;
   };
 
   template<typename R, typename V>
-  VectorSync<R, V>::VectorSync(Type& value, std::vector<R> reactors)
+  VectorSync<R, V>::VectorSync(Type& value, std::vector<R> reactors,
+    CommitPolicy policy)
     : m_value(&value),
       m_reactors([&] {
         value.resize(reactors.size());
@@ -47,7 +54,7 @@ namespace Aspen {
           sync_reactors.push_back(Sync(value[i], std::move(reactors[i])));
         }
         return sync_reactors;
-      }()) {}
+      }(), policy) {}
 
   template<typename R, typename V>
   State VectorSync<R, V>::commit(int sequence) noexcept {
@@ -57,13 +64,21 @@ namespace Aspen {
     auto state = m_reactors.commit(sequence);
     if constexpr(!is_noexcept) {
       if(has_evaluation(state)) {
-        try {
-          for(auto i = std::size_t(0); i != m_reactors.size(); ++i) {
-            m_reactors.get(i).eval();
+        auto error = Error();
+        for(auto i = std::size_t(0); i != m_reactors.size() && !error; ++i) {
+          error = eval_error(m_reactors.get(i));
+        }
+        if(error) {
+          this->m_exception = std::move(error);
+        } else {
+          ASPEN_TRY {
+            for(auto i = std::size_t(0); i != m_reactors.size(); ++i) {
+              m_reactors.get(i).eval();
+            }
+            this->m_exception = Error();
+          } ASPEN_CATCH(...) {
+            this->m_exception = current_error();
           }
-          this->m_exception = nullptr;
-        } catch(...) {
-          this->m_exception = std::current_exception();
         }
       }
     }
@@ -75,11 +90,20 @@ namespace Aspen {
       noexcept(is_noexcept) {
     if constexpr(!is_noexcept) {
       if(this->m_exception) {
-        std::rethrow_exception(this->m_exception);
+        raise(this->m_exception);
       }
     }
     return *m_value;
   }
+
+  template<typename R, typename V>
+  Error VectorSync<R, V>::get_error() const noexcept {
+    if constexpr(is_noexcept) {
+      return Error();
+    } else {
+      return this->m_exception;
+    }
+  }
 }
 
 #endif
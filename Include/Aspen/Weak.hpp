@@ -1,8 +1,10 @@
 #ifndef ASPEN_WEAK_HPP
 #define ASPEN_WEAK_HPP
-#include <memory>
 #include <optional>
+#include <utility>
+#include "Aspen/Error.hpp"
 #include "Aspen/Shared.hpp"
+#include "Aspen/SharedPolicy.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -11,8 +13,9 @@ namespace Aspen {
   /**
    * Implements a weak reference to an existing shared reactor.
    * @param <R> The type of reactor to observe.
+   * @param <P> The policy used to count references.
    */
-  template<typename R>
+  template<typename R, SharedPolicy P = SharedPolicy::ATOMIC>
   class Weak {
     public:
       using Reactor = R;
@@ -24,55 +27,122 @@ namespace Aspen {
        * Constructs a Weak reactor observing an existing Shared reactor.
        * @param reactor The reactor to observe.
        */
-      explicit Weak(Shared<Reactor> reactor) noexcept;
+      explicit Weak(Shared<Reactor, P> reactor) noexcept;
+
+      Weak(const Weak& weak) noexcept;
+
+      Weak(Weak&& weak) noexcept;
+
+      ~Weak();
 
       /** Returns a new Shared reactor to the reactor being observed. */
-      std::optional<Shared<Reactor>> lock() const noexcept;
+      std::optional<Shared<Reactor, P>> lock() const noexcept;
 
       State commit(int sequence) noexcept;
 
       Result eval() const noexcept(is_noexcept);
 
+      /** Returns the error the observed reactor evaluates to, if any. */
+      Error get_error() const noexcept;
+
+      Weak& operator =(const Weak& weak) noexcept;
+
+      Weak& operator =(Weak&& weak) noexcept;
+
     private:
-      std::shared_ptr<Details::SharedEvaluator<Reactor>> m_evaluator;
+      Details::SharedBlock<Reactor, P>* m_block;
       int m_last_evaluation;
   };
 
-  template<typename R>
-  Weak<R>::Weak(Shared<Reactor> reactor) noexcept
-    : m_evaluator(std::move(reactor.m_evaluator)),
-      m_last_evaluation(-1) {}
+  template<typename R, SharedPolicy P>
+  Weak<R, P>::Weak(Shared<Reactor, P> reactor) noexcept
+      : m_block(reactor.m_block),
+        m_last_evaluation(-1) {
+    m_block->m_weak_count.increment();
+  }
 
-  template<typename R>
-  std::optional<Shared<R>> Weak<R>::lock() const noexcept {
-    auto reactor = m_evaluator->m_reactor.lock();
-    if(reactor == nullptr) {
+  template<typename R, SharedPolicy P>
+  Weak<R, P>::Weak(const Weak& weak) noexcept
+      : m_block(weak.m_block),
+        m_last_evaluation(weak.m_last_evaluation) {
+    if(m_block) {
+      m_block->m_weak_count.increment();
+    }
+  }
+
+  template<typename R, SharedPolicy P>
+  Weak<R, P>::Weak(Weak&& weak) noexcept
+      : m_block(weak.m_block),
+        m_last_evaluation(weak.m_last_evaluation) {
+    weak.m_block = nullptr;
+  }
+
+  template<typename R, SharedPolicy P>
+  Weak<R, P>::~Weak() {
+    if(m_block) {
+      m_block->release_weak();
+    }
+  }
+
+  template<typename R, SharedPolicy P>
+  std::optional<Shared<R, P>> Weak<R, P>::lock() const noexcept {
+    if(!m_block->m_count.increment_if_nonzero()) {
       return std::nullopt;
     }
-    return Shared(m_evaluator, std::move(reactor));
+    return Shared<Reactor, P>(m_block);
   }
 
-  template<typename R>
-  State Weak<R>::commit(int sequence) noexcept {
-    auto reactor = m_evaluator->m_reactor.lock();
-    if(reactor == nullptr) {
-      if(m_last_evaluation < m_evaluator->m_state->m_last_evaluation) {
+  template<typename R, SharedPolicy P>
+  State Weak<R, P>::commit(int sequence) noexcept {
+    if(!m_block->m_count.increment_if_nonzero()) {
+      if(m_last_evaluation < m_block->m_state->m_last_evaluation) {
         return State::COMPLETE_EVALUATED;
       }
       return State::COMPLETE;
-    } else {
-      return Shared<Reactor>::commit_state(sequence, *reactor, *m_evaluator,
-        m_last_evaluation);
     }
+    auto reactor = Shared<Reactor, P>(m_block);
+    return Shared<Reactor, P>::commit_state(sequence, *m_block,
+      m_last_evaluation);
+  }
+
+  template<typename R, SharedPolicy P>
+  typename Weak<R, P>::Result Weak<R, P>::eval() const noexcept(is_noexcept) {
+    if(m_block->m_evaluation.has_value()) {
+      return *m_block->m_evaluation;
+    }
+    return m_block->m_reactor->eval();
+  }
+
+  template<typename R, SharedPolicy P>
+  Error Weak<R, P>::get_error() const noexcept {
+    if(m_block->m_evaluation.has_value()) {
+      if constexpr(is_noexcept) {
+        return Error();
+      } else {
+        return m_block->m_evaluation->get_exception();
+      }
+    }
+    return eval_error(*m_block->m_reactor);
   }
 
-  template<typename R>
-  typename Weak<R>::Result Weak<R>::eval() const noexcept(is_noexcept) {
-    if(m_evaluator->m_evaluation.has_value()) {
-      return *m_evaluator->m_evaluation;
+  template<typename R, SharedPolicy P>
+  Weak<R, P>& Weak<R, P>::operator =(const Weak& weak) noexcept {
+    if(weak.m_block) {
+      weak.m_block->m_weak_count.increment();
     }
-    auto reactor = m_evaluator->m_reactor.lock();
-    return reactor->eval();
+    if(m_block) {
+      m_block->release_weak();
+    }
+    m_block = weak.m_block;
+    m_last_evaluation = weak.m_last_evaluation;
+    return *this;
+  }
+
+  template<typename R, SharedPolicy P>
+  Weak<R, P>& Weak<R, P>::operator =(Weak&& weak) noexcept {
+    std::swap(m_block, weak.m_block);
+    m_last_evaluation = weak.m_last_evaluation;
+    return *this;
   }
 }
 
@@ -1,5 +1,6 @@
 #ifndef ASPEN_WHEN_HPP
 #define ASPEN_WHEN_HPP
+#include "Aspen/Error.hpp"
 #include "Aspen/State.hpp"
 #include "Aspen/Traits.hpp"
 
@@ -31,6 +32,9 @@ namespace Aspen {
 
       eval_result_t<Type> eval() const noexcept(is_noexcept);
 
+      /** Returns the error the series evaluates to, if any. */
+      Error get_error() const noexcept;
+
     private:
       C m_condition;
       T m_series;
@@ -66,10 +70,10 @@ namespace Aspen {
     auto state = State::NONE;
     if(!m_is_triggered) {
       auto condition_state = m_condition.commit(sequence);
-      if(has_evaluation(condition_state)) {
-        try {
+      if(has_evaluation(condition_state) && !eval_error(m_condition)) {
+        ASPEN_TRY {
           m_is_triggered = m_condition.eval();
-        } catch(...) {}
+        } ASPEN_CATCH(...) {}
       }
       m_is_condition_complete = is_complete(condition_state);
       if(!m_is_triggered) {
@@ -99,6 +103,11 @@ namespace Aspen {
       is_noexcept) {
     return m_series.eval();
   }
+
+  template<typename C, typename T>
+  Error When<C, T>::get_error() const noexcept {
+    return eval_error(m_series);
+  }
 }
 
 #endif
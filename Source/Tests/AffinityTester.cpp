@@ -0,0 +1,175 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Affinity.hpp"
+#include "Aspen/Constant.hpp"
+#include "Aspen/ExecutorPool.hpp"
+#include "Aspen/Lift.hpp"
+
+using namespace Aspen;
+
+TEST_SUITE("Affinity") {
+  TEST_CASE("cpu_set") {
+    auto cpus = CpuSet{3, 1, 2, 1};
+    REQUIRE(!cpus.is_empty());
+    REQUIRE(cpus.get_cpus() == std::vector{1, 2, 3});
+    REQUIRE(cpus.contains(2));
+    cpus.remove(2);
+    REQUIRE(!cpus.contains(2));
+    cpus.add(0);
+    REQUIRE(cpus.get_cpus() == std::vector{0, 1, 3});
+  }
+
+  TEST_CASE("unrestricted") {
+    auto affinity = ThreadAffinity();
+    REQUIRE(affinity.is_unrestricted());
+    REQUIRE(affinity.get_numa_node() == -1);
+    REQUIRE(!ThreadAffinity(CpuSet{0}).is_unrestricted());
+  }
+
+  TEST_CASE("pin_thread") {
+    auto initial = CpuSet();
+    auto pinned = CpuSet();
+    auto restored = CpuSet();
+    auto cpu = -1;
+    auto thread = std::thread([&] {
+      initial = get_thread_cpus();
+      if(initial.is_empty()) {
+        return;
+      }
+      cpu = initial.get_cpus().back();
+      {
+        auto guard = AffinityGuard(ThreadAffinity(CpuSet{cpu}));
+        pinned = get_thread_cpus();
+      }
+      restored = get_thread_cpus();
+    });
+    thread.join();
+    if(initial.is_empty()) {
+      return;
+    }
+    REQUIRE(pinned.get_cpus() == std::vector{cpu});
+    REQUIRE(restored.get_cpus() == initial.get_cpus());
+  }
+
+#if defined (__linux__)
+  TEST_CASE("restore_memory_policy") {
+    auto is_supported = false;
+    auto mode = static_cast<int>(MPOL_DEFAULT);
+    auto thread = std::thread([&] {
+      auto cpus = get_thread_cpus();
+      if(cpus.is_empty()) {
+        return;
+      }
+      ASPEN_TRY {
+        set_thread_affinity(ThreadAffinity(CpuSet(), 0));
+      } ASPEN_CATCH(const std::exception&) {
+        return;
+      }
+      is_supported = true;
+      {
+        auto guard = AffinityGuard(
+          ThreadAffinity(CpuSet{cpus.get_cpus().back()}));
+      }
+      auto mask = static_cast<unsigned long>(0);
+      if(::syscall(SYS_get_mempolicy, &mode, &mask, sizeof(mask) * 8,
+          nullptr, 0) != 0) {
+        mode = -1;
+      }
+    });
+    thread.join();
+    if(is_supported) {
+      REQUIRE(mode == MPOL_PREFERRED);
+    }
+  }
+
+  TEST_CASE("keep_memory_policy") {
+    auto is_supported = false;
+    auto mode = static_cast<int>(MPOL_DEFAULT);
+    auto thread = std::thread([&] {
+      auto cpus = get_thread_cpus();
+      if(cpus.is_empty()) {
+        return;
+      }
+      ASPEN_TRY {
+        set_thread_affinity(ThreadAffinity(CpuSet(), 0));
+      } ASPEN_CATCH(const std::exception&) {
+        return;
+      }
+      is_supported = true;
+      set_thread_affinity(ThreadAffinity(CpuSet{cpus.get_cpus().back()}));
+      auto mask = static_cast<unsigned long>(0);
+      if(::syscall(SYS_get_mempolicy, &mode, &mask, sizeof(mask) * 8,
+          nullptr, 0) != 0) {
+        mode = -1;
+      }
+    });
+    thread.join();
+    if(is_supported) {
+      REQUIRE(mode == MPOL_PREFERRED);
+    }
+  }
+
+  TEST_CASE("restore_after_failure") {
+    auto initial = CpuSet();
+    auto restored = CpuSet();
+    auto is_thrown = false;
+    auto thread = std::thread([&] {
+      initial = get_thread_cpus();
+      if(initial.is_empty()) {
+        return;
+      }
+      ASPEN_TRY {
+        auto guard = AffinityGuard(
+          ThreadAffinity(CpuSet{initial.get_cpus().back()}, 1 << 20));
+      } ASPEN_CATCH(const std::exception&) {
+        is_thrown = true;
+      }
+      restored = get_thread_cpus();
+    });
+    thread.join();
+    if(initial.is_empty()) {
+      return;
+    }
+    REQUIRE(is_thrown);
+    REQUIRE(restored.get_cpus() == initial.get_cpus());
+  }
+#endif
+
+  TEST_CASE("pinned_pool") {
+    auto cpus = get_thread_cpus();
+    auto affinities = std::vector<ThreadAffinity>();
+    for(auto cpu : cpus.get_cpus()) {
+      affinities.emplace_back(CpuSet{cpu});
+      if(affinities.size() == 2) {
+        break;
+      }
+    }
+    auto result = std::atomic_int(0);
+    auto pool = ExecutorPool(affinities, CommitBudget());
+    REQUIRE(pool.get_thread_count() == std::max<std::size_t>(
+      affinities.size(), 1));
+    pool.add(
+      lift([&] (const auto& value) {
+        result = value;
+      }, constant(5)));
+    pool.wait();
+    REQUIRE(result == 5);
+    for(auto i = std::size_t(0); i != pool.get_thread_count(); ++i) {
+      REQUIRE(pool.get_affinity_error(i) == nullptr);
+    }
+  }
+
+  TEST_CASE("affinity_error") {
+    auto pool = ExecutorPool({ThreadAffinity(CpuSet{-1})}, CommitBudget());
+    REQUIRE(pool.get_affinity_error(0) != nullptr);
+    auto result = std::atomic_int(0);
+    pool.add(
+      lift([&] (const auto& value) {
+        result = value;
+      }, constant(5)));
+    pool.wait();
+    REQUIRE(result == 5);
+  }
+}
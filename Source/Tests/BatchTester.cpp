@@ -0,0 +1,173 @@
+#include <stdexcept>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Batch.hpp"
+#include "Aspen/Box.hpp"
+#include "Aspen/Constant.hpp"
+#include "Aspen/Count.hpp"
+#include "Aspen/Executor.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+
+using namespace Aspen;
+
+namespace {
+  template<typename T>
+  std::vector<T> to_vector(const Batch<T>& batch) {
+    auto values = std::vector<T>();
+    for(auto& value : batch) {
+      values.push_back(value.get());
+    }
+    return values;
+  }
+}
+
+TEST_SUITE("Batch") {
+  TEST_CASE("traits") {
+    REQUIRE(is_batch_reactor_v<Queue<int>>);
+    REQUIRE(is_batch_reactor_v<Shared<Queue<int>>>);
+    REQUIRE(is_batch_reactor_v<Lift<int (*)(int), Queue<int>>>);
+    REQUIRE(is_batch_reactor_v<Count<Queue<int>>>);
+    REQUIRE(!is_batch_reactor_v<Constant<int>>);
+    REQUIRE(!is_batch_reactor_v<Box<int>>);
+    REQUIRE(!is_batch_reactor_v<Shared<Constant<int>>>);
+    REQUIRE(!is_batch_reactor_v<Lift<int (*)(int), Constant<int>>>);
+    REQUIRE(!is_batch_reactor_v<
+      Lift<int (*)(int, int), Queue<int>, Constant<int>>>);
+    REQUIRE(!is_batch_reactor_v<Count<Constant<int>>>);
+  }
+
+  TEST_CASE("queue") {
+    auto queue = Queue<int>();
+    REQUIRE(queue.commit_batch(0) == State::NONE);
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+    REQUIRE(queue.commit_batch(1) == State::EVALUATED);
+    REQUIRE(to_vector(queue.eval_batch()) == std::vector{1, 2, 3});
+    REQUIRE(queue.eval() == 3);
+    REQUIRE(queue.commit_batch(2) == State::NONE);
+    REQUIRE(queue.eval() == 3);
+    queue.push(4);
+    queue.push(5);
+    REQUIRE(queue.commit(3) == State::CONTINUE_EVALUATED);
+    REQUIRE(queue.eval() == 4);
+    REQUIRE(queue.commit_batch(4) == State::EVALUATED);
+    REQUIRE(to_vector(queue.eval_batch()) == std::vector{5});
+    queue.set_complete(6);
+    REQUIRE(queue.commit_batch(5) == State::COMPLETE_EVALUATED);
+    REQUIRE(to_vector(queue.eval_batch()) == std::vector{6});
+  }
+
+  TEST_CASE("queue_exception") {
+    auto queue = Queue<int>();
+    queue.push(1);
+    queue.set_complete(std::runtime_error(""));
+    REQUIRE(queue.commit_batch(0) == State::COMPLETE_EVALUATED);
+    auto batch = queue.eval_batch();
+    REQUIRE(batch.size() == 2);
+    REQUIRE(batch[0].get() == 1);
+    REQUIRE(batch.back().has_exception());
+    REQUIRE_THROWS_AS(queue.eval(), std::runtime_error);
+  }
+
+  TEST_CASE("lift") {
+    auto queue = Shared(Queue<int>());
+    auto calls = 0;
+    auto reactor = lift([&] (int value) {
+      ++calls;
+      return 10 * value;
+    }, queue);
+    for(auto i = 1; i <= 4; ++i) {
+      queue->push(i);
+    }
+    REQUIRE(reactor.commit_batch(0) == State::EVALUATED);
+    REQUIRE(calls == 4);
+    REQUIRE(to_vector(reactor.eval_batch()) == std::vector{10, 20, 30, 40});
+    REQUIRE(reactor.eval() == 40);
+    REQUIRE(reactor.commit_batch(1) == State::NONE);
+    queue->set_complete(5);
+    REQUIRE(reactor.commit_batch(2) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 50);
+  }
+
+  TEST_CASE("lift_filter") {
+    auto queue = Shared(Queue<int>());
+    auto reactor = lift([] (int value) -> std::optional<int> {
+      if(value % 2 == 0) {
+        return value;
+      }
+      return std::nullopt;
+    }, queue);
+    for(auto i = 1; i <= 5; ++i) {
+      queue->push(i);
+    }
+    REQUIRE(reactor.commit_batch(0) == State::EVALUATED);
+    REQUIRE(to_vector(reactor.eval_batch()) == std::vector{2, 4});
+    queue->push(7);
+    REQUIRE(reactor.commit_batch(1) == State::NONE);
+  }
+
+  TEST_CASE("count") {
+    auto queue = Shared(Queue<int>());
+    auto reactor = count(count(queue));
+    for(auto i = 0; i != 100; ++i) {
+      queue->push(i);
+    }
+    REQUIRE(reactor.commit_batch(0) == State::EVALUATED);
+    REQUIRE(reactor.eval_batch().size() == 100);
+    REQUIRE(reactor.eval() == 100);
+  }
+
+  TEST_CASE("lift_continuation") {
+    auto queue = Shared(Queue<int>());
+    auto calls = 0;
+    auto reactor = lift([&] (int value) -> FunctionEvaluation<int> {
+      ++calls;
+      if(value == 1) {
+        return FunctionEvaluation(value, State::CONTINUE);
+      }
+      return value;
+    }, queue);
+    queue->push(1);
+    queue->push(2);
+    REQUIRE(reactor.commit_batch(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(to_vector(reactor.eval_batch()) == std::vector{1, 2});
+    REQUIRE(calls == 2);
+  }
+
+  TEST_CASE("shared_mixed") {
+    auto queue = Shared(Queue<int>());
+    auto batched = queue;
+    auto sampled = queue;
+    queue->push(1);
+    queue->push(2);
+    queue->push(3);
+    REQUIRE(batched.commit_batch(0) == State::EVALUATED);
+    REQUIRE(sampled.commit(0) == State::EVALUATED);
+    REQUIRE(to_vector(batched.eval_batch()) == std::vector{1, 2, 3});
+    REQUIRE(sampled.eval() == 3);
+    queue->push(4);
+    queue->push(5);
+    REQUIRE(sampled.commit(1) == State::CONTINUE_EVALUATED);
+    REQUIRE(batched.commit_batch(1) == State::CONTINUE_EVALUATED);
+    REQUIRE(sampled.eval() == 4);
+    REQUIRE(to_vector(batched.eval_batch()) == std::vector{4});
+  }
+
+  TEST_CASE("executor_burst") {
+    auto queue = Shared(Queue<int>());
+    auto values = std::vector<int>();
+    auto executor = Executor(lift([&] (int value) {
+      values.push_back(value);
+    }, queue));
+    for(auto i = 0; i != 1000; ++i) {
+      queue->push(i);
+    }
+    executor.run_until_none();
+    REQUIRE(values.size() == 1000);
+    REQUIRE(values.back() == 999);
+    REQUIRE(executor.get_statistics().m_commits == 1);
+  }
+}
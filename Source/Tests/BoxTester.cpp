@@ -1,6 +1,12 @@
+#include <array>
+#include <type_traits>
+#include <vector>
 #include <doctest/doctest.h>
 #include "Aspen/Box.hpp"
 #include "Aspen/Constant.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
 
 using namespace Aspen;
 
@@ -23,4 +29,56 @@ TEST_SUITE("Box") {
     REQUIRE(box.commit(0) == State::COMPLETE_EVALUATED);
     REQUIRE_NOTHROW(box.eval());
   }
+
+  TEST_CASE("large_box") {
+    auto padding = std::array<int, 256>();
+    padding.back() = 100;
+    auto queue = Shared(Queue<int>());
+    auto box = Box(lift([=] (int value) {
+      return value + padding.back();
+    }, queue));
+    queue->push(5);
+    REQUIRE(box.commit(0) == State::EVALUATED);
+    REQUIRE(box.eval() == 105);
+  }
+
+  TEST_CASE("inline_size") {
+    REQUIRE(sizeof(Box<int>) <= 64);
+    REQUIRE(std::is_same_v<decltype(Box(Constant(1))), Box<int>>);
+    auto padding = std::array<int, 32>();
+    padding.back() = 100;
+    auto queue = Shared(Queue<int>());
+    auto box = Box<int, 256>(lift([=] (int value) {
+      return value + padding.back();
+    }, queue));
+    queue->push(5);
+    REQUIRE(box.commit(0) == State::EVALUATED);
+    REQUIRE(box.eval() == 105);
+    auto moved = std::move(box);
+    queue->push(6);
+    REQUIRE(moved.commit(1) == State::EVALUATED);
+    REQUIRE(moved.eval() == 106);
+    auto shared = Shared<Box<int>>(Constant(3));
+    REQUIRE(shared.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(shared.eval() == 3);
+  }
+
+  TEST_CASE("move_box") {
+    auto queue = Shared(Queue<int>());
+    auto boxes = std::vector<Box<int>>();
+    boxes.emplace_back(queue);
+    boxes.emplace_back(lift([=] (int value) {
+      return 2 * value;
+    }, queue));
+    boxes.emplace_back(Constant(7));
+    queue->push(5);
+    auto box = std::move(boxes.front());
+    REQUIRE(box.commit(0) == State::EVALUATED);
+    REQUIRE(box.eval() == 5);
+    box = std::move(boxes[1]);
+    REQUIRE(box.commit(0) == State::EVALUATED);
+    REQUIRE(box.eval() == 10);
+    REQUIRE(boxes.back().commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(boxes.back().eval() == 7);
+  }
 }
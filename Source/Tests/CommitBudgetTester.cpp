@@ -0,0 +1,40 @@
+#include <chrono>
+#include <thread>
+#include <doctest/doctest.h>
+#include "Aspen/CommitBudget.hpp"
+
+using namespace Aspen;
+using namespace Aspen::Details;
+using namespace std::chrono_literals;
+
+TEST_SUITE("CommitBudget") {
+  TEST_CASE("unlimited") {
+    auto budget = CommitBudget();
+    REQUIRE(budget.is_unlimited());
+    auto meter = BudgetMeter(budget);
+    for(auto i = 0; i != 1000; ++i) {
+      REQUIRE(!meter.consume());
+    }
+  }
+
+  TEST_CASE("commits") {
+    auto budget = CommitBudget(3);
+    REQUIRE(!budget.is_unlimited());
+    REQUIRE(budget.get_commits() == 3);
+    auto meter = BudgetMeter(budget);
+    REQUIRE(!meter.consume());
+    REQUIRE(!meter.consume());
+    REQUIRE(meter.consume());
+    meter.reset();
+    REQUIRE(!meter.consume());
+  }
+
+  TEST_CASE("duration") {
+    auto budget = CommitBudget(std::chrono::milliseconds(5));
+    REQUIRE(!budget.is_unlimited());
+    auto meter = BudgetMeter(budget);
+    REQUIRE(!meter.consume());
+    std::this_thread::sleep_for(10ms);
+    REQUIRE(meter.consume());
+  }
+}
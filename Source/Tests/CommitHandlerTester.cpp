@@ -1,3 +1,4 @@
+#include <vector>
 #include <doctest/doctest.h>
 #include "Aspen/CommitHandler.hpp"
 #include "Aspen/Queue.hpp"
@@ -5,6 +6,23 @@
 
 using namespace Aspen;
 
+namespace {
+  struct CountedQueue {
+    using Type = int;
+    Shared<Queue<int>> m_queue;
+    int* m_commits;
+
+    State commit(int sequence) noexcept {
+      ++*m_commits;
+      return m_queue.commit(sequence);
+    }
+
+    const int& eval() const {
+      return m_queue.eval();
+    }
+  };
+}
+
 TEST_SUITE("CommitHandler") {
   TEST_CASE("commit_empty_commit") {
     auto reactor = CommitHandler<Box<void>>({});
@@ -49,4 +67,84 @@ TEST_SUITE("CommitHandler") {
     REQUIRE(reactor.commit(1) == State::EVALUATED);
     REQUIRE(reactor.commit(2) == State::NONE);
   }
+
+  TEST_CASE("dirty_empty_and_evaluated") {
+    auto queue_a = Shared(Queue<int>());
+    auto queue_b = Shared(Queue<int>());
+    auto reactor = CommitHandler(std::vector{queue_a, queue_b},
+      CommitPolicy::DIRTY);
+    REQUIRE(reactor.commit(0) == State::NONE);
+    queue_a->push(123);
+    REQUIRE(reactor.commit(1) == State::NONE);
+    queue_b->push(321);
+    REQUIRE(reactor.commit(2) == State::EVALUATED);
+    REQUIRE(reactor.commit(3) == State::NONE);
+    queue_a->set_complete();
+    REQUIRE(reactor.commit(4) == State::NONE);
+    queue_b->set_complete();
+    REQUIRE(reactor.commit(5) == State::COMPLETE);
+  }
+
+  TEST_CASE("dirty_immediate_complete") {
+    auto queue_a = Shared(Queue<int>());
+    auto queue_b = Shared(Queue<int>());
+    auto reactor = CommitHandler(std::vector{queue_a, queue_b},
+      CommitPolicy::DIRTY);
+    REQUIRE(reactor.commit(0) == State::NONE);
+    queue_b->set_complete();
+    REQUIRE(reactor.commit(1) == State::COMPLETE);
+  }
+
+  TEST_CASE("dirty_continuation") {
+    auto queue = Shared(Queue<int>());
+    auto reactor = CommitHandler(std::vector{queue}, CommitPolicy::DIRTY);
+    queue->push(1);
+    queue->push(2);
+    REQUIRE(reactor.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.get(0).eval() == 1);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.get(0).eval() == 2);
+    REQUIRE(reactor.commit(2) == State::NONE);
+  }
+
+  TEST_CASE("dirty_copy") {
+    auto queue = Shared(Queue<int>());
+    auto reactor = CommitHandler(std::vector{queue}, CommitPolicy::DIRTY);
+    auto copy = reactor;
+    queue->push(1);
+    REQUIRE(copy.commit(0) == State::EVALUATED);
+    REQUIRE(copy.get(0).eval() == 1);
+    queue->push(2);
+    REQUIRE(copy.commit(1) == State::EVALUATED);
+    REQUIRE(copy.get(0).eval() == 2);
+    REQUIRE(copy.commit(2) == State::NONE);
+    reactor = copy;
+    queue->set_complete();
+    REQUIRE(is_complete(reactor.commit(3)));
+  }
+
+  TEST_CASE("dirty_fan_in") {
+    auto signals = 0;
+    auto trigger = Trigger([&] { ++signals; });
+    Trigger::set_trigger(trigger);
+    auto commits = 0;
+    auto queues = std::vector<Shared<Queue<int>>>();
+    auto children = std::vector<CountedQueue>();
+    for(auto i = 0; i != 1000; ++i) {
+      queues.emplace_back();
+      queues.back()->push(i);
+      children.push_back(CountedQueue{queues.back(), &commits});
+    }
+    auto reactor = CommitHandler(std::move(children), CommitPolicy::DIRTY);
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    REQUIRE(commits == 1000);
+    REQUIRE(reactor.commit(1) == State::NONE);
+    REQUIRE(commits == 1000);
+    queues[500]->push(7);
+    REQUIRE(signals == 1);
+    REQUIRE(reactor.commit(2) == State::EVALUATED);
+    REQUIRE(commits == 1001);
+    REQUIRE(reactor.get(500).eval() == 7);
+    Trigger::set_trigger(nullptr);
+  }
 }
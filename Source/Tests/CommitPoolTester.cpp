@@ -0,0 +1,45 @@
+#include <atomic>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/CommitPool.hpp"
+
+using namespace Aspen;
+
+TEST_SUITE("CommitPool") {
+  TEST_CASE("run") {
+    auto pool = CommitPool(4);
+    REQUIRE(pool.get_thread_count() == 4);
+    auto counts = std::vector<std::atomic_int>(1000);
+    pool.run(counts.size(), [&] (std::size_t i) noexcept {
+      ++counts[i];
+    });
+    for(auto& count : counts) {
+      REQUIRE(count == 1);
+    }
+  }
+
+  TEST_CASE("nested_run") {
+    auto pool = CommitPool(4);
+    auto total = std::atomic_int(0);
+    pool.run(8, [&] (std::size_t) noexcept {
+      pool.run(8, [&] (std::size_t) noexcept {
+        ++total;
+      });
+    });
+    REQUIRE(total == 64);
+  }
+
+  TEST_CASE("trigger") {
+    auto pool = CommitPool(4);
+    auto trigger = Trigger();
+    Trigger::set_trigger(trigger);
+    auto triggers = std::vector<Trigger*>(100);
+    pool.run(triggers.size(), [&] (std::size_t i) noexcept {
+      triggers[i] = Trigger::get_trigger();
+    });
+    for(auto t : triggers) {
+      REQUIRE(t == &trigger);
+    }
+    Trigger::set_trigger(nullptr);
+  }
+}
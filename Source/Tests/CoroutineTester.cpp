@@ -0,0 +1,126 @@
+#include <doctest/doctest.h>
+#include "Aspen/Coroutine.hpp"
+#if defined (__cpp_impl_coroutine)
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include "Aspen/Constant.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+
+using namespace Aspen;
+
+namespace {
+  Coroutine<int> count_to(int last) {
+    for(auto i = 1; i <= last; ++i) {
+      co_yield i;
+    }
+  }
+
+  Coroutine<int> running_sum(Shared<Queue<int>> queue) {
+    auto sum = 0;
+    while(true) {
+      sum += co_await queue;
+      co_yield sum;
+    }
+  }
+
+  Coroutine<int> alternate(Shared<Queue<int>> left,
+      Shared<Queue<int>> right) {
+    while(true) {
+      co_yield co_await left;
+      co_yield co_await right;
+    }
+  }
+
+  Coroutine<int> failing() {
+    co_yield 1;
+    throw std::runtime_error("Failed.");
+  }
+
+  Coroutine<int> await_constant() {
+    auto value = co_await constant(5);
+    co_yield value * 2;
+  }
+}
+
+TEST_SUITE("Coroutine") {
+  TEST_CASE("yield") {
+    auto reactor = count_to(3);
+    REQUIRE(reactor.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+    REQUIRE(reactor.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+    REQUIRE(reactor.commit(1) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 2);
+    REQUIRE(reactor.commit(2) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 3);
+    REQUIRE(reactor.commit(3) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 3);
+  }
+
+  TEST_CASE("await_queue") {
+    auto queue = Shared(Queue<int>());
+    auto reactor = running_sum(queue);
+    REQUIRE(reactor.commit(0) == State::NONE);
+    REQUIRE(reactor.commit(1) == State::NONE);
+    queue->push(3);
+    REQUIRE(reactor.commit(2) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 3);
+    queue->push(4);
+    queue->push(5);
+    REQUIRE(reactor.commit(3) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 7);
+    REQUIRE(reactor.commit(4) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 12);
+    REQUIRE(reactor.commit(5) == State::NONE);
+    REQUIRE(reactor.eval() == 12);
+  }
+
+  TEST_CASE("await_alternate") {
+    auto left = Shared(Queue<int>());
+    auto right = Shared(Queue<int>());
+    auto reactor = alternate(left, right);
+    left->push(1);
+    right->push(2);
+    REQUIRE(reactor.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+    REQUIRE(reactor.commit(1) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 2);
+    REQUIRE(reactor.commit(2) == State::NONE);
+  }
+
+  TEST_CASE("await_constant") {
+    auto reactor = await_constant();
+    REQUIRE(reactor.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 10);
+  }
+
+  TEST_CASE("exception") {
+    auto reactor = failing();
+    REQUIRE(reactor.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+    REQUIRE(reactor.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE_THROWS_AS(reactor.eval(), std::runtime_error);
+  }
+
+  TEST_CASE("frame_reuse") {
+    for(auto i = 0; i != 100; ++i) {
+      auto reactor = count_to(2);
+      REQUIRE(reactor.commit(0) == State::CONTINUE_EVALUATED);
+    }
+  }
+
+  TEST_CASE("thread_exit") {
+    auto value = 0;
+    auto thread = std::thread([&] {
+      thread_local auto reactor = std::optional<Coroutine<int>>();
+      reactor.emplace(count_to(2));
+      reactor->commit(0);
+      value = reactor->eval();
+    });
+    thread.join();
+    REQUIRE(value == 1);
+  }
+}
+#endif
@@ -0,0 +1,39 @@
+#include <doctest/doctest.h>
+#include "Aspen/Constant.hpp"
+#include "Aspen/Count.hpp"
+#include "Aspen/None.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+
+using namespace Aspen;
+
+TEST_SUITE("Count") {
+  TEST_CASE("count_constant") {
+    auto reactor = count(Constant(123));
+    REQUIRE(reactor.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+  }
+
+  TEST_CASE("count_none") {
+    auto reactor = count(None<int>());
+    REQUIRE(reactor.commit(0) == State::COMPLETE);
+  }
+
+  TEST_CASE("count_multiple") {
+    auto queue = Shared(Queue<int>());
+    auto reactor = count(queue);
+    REQUIRE(reactor.commit(0) == State::NONE);
+    queue->push(10);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+    queue->push(20);
+    queue->push(30);
+    REQUIRE(reactor.commit(2) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 2);
+    REQUIRE(reactor.commit(3) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 3);
+    queue->set_complete();
+    REQUIRE(reactor.commit(4) == State::COMPLETE);
+    REQUIRE(reactor.eval() == 3);
+  }
+}
@@ -0,0 +1,118 @@
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/CommitHandler.hpp"
+#include "Aspen/DirtyGuard.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+
+using namespace Aspen;
+
+namespace {
+  struct CountedQueue {
+    using Type = int;
+    Shared<Queue<int>> m_queue;
+    int* m_commits;
+
+    State commit(int sequence) noexcept {
+      ++*m_commits;
+      return m_queue.commit(sequence);
+    }
+
+    const int& eval() const {
+      return m_queue.eval();
+    }
+  };
+}
+
+TEST_SUITE("DirtyGuard") {
+  TEST_CASE("skip_clean") {
+    auto signals = 0;
+    auto trigger = Trigger([&] { ++signals; });
+    Trigger::set_trigger(trigger);
+    auto commits = 0;
+    auto queue = Shared(Queue<int>());
+    auto guard = dirty_guard(CountedQueue{queue, &commits});
+    REQUIRE(guard.commit(0) == State::NONE);
+    REQUIRE(commits == 1);
+    REQUIRE(!guard.is_dirty());
+    REQUIRE(guard.commit(1) == State::NONE);
+    REQUIRE(commits == 1);
+    queue->push(5);
+    REQUIRE(signals == 1);
+    REQUIRE(guard.is_dirty());
+    REQUIRE(guard.commit(2) == State::EVALUATED);
+    REQUIRE(guard.eval() == 5);
+    REQUIRE(commits == 2);
+    REQUIRE(guard.commit(3) == State::NONE);
+    REQUIRE(commits == 2);
+    Trigger::set_trigger(nullptr);
+  }
+
+  TEST_CASE("continuation") {
+    auto trigger = Trigger();
+    Trigger::set_trigger(trigger);
+    auto commits = 0;
+    auto queue = Shared(Queue<int>());
+    queue->push(1);
+    queue->push(2);
+    auto guard = dirty_guard(CountedQueue{queue, &commits});
+    REQUIRE(guard.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(guard.eval() == 1);
+    REQUIRE(guard.commit(1) == State::EVALUATED);
+    REQUIRE(guard.eval() == 2);
+    REQUIRE(commits == 2);
+    REQUIRE(guard.commit(2) == State::NONE);
+    REQUIRE(commits == 2);
+    queue->set_complete();
+    REQUIRE(guard.commit(3) == State::COMPLETE);
+    REQUIRE(guard.commit(4) == State::COMPLETE);
+    REQUIRE(commits == 3);
+    Trigger::set_trigger(nullptr);
+  }
+
+  TEST_CASE("nested") {
+    auto signals = 0;
+    auto trigger = Trigger([&] { ++signals; });
+    Trigger::set_trigger(trigger);
+    auto commits = 0;
+    auto queue = Shared(Queue<int>());
+    auto guard = dirty_guard(dirty_guard(CountedQueue{queue, &commits}));
+    REQUIRE(guard.commit(0) == State::NONE);
+    REQUIRE(guard.commit(1) == State::NONE);
+    REQUIRE(commits == 1);
+    queue->push(3);
+    REQUIRE(signals == 1);
+    REQUIRE(guard.commit(2) == State::EVALUATED);
+    REQUIRE(guard.eval() == 3);
+    REQUIRE(commits == 2);
+    Trigger::set_trigger(nullptr);
+  }
+
+  TEST_CASE("fan_in") {
+    const auto SOURCES = 1000;
+    auto trigger = Trigger();
+    Trigger::set_trigger(trigger);
+    auto commits = 0;
+    auto queues = std::vector<Shared<Queue<int>>>();
+    auto guards = std::vector<DirtyGuard<CountedQueue>>();
+    for(auto i = 0; i != SOURCES; ++i) {
+      queues.push_back(Shared(Queue<int>()));
+      queues.back()->push(i);
+      guards.push_back(dirty_guard(CountedQueue{queues.back(), &commits}));
+    }
+    auto handler = CommitHandler(std::move(guards));
+    REQUIRE(handler.commit(0) == State::EVALUATED);
+    REQUIRE(commits == SOURCES);
+    for(auto i = 1; i != 11; ++i) {
+      commits = 0;
+      queues[(37 * i) % SOURCES]->push(i);
+      REQUIRE(handler.commit(i) == State::EVALUATED);
+      REQUIRE(commits == 1);
+      REQUIRE(handler.get((37 * i) % SOURCES).eval() == i);
+    }
+    commits = 0;
+    REQUIRE(handler.commit(11) == State::NONE);
+    REQUIRE(commits == 0);
+    Trigger::set_trigger(nullptr);
+  }
+}
@@ -0,0 +1,115 @@
+#if defined (__linux__)
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <doctest/doctest.h>
+#include "Aspen/DirtyGuard.hpp"
+#include "Aspen/EpollExecutor.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/Timer.hpp"
+
+using namespace Aspen;
+using namespace std::chrono_literals;
+
+namespace {
+  FunctionEvaluation<int> read_int(int fd) {
+    auto value = 0;
+    auto result = ::read(fd, &value, sizeof(value));
+    if(result == sizeof(value)) {
+      return value;
+    } else if(result == 0) {
+      return State::COMPLETE;
+    }
+    return State::NONE;
+  }
+}
+
+TEST_SUITE("EpollExecutor") {
+  TEST_CASE("read_pipe") {
+    int fds[2];
+    REQUIRE(::pipe2(fds, O_NONBLOCK) == 0);
+    auto results = std::vector<int>();
+    auto executor = EpollExecutor(lift([&] (int value) {
+      results.push_back(value);
+    }, read_fd(fds[0], &read_int)));
+    auto executor_thread = std::thread([&] {
+      executor.run_until_complete();
+    });
+    for(auto i = 0; i != 100; ++i) {
+      auto result = ::write(fds[1], &i, sizeof(i));
+      REQUIRE(result == sizeof(i));
+    }
+    ::close(fds[1]);
+    executor_thread.join();
+    ::close(fds[0]);
+    REQUIRE(results.size() == 100);
+    for(auto i = 0; i != 100; ++i) {
+      REQUIRE(results[i] == i);
+    }
+  }
+
+  TEST_CASE("dirty_guard") {
+    int fds[2];
+    REQUIRE(::pipe2(fds, O_NONBLOCK) == 0);
+    auto results = std::vector<int>();
+    auto executor = EpollExecutor(lift([&] (int value) {
+      results.push_back(value);
+    }, dirty_guard(read_fd(fds[0], &read_int))));
+    auto executor_thread = std::thread([&] {
+      executor.run_until_complete();
+    });
+    for(auto i = 0; i != 10; ++i) {
+      auto result = ::write(fds[1], &i, sizeof(i));
+      REQUIRE(result == sizeof(i));
+    }
+    ::close(fds[1]);
+    executor_thread.join();
+    ::close(fds[0]);
+    REQUIRE(results.size() == 10);
+    for(auto i = 0; i != 10; ++i) {
+      REQUIRE(results[i] == i);
+    }
+  }
+
+  TEST_CASE("read_without_executor") {
+    int fds[2];
+    REQUIRE(::pipe2(fds, O_NONBLOCK) == 0);
+    auto reactor = read_fd(fds[0], &read_int);
+    REQUIRE(reactor.commit(0) == State::NONE);
+    auto value = 5;
+    REQUIRE(::write(fds[1], &value, sizeof(value)) == sizeof(value));
+    REQUIRE(reactor.commit(1) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 5);
+    REQUIRE(reactor.commit(2) == State::NONE);
+    ::close(fds[1]);
+    REQUIRE(reactor.commit(3) == State::COMPLETE);
+    ::close(fds[0]);
+  }
+
+  TEST_CASE("close") {
+    int fds[2];
+    REQUIRE(::pipe2(fds, O_NONBLOCK) == 0);
+    auto executor = EpollExecutor(read_fd(fds[0], &read_int));
+    auto executor_thread = std::thread([&] {
+      executor.run_until_complete();
+    });
+    executor.close();
+    executor_thread.join();
+    ::close(fds[1]);
+    ::close(fds[0]);
+  }
+
+  TEST_CASE("timer") {
+    auto results = std::vector<TimerWheel::TimePoint>();
+    auto start = TimerWheel::Clock::now();
+    auto executor = EpollExecutor(lift([&] (const auto& value) {
+      results.push_back(value);
+    }, timer(10ms)));
+    executor.run_until_complete();
+    REQUIRE(results.size() == 1);
+    REQUIRE(TimerWheel::Clock::now() - start >= 10ms);
+  }
+}
+#endif
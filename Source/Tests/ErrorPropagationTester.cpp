@@ -0,0 +1,163 @@
+#include <system_error>
+#include <tuple>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Aspen.hpp"
+
+using namespace Aspen;
+
+namespace {
+  auto make_io_error() {
+    return make_error(std::errc::io_error);
+  }
+
+  template<typename R>
+  void require_error(const R& reactor) {
+    REQUIRE(eval_error(reactor));
+    REQUIRE(try_eval(reactor).has_exception());
+#ifdef ASPEN_NO_EXCEPTIONS
+    REQUIRE(eval_error(reactor) == std::errc::io_error);
+#endif
+  }
+
+  template<typename R>
+  void require_commit_error(R&& reactor) {
+    REQUIRE(has_evaluation(reactor.commit(0)));
+    require_error(reactor);
+  }
+}
+
+TEST_SUITE("ErrorPropagation") {
+  TEST_CASE("lift_over_chain") {
+    auto reactor = lift([] (Maybe<int> a) {
+      return a.has_value() ? 1 : 2;
+    }, chain(Throw<int>(make_io_error()), constant(2)));
+    REQUIRE(reactor.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 2);
+    REQUIRE(reactor.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+  }
+
+  TEST_CASE("until") {
+    require_commit_error(until(constant(false), Throw<int>(make_io_error())));
+    auto reactor = until(Throw<bool>(make_io_error()), constant(1));
+    REQUIRE(reactor.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+  }
+
+  TEST_CASE("forwarding") {
+    require_commit_error(chain(Throw<int>(make_io_error()), constant(2)));
+    require_commit_error(group(Throw<int>(make_io_error()), constant(2)));
+    require_commit_error(
+      switch_(constant(true), Throw<int>(make_io_error())));
+    require_commit_error(when(constant(true), Throw<int>(make_io_error())));
+    require_commit_error(concat(constant(Throw<int>(make_io_error()))));
+    require_commit_error(concur(constant(Throw<int>(make_io_error()))));
+    require_commit_error(override(constant(Throw<int>(make_io_error()))));
+    require_commit_error(first(Throw<int>(make_io_error())));
+    require_commit_error(last(Throw<int>(make_io_error())));
+    require_commit_error(dirty_guard(Throw<int>(make_io_error())));
+    require_commit_error(box(Throw<int>(make_io_error())));
+    require_commit_error(box(Throw<int>(make_io_error()), EvalPolicy::LAZY));
+    require_commit_error(convert<EvalPolicy::EAGER>(
+      Throw<int>(make_io_error()), [] (int value) {
+        return value + 1;
+      }));
+    require_commit_error(convert<EvalPolicy::CACHED>(
+      Throw<int>(make_io_error()), [] (int value) {
+        return value + 1;
+      }));
+    require_commit_error(VariantBox<Throw<int>, Constant<int>>(
+      Throw<int>(make_io_error())));
+    require_commit_error(Unique(new Throw<int>(make_io_error())));
+    auto proxy = Proxy<Throw<int>>();
+    proxy.set_reactor(Throw<int>(make_io_error()));
+    require_commit_error(proxy);
+  }
+
+  TEST_CASE("producers") {
+    auto toggle = switch_(Throw<bool>(make_io_error()), constant(1));
+    REQUIRE(toggle.commit(0) == State::COMPLETE);
+    auto condition = when(Throw<bool>(make_io_error()), constant(1));
+    REQUIRE(condition.commit(0) == State::COMPLETE);
+    auto concatenation = concat(Throw<Constant<int>>(make_io_error()));
+    REQUIRE(concatenation.commit(0) == State::COMPLETE);
+    auto concurrence = concur(Throw<Constant<int>>(make_io_error()));
+    REQUIRE(concurrence.commit(0) == State::COMPLETE);
+    auto overriding = override(Throw<Constant<int>>(make_io_error()));
+    REQUIRE(overriding.commit(0) == State::COMPLETE);
+  }
+
+  TEST_CASE("shared") {
+    auto shared = Shared(Throw<int>(make_io_error()));
+    require_commit_error(shared);
+    auto weak = Weak(shared);
+    require_commit_error(weak);
+  }
+
+  TEST_CASE("fold") {
+    auto reactor = fold([] (int left, int right) {
+      return left + right;
+    }, chain(constant(1), Throw<int>(make_io_error())));
+    REQUIRE(reactor.commit(0) == State::CONTINUE);
+    REQUIRE(reactor.commit(1) == State::COMPLETE_EVALUATED);
+    require_error(reactor);
+  }
+
+  TEST_CASE("sync") {
+    auto value = 0;
+    auto sync = Sync(value, Throw<int>(make_io_error()));
+    require_commit_error(sync);
+    REQUIRE(value == 0);
+    auto record = std::tuple<int, int>(0, 0);
+    auto multi_sync = MultiSync(record,
+      Sync(std::get<0>(record), constant(1)),
+      Sync(std::get<1>(record), Throw<int>(make_io_error())));
+    require_commit_error(multi_sync);
+    auto list = std::vector<int>();
+    auto reactors = std::vector<Box<int>>();
+    reactors.push_back(box(Throw<int>(make_io_error())));
+    auto vector_sync = VectorSync(list, std::move(reactors));
+    require_commit_error(vector_sync);
+  }
+
+  TEST_CASE("timer") {
+    auto reactor = timer(std::chrono::milliseconds(1));
+    REQUIRE(reactor.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(eval_error(reactor));
+    REQUIRE(try_eval(reactor).has_exception());
+    auto period = interval(std::chrono::milliseconds(1));
+    REQUIRE(period.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(eval_error(period));
+  }
+
+  TEST_CASE("operators") {
+    auto error = Throw<int>(make_io_error());
+    require_commit_error(constant(1) + error);
+    require_commit_error(-(constant(1) - error * constant(2)));
+    require_commit_error(error / constant(1) % constant(3));
+    require_commit_error((error ^ constant(1)) & (constant(3) | error));
+    require_commit_error(~error << constant(1) >> constant(1));
+    require_commit_error(+error < constant(1));
+    require_commit_error(error <= constant(1));
+    require_commit_error(error == constant(1));
+    require_commit_error(error != constant(1));
+    require_commit_error(error >= constant(1));
+    require_commit_error(error > constant(1));
+    require_commit_error(!Throw<bool>(make_io_error()));
+    require_commit_error(Throw<bool>(make_io_error()) && constant(true));
+    require_commit_error(constant(false) || Throw<bool>(make_io_error()));
+    require_commit_error(range(constant(0), error));
+    require_commit_error(sample(error));
+  }
+
+  TEST_CASE("flat_graph") {
+    auto builder = FlatGraphBuilder();
+    auto a = builder.add(Throw<int>(make_io_error()));
+    auto b = builder.lift([] (int a) {
+      return a + 1;
+    }, a);
+    auto graph = builder.build(b);
+    require_commit_error(graph);
+  }
+}
@@ -0,0 +1,88 @@
+#include <stdexcept>
+#include <system_error>
+#include <doctest/doctest.h>
+#include "Aspen/Box.hpp"
+#include "Aspen/Error.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+#include "Aspen/Throw.hpp"
+
+using namespace Aspen;
+
+TEST_SUITE("Error") {
+  TEST_CASE("make_error") {
+    auto error = make_error(std::runtime_error("failed"));
+    REQUIRE(error);
+    REQUIRE_THROWS_AS(raise(error), std::runtime_error);
+    auto code = make_error(std::make_error_code(std::errc::invalid_argument));
+    auto result = std::error_code();
+    try {
+      raise(code);
+    } catch(const std::system_error& e) {
+      result = e.code();
+    }
+    REQUIRE(result == std::errc::invalid_argument);
+    REQUIRE_THROWS_AS(raise(make_error(std::errc::timed_out)),
+      std::system_error);
+    REQUIRE(make_error(error) == error);
+  }
+
+  TEST_CASE("current_error") {
+    REQUIRE(!current_error());
+    try {
+      throw std::runtime_error("failed");
+    } catch(...) {
+      auto maybe = Maybe<int>(current_error());
+      REQUIRE(maybe.has_exception());
+      REQUIRE_THROWS_AS(maybe.get(), std::runtime_error);
+    }
+  }
+
+  TEST_CASE("get_error") {
+    REQUIRE(has_error_v<Queue<int>>);
+    REQUIRE(has_error_v<Throw<int>>);
+    REQUIRE(has_error_v<Box<int>>);
+    REQUIRE(has_error_v<Shared<Queue<int>>>);
+    REQUIRE(!has_error_v<Constant<int>>);
+    auto queue = Shared(Queue<int>());
+    auto boxed = box(queue);
+    auto reactor = lift([] (int value) {
+      return value + 1;
+    }, queue);
+    queue->push(1);
+    REQUIRE(boxed.commit(0) == State::EVALUATED);
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    REQUIRE(!queue.get_error());
+    REQUIRE(!boxed.get_error());
+    REQUIRE(!reactor.get_error());
+    queue->set_complete(std::runtime_error("failed"));
+    REQUIRE(boxed.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE(queue.get_error());
+    REQUIRE(boxed.get_error() == queue.get_error());
+    REQUIRE(reactor.get_error());
+    REQUIRE_THROWS_AS(reactor.eval(), std::runtime_error);
+    REQUIRE(throws<int>(std::runtime_error("failed")).get_error());
+  }
+
+  TEST_CASE("error_parameters") {
+    auto plain = [] (int value, const Maybe<int>&) {
+      return value;
+    };
+    REQUIRE(!Details::is_error_parameter<decltype(plain), 0>::value);
+    REQUIRE(Details::is_error_parameter<decltype(plain), 1>::value);
+    auto generic = [] (const auto& value) {
+      return value;
+    };
+    REQUIRE(!Details::is_error_parameter<decltype(generic), 0>::value);
+    auto arguments = std::tuple<Maybe<int>, Maybe<int>>(
+      make_error(std::runtime_error("first")),
+      make_error(std::runtime_error("second")));
+    auto error = Details::find_error<decltype(plain)>(arguments);
+    REQUIRE(error == std::get<0>(arguments).get_exception());
+    auto skipped = std::tuple<Maybe<int>, Maybe<int>>(1,
+      make_error(std::runtime_error("second")));
+    REQUIRE(!Details::find_error<decltype(plain)>(skipped));
+  }
+}
@@ -0,0 +1,110 @@
+#include <stdexcept>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Box.hpp"
+#include "Aspen/Conversions.hpp"
+#include "Aspen/EvalPolicy.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+
+using namespace Aspen;
+
+namespace {
+  template<EvalPolicy P>
+  auto make_counter(Shared<Queue<int>> queue, int& calls) {
+    return convert<P>(std::move(queue), [&] (int value) {
+      ++calls;
+      if(value < 0) {
+        throw std::runtime_error("");
+      }
+      return 2 * value;
+    });
+  }
+}
+
+TEST_SUITE("EvalPolicy") {
+  TEST_CASE("lazy_conversion") {
+    auto queue = Shared(Queue<int>());
+    auto calls = 0;
+    auto reactor = make_counter<EvalPolicy::LAZY>(queue, calls);
+    queue->push(1);
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    REQUIRE(calls == 0);
+    REQUIRE(reactor.eval() == 2);
+    REQUIRE(reactor.eval() == 2);
+    REQUIRE(calls == 2);
+  }
+
+  TEST_CASE("eager_conversion") {
+    auto queue = Shared(Queue<int>());
+    auto calls = 0;
+    auto reactor = make_counter<EvalPolicy::EAGER>(queue, calls);
+    queue->push(1);
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    REQUIRE(calls == 1);
+    REQUIRE(reactor.eval() == 2);
+    REQUIRE(reactor.eval() == 2);
+    REQUIRE(calls == 1);
+    queue->push(-1);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(calls == 2);
+    REQUIRE_THROWS_AS(reactor.eval(), std::runtime_error);
+  }
+
+  TEST_CASE("cached_conversion") {
+    auto queue = Shared(Queue<int>());
+    auto calls = 0;
+    auto reactor = make_counter<EvalPolicy::CACHED>(queue, calls);
+    for(auto i = 0; i != 10; ++i) {
+      queue->push(i);
+      REQUIRE(reactor.commit(i) == State::EVALUATED);
+    }
+    REQUIRE(calls == 0);
+    REQUIRE(reactor.eval() == 18);
+    REQUIRE(reactor.eval() == 18);
+    REQUIRE(calls == 1);
+    REQUIRE(reactor.commit(10) == State::NONE);
+    REQUIRE(reactor.eval() == 18);
+    REQUIRE(calls == 1);
+    queue->push(-1);
+    REQUIRE(reactor.commit(11) == State::EVALUATED);
+    REQUIRE_THROWS_AS(reactor.eval(), std::runtime_error);
+    REQUIRE_THROWS_AS(reactor.eval(), std::runtime_error);
+    REQUIRE(calls == 2);
+  }
+
+  TEST_CASE("shared_cached_conversion") {
+    auto queue = Shared(Queue<int>());
+    auto calls = 0;
+    auto reactor = Shared(make_counter<EvalPolicy::CACHED>(queue, calls));
+    auto readers = std::vector<Shared<decltype(reactor)::Reactor>>(5,
+      reactor);
+    queue->push(3);
+    for(auto& reader : readers) {
+      REQUIRE(reader.commit(0) == State::EVALUATED);
+      REQUIRE(reader.eval() == 6);
+    }
+    REQUIRE(calls == 1);
+  }
+
+  TEST_CASE("box") {
+    auto queue = Shared(Queue<int>());
+    auto eager_calls = 0;
+    auto lazy_calls = 0;
+    auto eager = Box(make_counter<EvalPolicy::LAZY>(queue, eager_calls));
+    auto lazy = box(make_counter<EvalPolicy::LAZY>(queue, lazy_calls),
+      EvalPolicy::LAZY);
+    for(auto i = 0; i != 10; ++i) {
+      queue->push(i);
+      REQUIRE(eager.commit(i) == State::EVALUATED);
+      REQUIRE(lazy.commit(i) == State::EVALUATED);
+    }
+    REQUIRE(eager_calls == 10);
+    REQUIRE(lazy_calls == 0);
+    REQUIRE(eager.eval() == 18);
+    REQUIRE(lazy.eval() == 18);
+    REQUIRE(lazy.eval() == 18);
+    REQUIRE(eager_calls == 10);
+    REQUIRE(lazy_calls == 1);
+  }
+}
@@ -0,0 +1,142 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Constant.hpp"
+#include "Aspen/ExecutorPool.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+#include "Aspen/Timer.hpp"
+
+using namespace Aspen;
+using namespace std::chrono_literals;
+
+namespace {
+  struct Spinner {
+    using Type = void;
+    std::atomic_bool* m_is_done;
+
+    State commit(int) noexcept {
+      if(*m_is_done) {
+        return State::COMPLETE;
+      }
+      return State::CONTINUE_EVALUATED;
+    }
+
+    void eval() const noexcept {}
+  };
+}
+
+TEST_SUITE("ExecutorPool") {
+  TEST_CASE("constant") {
+    auto result = std::atomic_int(0);
+    auto pool = ExecutorPool(2);
+    pool.add(
+      lift([&] (const auto& value) {
+        result = value;
+      }, constant(5)));
+    pool.wait();
+    REQUIRE(result == 5);
+  }
+
+  TEST_CASE("many_queues") {
+    const auto GRAPH_COUNT = 64;
+    const auto VALUE_COUNT = 100;
+    auto queues = std::vector<Shared<Queue<int>>>();
+    auto results = std::vector<std::vector<int>>(GRAPH_COUNT);
+    auto pool = ExecutorPool(4);
+    for(auto i = 0; i != GRAPH_COUNT; ++i) {
+      queues.emplace_back(Queue<int>());
+      pool.add(
+        lift([&, i] (const auto& value) {
+          results[i].push_back(value);
+        }, queues.back()));
+    }
+    auto producers = std::vector<std::thread>();
+    for(auto i = 0; i != 2; ++i) {
+      producers.emplace_back([&, i] {
+        for(auto j = i; j < GRAPH_COUNT; j += 2) {
+          for(auto k = 0; k != VALUE_COUNT; ++k) {
+            queues[j]->push(k);
+          }
+          queues[j]->set_complete();
+        }
+      });
+    }
+    for(auto& producer : producers) {
+      producer.join();
+    }
+    pool.wait();
+    for(auto& result : results) {
+      REQUIRE(result.size() == VALUE_COUNT);
+      for(auto k = 0; k != VALUE_COUNT; ++k) {
+        REQUIRE(result[k] == k);
+      }
+    }
+  }
+
+  TEST_CASE("budget") {
+    auto is_done = std::atomic_bool(false);
+    auto pool = ExecutorPool(1, CommitBudget(16));
+    pool.add(Spinner{&is_done});
+    pool.add(
+      lift([&] (const auto&) {
+        is_done = true;
+      }, constant(5)));
+    pool.wait();
+    REQUIRE(is_done);
+  }
+
+  TEST_CASE("release_completed") {
+    auto pool = ExecutorPool(2);
+    auto token = std::make_shared<int>(0);
+    auto total = std::atomic_int(0);
+    for(auto i = 0; i != 100; ++i) {
+      pool.add(
+        lift([&, token] (const auto& value) {
+          total += value;
+        }, constant(1)));
+      pool.wait();
+      REQUIRE(token.use_count() == 1);
+    }
+    REQUIRE(total == 100);
+  }
+
+  TEST_CASE("timer") {
+    auto pool = ExecutorPool(2);
+    auto count = std::atomic_int(0);
+    auto start = TimerWheel::Clock::now();
+    for(auto i = 1; i <= 10; ++i) {
+      pool.add(
+        lift([&] (const auto&) {
+          ++count;
+        }, timer(i * 2ms)));
+    }
+    pool.wait();
+    REQUIRE(count == 10);
+    REQUIRE(TimerWheel::Clock::now() - start >= 20ms);
+  }
+
+  TEST_CASE("timer_with_updates") {
+    auto pool = ExecutorPool(2);
+    auto queue = Shared(Queue<int>());
+    auto expiry = std::atomic_bool(false);
+    pool.add(
+      lift([&] (const Maybe<int>&,
+          const Maybe<TimerWheel::TimePoint>& value) {
+        if(value.has_value()) {
+          expiry = true;
+        }
+      }, queue, timer(20ms)));
+    for(auto i = 0; i != 100; ++i) {
+      queue->push(i);
+      std::this_thread::yield();
+    }
+    queue->set_complete();
+    pool.wait();
+    REQUIRE(expiry);
+  }
+}
@@ -0,0 +1,150 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Constant.hpp"
+#include "Aspen/EpollExecutor.hpp"
+#include "Aspen/Executor.hpp"
+#include "Aspen/ExecutorPool.hpp"
+#include "Aspen/ExecutorStatistics.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/MultiplexExecutor.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+#include "Aspen/SimulatedExecutor.hpp"
+
+using namespace Aspen;
+using namespace Aspen::Details;
+using namespace std::chrono_literals;
+
+TEST_SUITE("ExecutorStatistics") {
+  TEST_CASE("recorder") {
+    auto recorder = StatisticsRecorder();
+    auto statistics = recorder.load();
+    REQUIRE(statistics.m_commits == 0);
+    REQUIRE(statistics.m_longest_chain == 0);
+    recorder.record_commit(State::CONTINUE_EVALUATED, 5ns);
+    recorder.record_commit(State::CONTINUE, 20ns);
+    recorder.record_commit(State::EVALUATED, 1ns);
+    recorder.record_wakeup(100ns);
+    recorder.record_commit(State::NONE, 1ns);
+    recorder.record_wakeup(50ns);
+    recorder.record_commit(State::EVALUATED, 1ns);
+    statistics = recorder.load();
+    REQUIRE(statistics.m_commits == 5);
+    REQUIRE(statistics.m_evaluations == 3);
+    REQUIRE(statistics.m_continuations == 2);
+    REQUIRE(statistics.m_wakeups == 2);
+    REQUIRE(statistics.m_spurious_wakeups == 1);
+    REQUIRE(statistics.m_commit_time == 28ns);
+    REQUIRE(statistics.m_idle_time == 150ns);
+    REQUIRE(statistics.m_longest_commit == 20ns);
+    REQUIRE(statistics.m_longest_chain == 3);
+  }
+
+  TEST_CASE("combine") {
+    auto left = ExecutorStatistics();
+    left.m_commits = 3;
+    left.m_longest_chain = 2;
+    left.m_longest_commit = 10ns;
+    auto right = ExecutorStatistics();
+    right.m_commits = 4;
+    right.m_longest_chain = 1;
+    right.m_longest_commit = 20ns;
+    left += right;
+    REQUIRE(left.m_commits == 7);
+    REQUIRE(left.m_longest_chain == 2);
+    REQUIRE(left.m_longest_commit == 20ns);
+  }
+
+  TEST_CASE("executor") {
+    auto queue = Shared(Queue<int>());
+    auto results = std::vector<int>();
+    auto executor = Executor(
+      lift([&] (const auto& value) {
+        results.push_back(value);
+      }, queue));
+    auto executor_thread = std::thread([&] {
+      executor.run_until_complete();
+    });
+    for(auto i = 0; i != 10; ++i) {
+      queue->push(i);
+      std::this_thread::sleep_for(1ms);
+    }
+    queue->set_complete();
+    executor_thread.join();
+    auto statistics = executor.get_statistics();
+    REQUIRE(statistics.m_commits >= 11);
+    REQUIRE(statistics.m_evaluations == 10);
+    REQUIRE(statistics.m_wakeups >= 1);
+    REQUIRE(statistics.m_idle_time > 0ns);
+  }
+
+  TEST_CASE("pool") {
+    auto pool = ExecutorPool(2);
+    for(auto i = 0; i != 8; ++i) {
+      pool.add(constant(i));
+    }
+    pool.wait();
+    auto statistics = pool.get_statistics();
+    REQUIRE(statistics.m_commits == 8);
+    REQUIRE(statistics.m_evaluations == 8);
+  }
+
+  TEST_CASE("multiplex") {
+    auto queue = Shared(Queue<int>());
+    auto executor = MultiplexExecutor();
+    for(auto i = 0; i != 4; ++i) {
+      executor.add(constant(i));
+    }
+    executor.add(queue);
+    executor.run_until_none();
+    auto statistics = executor.get_statistics();
+    REQUIRE(statistics.m_commits == 5);
+    REQUIRE(statistics.m_evaluations == 4);
+    auto executor_thread = std::thread([&] {
+      executor.run_until_complete();
+    });
+    std::this_thread::sleep_for(1ms);
+    queue->set_complete(5);
+    executor_thread.join();
+    statistics = executor.get_statistics();
+    REQUIRE(statistics.m_commits == 6);
+    REQUIRE(statistics.m_evaluations == 5);
+    REQUIRE(statistics.m_wakeups >= 1);
+    REQUIRE(statistics.m_longest_chain == 1);
+  }
+
+#if defined (__linux__)
+  TEST_CASE("epoll") {
+    auto queue = Shared(Queue<int>());
+    auto executor = EpollExecutor(queue);
+    auto executor_thread = std::thread([&] {
+      executor.run_until_complete();
+    });
+    std::this_thread::sleep_for(1ms);
+    queue->push(1);
+    std::this_thread::sleep_for(1ms);
+    queue->set_complete(2);
+    executor_thread.join();
+    auto statistics = executor.get_statistics();
+    REQUIRE(statistics.m_commits >= 3);
+    REQUIRE(statistics.m_evaluations == 2);
+    REQUIRE(statistics.m_wakeups >= 1);
+  }
+#endif
+
+  TEST_CASE("simulated") {
+    auto queue = Shared(Queue<int>());
+    auto executor = SimulatedExecutor(queue);
+    auto start = executor.get_time();
+    executor.schedule(start + 10ms, [&] { queue->push(1); });
+    executor.schedule(start + 30ms, [&] { queue->set_complete(2); });
+    executor.run_until_complete();
+    auto statistics = executor.get_statistics();
+    REQUIRE(statistics.m_commits == 3);
+    REQUIRE(statistics.m_evaluations == 2);
+    REQUIRE(statistics.m_wakeups == 2);
+    REQUIRE(statistics.m_idle_time == 30ms);
+  }
+}
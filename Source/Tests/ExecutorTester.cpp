@@ -1,15 +1,35 @@
+#include <chrono>
 #include <optional>
 #include <thread>
 #include <vector>
 #include <doctest/doctest.h>
+#include "Aspen/Chain.hpp"
 #include "Aspen/Constant.hpp"
 #include "Aspen/Executor.hpp"
 #include "Aspen/Lift.hpp"
 #include "Aspen/None.hpp"
 #include "Aspen/Queue.hpp"
 #include "Aspen/Shared.hpp"
+#include "Aspen/Timer.hpp"
 
 using namespace Aspen;
+using namespace std::chrono_literals;
+
+namespace {
+  struct Counter {
+    using Type = int;
+    int m_count;
+
+    State commit(int) noexcept {
+      ++m_count;
+      return State::CONTINUE_EVALUATED;
+    }
+
+    const int& eval() const noexcept {
+      return m_count;
+    }
+  };
+}
 
 TEST_SUITE("Executor") {
   TEST_CASE("run_until_none_empty") {
@@ -52,4 +72,60 @@ TEST_SUITE("Executor") {
     REQUIRE(results.size() == 5);
     REQUIRE(results == std::vector{10, 20, 30, 40, 100});
   }
+
+  TEST_CASE("run_until_complete_wait_strategies") {
+    for(auto strategy : {WaitStrategy::BLOCK, WaitStrategy::SPIN,
+        WaitStrategy::YIELD, WaitStrategy::PARK}) {
+      auto queue = Shared(Queue<int>());
+      auto results = std::vector<int>();
+      auto executor = Executor(
+        lift([&] (const auto& value) {
+          results.push_back(value);
+        }, queue), strategy);
+      auto executor_thread = std::thread([&] {
+        executor.run_until_complete();
+      });
+      for(auto i = 0; i != 1000; ++i) {
+        queue->push(i);
+        if(i % 100 == 0) {
+          std::this_thread::yield();
+        }
+      }
+      queue->set_complete();
+      executor_thread.join();
+      REQUIRE(results.size() == 1000);
+      for(auto i = 0; i != 1000; ++i) {
+        REQUIRE(results[i] == i);
+      }
+    }
+  }
+
+  TEST_CASE("run_until_none_budget") {
+    auto count = 0;
+    auto executor = Executor(
+      lift([&] (int value) {
+        count = value;
+      }, Counter{0}), WaitStrategy::BLOCK, CommitBudget(10));
+    executor.run_until_none();
+    REQUIRE(count == 10);
+    executor.run_until_none();
+    REQUIRE(count == 20);
+  }
+
+  TEST_CASE("timer_after_idle") {
+    auto queue = Shared(Queue<TimerWheel::TimePoint>());
+    auto result = std::optional<TimerWheel::TimePoint>();
+    auto executor = Executor(
+      lift([&] (const auto& value) {
+        result = value;
+      }, chain(queue, timer(50ms))));
+    executor.run_until_none();
+    std::this_thread::sleep_for(100ms);
+    auto start = TimerWheel::Clock::now();
+    queue->set_complete();
+    executor.run_until_complete();
+    REQUIRE(result.has_value());
+    REQUIRE(*result >= start + 49ms);
+    REQUIRE(TimerWheel::Clock::now() >= *result);
+  }
 }
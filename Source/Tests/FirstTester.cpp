@@ -27,4 +27,15 @@ TEST_SUITE("First") {
     REQUIRE(reactor.commit(1) == State::COMPLETE_EVALUATED);
     REQUIRE(reactor.eval() == 10);
   }
+
+  TEST_CASE("first_shared_source") {
+    auto queue = Shared(Queue<int>());
+    auto reactor = first(queue);
+    auto other = queue;
+    queue->push(10);
+    REQUIRE(reactor.commit(0) == State::COMPLETE_EVALUATED);
+    queue->push(20);
+    REQUIRE(other.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 10);
+  }
 }
@@ -0,0 +1,215 @@
+#include <stdexcept>
+#include <doctest/doctest.h>
+#include "Aspen/FlatGraph.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+
+using namespace Aspen;
+
+TEST_SUITE("FlatGraph") {
+  TEST_CASE("constant") {
+    auto builder = FlatGraphBuilder();
+    auto a = builder.add(3);
+    auto b = builder.add(4);
+    auto c = builder.lift([] (int a, int b) {
+      return a * b;
+    }, a, b);
+    auto graph = builder.build(c);
+    REQUIRE(graph.get_node_count() == 3);
+    REQUIRE(graph.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(graph.eval() == 12);
+  }
+
+  TEST_CASE("diamond") {
+    auto queue = Shared(Queue<int>());
+    auto calls = 0;
+    auto builder = FlatGraphBuilder();
+    auto x = builder.add(queue);
+    auto left = builder.lift([] (int x) {
+      return x + 1;
+    }, x);
+    auto right = builder.lift([] (int x) {
+      return 2 * x;
+    }, x);
+    auto sum = builder.lift([&] (int left, int right) {
+      ++calls;
+      return left + right;
+    }, left, right);
+    auto graph = builder.build(sum);
+    REQUIRE(graph.commit(0) == State::NONE);
+    queue->push(1);
+    REQUIRE(graph.commit(1) == State::EVALUATED);
+    REQUIRE(graph.eval() == 4);
+    REQUIRE(calls == 1);
+    queue->push(2);
+    queue->push(3);
+    REQUIRE(graph.commit(2) == State::CONTINUE_EVALUATED);
+    REQUIRE(graph.eval() == 7);
+    REQUIRE(graph.commit(3) == State::EVALUATED);
+    REQUIRE(graph.eval() == 10);
+    REQUIRE(graph.commit(4) == State::NONE);
+    REQUIRE(calls == 3);
+    queue->set_complete();
+    REQUIRE(graph.commit(5) == State::COMPLETE);
+  }
+
+  TEST_CASE("filter") {
+    auto queue = Shared(Queue<int>());
+    auto builder = FlatGraphBuilder();
+    auto even = builder.lift([] (int x) -> std::optional<int> {
+      if(x % 2 == 0) {
+        return x;
+      }
+      return std::nullopt;
+    }, builder.add(queue));
+    auto graph = builder.build(even);
+    queue->push(1);
+    REQUIRE(graph.commit(0) == State::NONE);
+    queue->set_complete(2);
+    REQUIRE(graph.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE(graph.eval() == 2);
+  }
+
+  TEST_CASE("exception") {
+    auto queue = Shared(Queue<int>());
+    auto builder = FlatGraphBuilder();
+    auto checked = builder.lift([] (int x) {
+      if(x < 0) {
+        throw std::runtime_error("");
+      }
+      return x;
+    }, builder.add(queue));
+    auto doubled = builder.lift([] (const Maybe<int>& x) {
+      if(x.has_exception()) {
+        return -1;
+      }
+      return 2 * *x;
+    }, checked);
+    auto graph = builder.build(doubled);
+    queue->push(-5);
+    REQUIRE(graph.commit(0) == State::EVALUATED);
+    REQUIRE(graph.eval() == -1);
+    queue->push(5);
+    REQUIRE(graph.commit(1) == State::EVALUATED);
+    REQUIRE(graph.eval() == 10);
+  }
+
+  TEST_CASE("unwrap_error") {
+    auto queue = Shared(Queue<int>());
+    auto calls = 0;
+    auto builder = FlatGraphBuilder();
+    auto checked = builder.lift([] (int x) {
+      if(x < 0) {
+        throw std::runtime_error("");
+      }
+      return x;
+    }, builder.add(queue));
+    auto doubled = builder.lift([&] (int x) {
+      ++calls;
+      return 2 * x;
+    }, checked);
+    auto graph = builder.build(doubled);
+    queue->push(-5);
+    REQUIRE(graph.commit(0) == State::EVALUATED);
+    REQUIRE_THROWS_AS(graph.eval(), std::runtime_error);
+    REQUIRE(calls == 0);
+    queue->push(5);
+    REQUIRE(graph.commit(1) == State::EVALUATED);
+    REQUIRE(graph.eval() == 10);
+    REQUIRE(calls == 1);
+  }
+
+  TEST_CASE("skip_unchanged") {
+    auto left_queue = Shared(Queue<int>());
+    auto right_queue = Shared(Queue<int>());
+    auto left_calls = 0;
+    auto right_calls = 0;
+    auto builder = FlatGraphBuilder();
+    auto left = builder.lift([&] (int x) {
+      ++left_calls;
+      return x;
+    }, builder.add(left_queue));
+    auto right = builder.lift([&] (int x) {
+      ++right_calls;
+      return x;
+    }, builder.add(right_queue));
+    auto sum = builder.lift([] (int left, int right) {
+      return left + right;
+    }, left, right);
+    auto graph = builder.build(sum);
+    left_queue->push(1);
+    right_queue->push(2);
+    REQUIRE(graph.commit(0) == State::EVALUATED);
+    REQUIRE(graph.eval() == 3);
+    left_queue->push(10);
+    REQUIRE(graph.commit(1) == State::EVALUATED);
+    REQUIRE(graph.eval() == 12);
+    REQUIRE(graph.commit(2) == State::NONE);
+    REQUIRE(left_calls == 2);
+    REQUIRE(right_calls == 1);
+    right_queue->set_complete();
+    REQUIRE(graph.commit(3) == State::NONE);
+    left_queue->set_complete();
+    REQUIRE(graph.commit(4) == State::COMPLETE);
+  }
+
+  TEST_CASE("self_continuation") {
+    auto calls = 0;
+    auto builder = FlatGraphBuilder();
+    auto counter = builder.lift([&] (int x) {
+      ++calls;
+      if(calls < 3) {
+        return FunctionEvaluation<int>(x * calls, State::CONTINUE);
+      }
+      return FunctionEvaluation<int>(x * calls);
+    }, builder.add(2));
+    auto graph = builder.build(counter);
+    REQUIRE(graph.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(graph.eval() == 2);
+    REQUIRE(graph.commit(1) == State::CONTINUE_EVALUATED);
+    REQUIRE(graph.eval() == 4);
+    REQUIRE(graph.commit(2) == State::COMPLETE_EVALUATED);
+    REQUIRE(graph.eval() == 6);
+    REQUIRE(calls == 3);
+  }
+
+  TEST_CASE("deep_chain") {
+    const auto DEPTH = 1000;
+    auto queue = Shared(Queue<int>());
+    auto builder = FlatGraphBuilder();
+    auto node = builder.add(queue);
+    for(auto i = 0; i != DEPTH; ++i) {
+      node = builder.lift([] (int x) {
+        return x + 1;
+      }, node);
+    }
+    auto graph = builder.build(node);
+    REQUIRE(graph.get_node_count() == DEPTH + 1);
+    queue->push(0);
+    REQUIRE(graph.commit(0) == State::EVALUATED);
+    REQUIRE(graph.eval() == DEPTH);
+    auto moved = std::move(graph);
+    queue->push(10);
+    REQUIRE(moved.commit(1) == State::EVALUATED);
+    REQUIRE(moved.eval() == DEPTH + 10);
+  }
+
+  TEST_CASE("foreign_node") {
+    auto builder = FlatGraphBuilder();
+    auto other = FlatGraphBuilder();
+    auto a = builder.add(1);
+    auto b = other.add(2);
+    auto increment = [] (int x) {
+      return x + 1;
+    };
+    REQUIRE_THROWS_AS(other.lift(increment, a), std::runtime_error);
+    REQUIRE_THROWS_AS(other.build(a), std::runtime_error);
+    auto graph = builder.build(a);
+    REQUIRE_THROWS_AS(builder.lift(increment, a), std::runtime_error);
+    REQUIRE_THROWS_AS(builder.build(a), std::runtime_error);
+    auto c = other.lift(increment, b);
+    auto other_graph = other.build(c);
+    REQUIRE(other_graph.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(other_graph.eval() == 3);
+  }
+}
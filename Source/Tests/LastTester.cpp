@@ -46,4 +46,16 @@ TEST_SUITE("Last") {
     REQUIRE(reactor.commit(4) == State::COMPLETE_EVALUATED);
     REQUIRE(reactor.eval() == 30);
   }
+
+  TEST_CASE("last_continuation") {
+    auto queue = Shared(Queue<int>());
+    auto reactor = last(queue);
+    queue->push(10);
+    queue->push(20);
+    REQUIRE(reactor.commit(0) == State::CONTINUE);
+    REQUIRE(reactor.commit(1) == State::NONE);
+    queue->set_complete();
+    REQUIRE(reactor.commit(2) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 20);
+  }
 }
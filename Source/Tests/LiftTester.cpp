@@ -1,3 +1,5 @@
+#include <bitset>
+#include <vector>
 #include <doctest/doctest.h>
 #include "Aspen/Constant.hpp"
 #include "Aspen/Lift.hpp"
@@ -67,4 +69,44 @@ TEST_SUITE("Lift") {
     REQUIRE(reactor.commit(1) == State::COMPLETE_EVALUATED);
     REQUIRE(reactor.eval() == 100);
   }
+
+  TEST_CASE("masked_lift") {
+    auto masks = std::vector<std::bitset<2>>();
+    auto left = Shared(Queue<int>());
+    auto right = Shared(Queue<int>());
+    auto reactor = masked_lift(
+      [&] (const std::bitset<2>& mask, int a, int b) {
+        masks.push_back(mask);
+        return a + b;
+      }, left, right);
+    left->push(1);
+    right->push(2);
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 3);
+    left->push(10);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 12);
+    right->push(20);
+    REQUIRE(reactor.commit(2) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 30);
+    REQUIRE(masks == std::vector<std::bitset<2>>{std::bitset<2>("11"),
+      std::bitset<2>("01"), std::bitset<2>("10")});
+  }
+
+  TEST_CASE("masked_lift_first_invocation") {
+    auto masks = std::vector<std::bitset<2>>();
+    auto left = Shared(Queue<int>());
+    auto reactor = masked_lift(
+      [&] (const std::bitset<2>& mask, int a, int b) {
+        masks.push_back(mask);
+        return a + b;
+      }, left, constant(5));
+    left->push(1);
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    left->push(2);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 7);
+    REQUIRE(masks == std::vector<std::bitset<2>>{std::bitset<2>("11"),
+      std::bitset<2>("01")});
+  }
 }
@@ -0,0 +1,171 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Constant.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/MultiplexExecutor.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+#include "Aspen/Timer.hpp"
+
+using namespace Aspen;
+using namespace std::chrono_literals;
+
+namespace {
+  struct CommitCounter {
+    using Type = int;
+    Shared<Queue<int>> m_queue;
+    int* m_commits;
+
+    State commit(int sequence) noexcept {
+      ++*m_commits;
+      return m_queue.commit(sequence);
+    }
+
+    const int& eval() const {
+      return m_queue.eval();
+    }
+  };
+}
+
+TEST_SUITE("MultiplexExecutor") {
+  TEST_CASE("empty") {
+    auto executor = MultiplexExecutor();
+    executor.run_until_none();
+    executor.run_until_complete();
+    REQUIRE(executor.get_size() == 0);
+  }
+
+  TEST_CASE("constant") {
+    auto executor = MultiplexExecutor();
+    auto results = std::vector<int>();
+    for(auto i = 0; i != 3; ++i) {
+      executor.add(lift([&] (int value) {
+        results.push_back(value);
+      }, constant(i)));
+    }
+    REQUIRE(executor.get_size() == 3);
+    executor.run_until_complete();
+    REQUIRE(results == std::vector{0, 1, 2});
+    REQUIRE(executor.get_size() == 0);
+  }
+
+  TEST_CASE("commit_ready_only") {
+    const auto COUNT = 1000;
+    auto executor = MultiplexExecutor();
+    auto queues = std::vector<Shared<Queue<int>>>();
+    auto commits = std::vector<int>(COUNT, 0);
+    auto results = std::vector<int>(COUNT, 0);
+    for(auto i = 0; i != COUNT; ++i) {
+      queues.emplace_back(Queue<int>());
+      executor.add(lift([&, i] (int value) {
+        results[i] += value;
+      }, CommitCounter{queues.back(), &commits[i]}));
+    }
+    executor.run_until_none();
+    for(auto i = 0; i != COUNT; ++i) {
+      REQUIRE(commits[i] == 1);
+    }
+    queues[5]->push(10);
+    queues[700]->push(20);
+    executor.run_until_none();
+    for(auto i = 0; i != COUNT; ++i) {
+      if(i == 5 || i == 700) {
+        REQUIRE(commits[i] == 2);
+      } else {
+        REQUIRE(commits[i] == 1);
+      }
+    }
+    REQUIRE(results[5] == 10);
+    REQUIRE(results[700] == 20);
+  }
+
+  TEST_CASE("remove") {
+    auto executor = MultiplexExecutor();
+    auto queue = Shared(Queue<int>());
+    auto results = std::vector<int>();
+    auto id = executor.add(lift([&] (int value) {
+      results.push_back(value);
+    }, queue));
+    queue->push(1);
+    executor.run_until_none();
+    executor.remove(id);
+    REQUIRE(executor.get_size() == 0);
+    queue->push(2);
+    executor.run_until_complete();
+    REQUIRE(results == std::vector{1});
+  }
+
+  TEST_CASE("push_after_remove") {
+    auto executor = MultiplexExecutor();
+    auto queue_a = Shared(Queue<int>());
+    auto results_a = std::vector<int>();
+    auto id = executor.add(lift([&] (int value) {
+      results_a.push_back(value);
+    }, queue_a));
+    queue_a->push(1);
+    executor.run_until_none();
+    executor.remove(id);
+    executor.run_until_none();
+    queue_a->push(2);
+    executor.run_until_none();
+    REQUIRE(results_a == std::vector{1});
+    auto queue_b = Shared(Queue<int>());
+    auto results_b = std::vector<int>();
+    executor.add(lift([&] (int value) {
+      results_b.push_back(value);
+    }, queue_b));
+    executor.run_until_none();
+    queue_a->push(3);
+    queue_b->push(4);
+    executor.run_until_none();
+    REQUIRE(results_a == std::vector{1});
+    REQUIRE(results_b == std::vector{4});
+  }
+
+  TEST_CASE("run_until_complete") {
+    auto executor = MultiplexExecutor();
+    auto queue_a = Shared(Queue<int>());
+    auto queue_b = Shared(Queue<int>());
+    auto results_a = std::vector<int>();
+    auto results_b = std::vector<int>();
+    executor.add(lift([&] (int value) {
+      results_a.push_back(value);
+    }, queue_a));
+    executor.add(lift([&] (int value) {
+      results_b.push_back(value);
+    }, queue_b));
+    auto executor_thread = std::thread([&] {
+      executor.run_until_complete();
+    });
+    for(auto i = 0; i != 100; ++i) {
+      queue_a->push(i);
+      queue_b->push(-i);
+    }
+    queue_a->set_complete();
+    queue_b->set_complete();
+    executor_thread.join();
+    REQUIRE(results_a.size() == 100);
+    REQUIRE(results_b.size() == 100);
+    for(auto i = 0; i != 100; ++i) {
+      REQUIRE(results_a[i] == i);
+      REQUIRE(results_b[i] == -i);
+    }
+  }
+
+  TEST_CASE("timer") {
+    auto executor = MultiplexExecutor();
+    auto results = std::vector<int>();
+    auto start = TimerWheel::Clock::now();
+    executor.add(lift([&] (const auto&) {
+      results.push_back(1);
+    }, timer(10ms)));
+    executor.add(lift([&] (const auto&) {
+      results.push_back(2);
+    }, timer(5ms)));
+    executor.run_until_complete();
+    REQUIRE(results == std::vector{2, 1});
+    REQUIRE(TimerWheel::Clock::now() - start >= 10ms);
+  }
+}
@@ -1,10 +1,20 @@
+#include <stdexcept>
 #include <doctest/doctest.h>
 #include "Aspen/Constant.hpp"
 #include "Aspen/Operators.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
 
 using namespace Aspen;
 
 namespace {
+  template<typename T>
+  struct argument_count;
+
+  template<typename F, typename... A>
+  struct argument_count<Lift<F, A...>> :
+    std::integral_constant<std::size_t, sizeof...(A)> {};
+
   template<typename T, typename U>
   void require(T&& reactor, const U& value) {
     auto state = reactor.commit(0);
@@ -49,4 +59,65 @@ TEST_SUITE("Operators") {
     require(Constant<bool>(true) || constant(false), true);
     require(Constant<bool>(false) || constant(false), false);
   }
+
+  TEST_CASE("fusion") {
+    auto a = Shared(Queue<int>());
+    auto b = Shared(Queue<int>());
+    auto c = Shared(Queue<int>());
+    auto d = Shared(Queue<int>());
+    auto reactor = -(a + b * c - d);
+    REQUIRE(argument_count<decltype(reactor)>::value == 4);
+    a->push(1);
+    b->push(2);
+    c->push(3);
+    d->push(4);
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    REQUIRE(reactor.eval() == -3);
+    c->push(10);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == -17);
+    REQUIRE(reactor.commit(2) == State::NONE);
+  }
+
+  TEST_CASE("fusion_lvalues") {
+    auto x = Shared(Queue<int>());
+    auto square = x * x;
+    auto polynomial = square * x + square + x;
+    REQUIRE(argument_count<decltype(polynomial)>::value == 6);
+    x->push(2);
+    REQUIRE(square.commit(0) == State::EVALUATED);
+    REQUIRE(square.eval() == 4);
+    REQUIRE(polynomial.commit(0) == State::EVALUATED);
+    REQUIRE(polynomial.eval() == 14);
+  }
+
+  TEST_CASE("fusion_noexcept") {
+    REQUIRE(is_noexcept_reactor_v<decltype(
+      constant(1) + constant(2) * constant(3))>);
+    REQUIRE(!is_noexcept_reactor_v<decltype(
+      Shared(Queue<int>()) + constant(2))>);
+  }
+
+  TEST_CASE("fusion_exception") {
+    auto x = Shared(Queue<int>());
+    auto reactor = (x + constant(1)) * constant(2) < constant(100);
+    x->set_complete(std::runtime_error(""));
+    REQUIRE(reactor.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE_THROWS_AS(reactor.eval(), std::runtime_error);
+  }
+
+  TEST_CASE("constant_folding") {
+    auto folded = -(constant(2) * constant(3) + constant(1));
+    REQUIRE(std::is_same_v<decltype(folded), Constant<int>>);
+    REQUIRE(folded.eval() == -7);
+    auto x = Shared(Queue<int>());
+    auto mixed = x * (constant(2) + constant(3)) - constant(1);
+    REQUIRE(argument_count<decltype(mixed)>::value == 3);
+    x->push(4);
+    REQUIRE(mixed.commit(0) == State::EVALUATED);
+    REQUIRE(mixed.eval() == 19);
+    x->set_complete(1);
+    REQUIRE(mixed.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE(mixed.eval() == 4);
+  }
 }
@@ -0,0 +1,50 @@
+#include <doctest/doctest.h>
+#include "Aspen/Box.hpp"
+#include "Aspen/Constant.hpp"
+#include "Aspen/None.hpp"
+#include "Aspen/Override.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+
+using namespace Aspen;
+
+TEST_SUITE("Override") {
+  TEST_CASE("override_none") {
+    auto reactor = override(None<SharedBox<int>>());
+    REQUIRE(reactor.commit(0) == State::COMPLETE);
+  }
+
+  TEST_CASE("override_single") {
+    auto reactor = override(constant(shared_box(constant(5))));
+    REQUIRE(reactor.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 5);
+  }
+
+  TEST_CASE("override_replaces_child") {
+    auto producer = Shared(Queue<SharedBox<int>>());
+    auto first = Shared(Queue<int>());
+    auto second = Shared(Queue<int>());
+    auto reactor = override(producer);
+    REQUIRE(reactor.commit(0) == State::NONE);
+    producer->push(shared_box(first));
+    first->push(1);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+    first->push(2);
+    REQUIRE(reactor.commit(2) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 2);
+    producer->push(shared_box(second));
+    first->push(3);
+    REQUIRE(reactor.commit(3) == State::NONE);
+    REQUIRE(reactor.eval() == 2);
+    second->push(10);
+    first->push(4);
+    REQUIRE(reactor.commit(4) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 10);
+    producer->set_complete();
+    REQUIRE(reactor.commit(5) == State::NONE);
+    second->set_complete(20);
+    REQUIRE(reactor.commit(6) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 20);
+  }
+}
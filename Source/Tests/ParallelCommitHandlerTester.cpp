@@ -0,0 +1,181 @@
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Constant.hpp"
+#include "Aspen/ParallelCommitHandler.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+#include "Aspen/Timer.hpp"
+
+using namespace Aspen;
+
+namespace {
+  struct SlowQueue {
+    using Type = int;
+    Shared<Queue<int>> m_queue;
+    std::mutex* m_mutex;
+    std::set<std::thread::id>* m_threads;
+
+    State commit(int sequence) noexcept {
+      {
+        auto lock = std::lock_guard(*m_mutex);
+        m_threads->insert(std::this_thread::get_id());
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return m_queue.commit(sequence);
+    }
+
+    const int& eval() const {
+      return m_queue.eval();
+    }
+  };
+
+  struct SlowTimer {
+    using Type = Timer::Type;
+    Timer m_timer;
+    std::mutex* m_mutex;
+    std::set<std::thread::id>* m_threads;
+
+    State commit(int sequence) noexcept {
+      {
+        auto lock = std::lock_guard(*m_mutex);
+        m_threads->insert(std::this_thread::get_id());
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return m_timer.commit(sequence);
+    }
+
+    const Type& eval() const {
+      return m_timer.eval();
+    }
+  };
+}
+
+TEST_SUITE("ParallelCommitHandler") {
+  TEST_CASE("commit") {
+    auto pool = CommitPool(4);
+    auto mutex = std::mutex();
+    auto threads = std::set<std::thread::id>();
+    auto queues = std::vector<Shared<Queue<int>>>();
+    auto children = std::vector<SlowQueue>();
+    for(auto i = 0; i != 16; ++i) {
+      queues.emplace_back();
+      children.push_back(SlowQueue{queues.back(), &mutex, &threads});
+    }
+    auto handler = ParallelCommitHandler(
+      ParallelCommit(pool, 2, std::chrono::microseconds(1)),
+      std::move(children));
+    REQUIRE(handler.commit(0) == State::NONE);
+    REQUIRE(threads.size() == 1);
+    for(auto& queue : queues) {
+      queue->push(1);
+    }
+    REQUIRE(handler.commit(1) == State::EVALUATED);
+    REQUIRE(threads.size() > 1);
+    queues.front()->push(2);
+    REQUIRE(handler.commit(2) == State::EVALUATED);
+    REQUIRE(handler.get(0).eval() == 2);
+    REQUIRE(handler.commit(3) == State::NONE);
+    for(auto& queue : queues) {
+      queue->set_complete();
+    }
+    REQUIRE(handler.commit(4) == State::COMPLETE);
+  }
+
+  TEST_CASE("below_threshold") {
+    auto pool = CommitPool(4);
+    auto mutex = std::mutex();
+    auto threads = std::set<std::thread::id>();
+    auto queues = std::vector<Shared<Queue<int>>>();
+    auto children = std::vector<SlowQueue>();
+    for(auto i = 0; i != 4; ++i) {
+      queues.emplace_back();
+      queues.back()->push(i);
+      children.push_back(SlowQueue{queues.back(), &mutex, &threads});
+    }
+    auto handler = ParallelCommitHandler(
+      ParallelCommit(pool, 2, std::chrono::hours(1)), std::move(children));
+    REQUIRE(handler.commit(0) == State::EVALUATED);
+    REQUIRE(handler.commit(1) == State::NONE);
+    REQUIRE(threads.size() == 1);
+  }
+
+  TEST_CASE("static_commit") {
+    auto pool = CommitPool(4);
+    auto mutex = std::mutex();
+    auto threads = std::set<std::thread::id>();
+    auto a = Shared(Queue<int>());
+    auto b = Shared(Queue<int>());
+    auto handler = ParallelStaticCommitHandler(
+      ParallelCommit(pool, 2, std::chrono::microseconds(1)),
+      SlowQueue{a, &mutex, &threads}, constant(5),
+      SlowQueue{b, &mutex, &threads});
+    a->push(1);
+    REQUIRE(handler.commit(0) == State::NONE);
+    b->push(2);
+    REQUIRE(handler.commit(1) == State::EVALUATED);
+    REQUIRE(handler.get<0>().eval() == 1);
+    REQUIRE(handler.get<2>().eval() == 2);
+    b->set_complete();
+    REQUIRE(handler.commit(2) == State::NONE);
+    a->set_complete();
+    REQUIRE(handler.commit(3) == State::COMPLETE);
+  }
+
+  TEST_CASE("dirty") {
+    auto pool = CommitPool(4);
+    auto mutex = std::mutex();
+    auto threads = std::set<std::thread::id>();
+    auto queues = std::vector<Shared<Queue<int>>>();
+    auto children = std::vector<SlowQueue>();
+    for(auto i = 0; i != 16; ++i) {
+      queues.emplace_back();
+      queues.back()->push(i);
+      children.push_back(SlowQueue{queues.back(), &mutex, &threads});
+    }
+    auto handler = ParallelCommitHandler(
+      ParallelCommit(pool, 2, std::chrono::microseconds(1)),
+      std::move(children), CommitPolicy::DIRTY);
+    REQUIRE(handler.commit(0) == State::EVALUATED);
+    REQUIRE(handler.commit(1) == State::NONE);
+    queues[3]->push(7);
+    queues[9]->push(8);
+    REQUIRE(handler.commit(2) == State::EVALUATED);
+    REQUIRE(handler.get(3).eval() == 7);
+    REQUIRE(handler.get(9).eval() == 8);
+  }
+
+  TEST_CASE("timers") {
+    auto pool = CommitPool(4);
+    auto mutex = std::mutex();
+    auto threads = std::set<std::thread::id>();
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, std::chrono::milliseconds(1));
+    auto trigger = Trigger();
+    Trigger::set_trigger(trigger);
+    TimerWheel::set_wheel(&wheel);
+    auto children = std::vector<SlowTimer>();
+    for(auto i = 0; i != 16; ++i) {
+      children.push_back(SlowTimer{Timer(std::chrono::milliseconds(10 + i)),
+        &mutex, &threads});
+    }
+    auto handler = ParallelCommitHandler(
+      ParallelCommit(pool, 2, std::chrono::nanoseconds(0)),
+      std::move(children));
+    REQUIRE(handler.commit(0) == State::NONE);
+    REQUIRE(threads.size() > 1);
+    REQUIRE(!wheel.is_empty());
+    wheel.advance(start + std::chrono::milliseconds(100));
+    REQUIRE(handler.commit(1) == State::COMPLETE_EVALUATED);
+    for(auto i = std::size_t(0); i != handler.size(); ++i) {
+      REQUIRE(handler.get(i).eval() ==
+        start + std::chrono::milliseconds(10 + i));
+    }
+    REQUIRE(wheel.is_empty());
+    TimerWheel::set_wheel(nullptr);
+    Trigger::set_trigger(nullptr);
+  }
+}
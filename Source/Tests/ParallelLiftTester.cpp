@@ -0,0 +1,106 @@
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <doctest/doctest.h>
+#include "Aspen/ParallelLift.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+#if defined (__linux__)
+  #include "Aspen/EpollExecutor.hpp"
+#endif
+
+using namespace Aspen;
+
+namespace {
+  struct SlowQueue {
+    using Type = int;
+    Shared<Queue<int>> m_queue;
+    std::mutex* m_mutex;
+    std::set<std::thread::id>* m_threads;
+
+    State commit(int sequence) noexcept {
+      {
+        auto lock = std::lock_guard(*m_mutex);
+        m_threads->insert(std::this_thread::get_id());
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return m_queue.commit(sequence);
+    }
+
+    const int& eval() const {
+      return m_queue.eval();
+    }
+  };
+}
+
+TEST_SUITE("ParallelLift") {
+  TEST_CASE("commit") {
+    auto pool = CommitPool(4);
+    auto mutex = std::mutex();
+    auto threads = std::set<std::thread::id>();
+    auto a = Shared(Queue<int>());
+    auto b = Shared(Queue<int>());
+    auto c = Shared(Queue<int>());
+    auto reactor = parallel_lift(
+      ParallelCommit(pool, 2, std::chrono::microseconds(1)),
+      [] (int a, int b, int c) {
+        return a + b + c;
+      }, SlowQueue{a, &mutex, &threads}, SlowQueue{b, &mutex, &threads},
+      SlowQueue{c, &mutex, &threads});
+    REQUIRE(reactor.commit(0) == State::NONE);
+    a->push(1);
+    b->push(2);
+    c->push(3);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 6);
+    REQUIRE(threads.size() > 1);
+    b->push(10);
+    REQUIRE(reactor.commit(2) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 14);
+  }
+
+  TEST_CASE("complete") {
+    auto pool = CommitPool(4);
+    auto a = Shared(Queue<int>());
+    auto b = Shared(Queue<int>());
+    auto reactor = parallel_lift(
+      ParallelCommit(pool, 2, std::chrono::nanoseconds(0)),
+      [] (int a, int b) {
+        return a * b;
+      }, a, b);
+    a->push(2);
+    b->push(3);
+    a->set_complete();
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 6);
+    b->push(4);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 8);
+    b->set_complete();
+    REQUIRE(reactor.commit(2) == State::COMPLETE);
+  }
+
+#if defined (__linux__)
+  TEST_CASE("epoll_executor") {
+    auto pool = CommitPool(4);
+    auto executors = std::array<EpollExecutor*, 4>();
+    auto recorder = [&] (std::size_t i) {
+      return lift([&, i] {
+        executors[i] = EpollExecutor::get_executor();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return 0;
+      });
+    };
+    auto executor = EpollExecutor(parallel_lift(
+      ParallelCommit(pool, 2, std::chrono::nanoseconds(0)),
+      [] (int, int, int, int) {}, recorder(0), recorder(1), recorder(2),
+      recorder(3)));
+    executor.run_until_none();
+    for(auto e : executors) {
+      REQUIRE(e == &executor);
+    }
+  }
+#endif
+}
@@ -81,4 +81,23 @@ TEST_SUITE("Range") {
     end_queue->set_complete();
     REQUIRE(reactor.commit(6) == State::COMPLETE);
   }
+
+  TEST_CASE("range_step") {
+    auto reactor = range(constant(0), constant(5), constant(2));
+    REQUIRE(reactor.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 0);
+    REQUIRE(reactor.commit(1) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 2);
+    REQUIRE(reactor.commit(2) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 4);
+  }
+
+  TEST_CASE("end_complete_before_start") {
+    auto start_queue = Shared(Queue<int>());
+    auto reactor = range(start_queue, constant(3));
+    REQUIRE(reactor.commit(0) == State::NONE);
+    start_queue->push(2);
+    REQUIRE(reactor.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 2);
+  }
 }
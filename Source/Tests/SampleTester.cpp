@@ -0,0 +1,40 @@
+#include <doctest/doctest.h>
+#include "Aspen/Lift.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Sample.hpp"
+#include "Aspen/Shared.hpp"
+
+using namespace Aspen;
+
+TEST_SUITE("Sample") {
+  TEST_CASE("sample_first_evaluation") {
+    auto queue = Shared(Queue<int>());
+    auto reactor = sample(queue);
+    REQUIRE(reactor.commit(0) == State::NONE);
+    queue->push(1);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+    queue->push(2);
+    REQUIRE(reactor.commit(2) == State::NONE);
+    REQUIRE(reactor.eval() == 2);
+    queue->set_complete();
+    REQUIRE(reactor.commit(3) == State::COMPLETE);
+  }
+
+  TEST_CASE("sample_lift") {
+    auto trigger = Shared(Queue<int>());
+    auto value = Shared(Queue<int>());
+    auto reactor = lift([] (int trigger, int value) {
+      return trigger * value;
+    }, trigger, sample(value));
+    value->push(3);
+    trigger->push(1);
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 3);
+    value->push(5);
+    REQUIRE(reactor.commit(1) == State::NONE);
+    trigger->push(2);
+    REQUIRE(reactor.commit(2) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 10);
+  }
+}
@@ -1,7 +1,9 @@
+#include <vector>
 #include <doctest/doctest.h>
 #include "Aspen/Chain.hpp"
 #include "Aspen/Constant.hpp"
 #include "Aspen/None.hpp"
+#include "Aspen/Queue.hpp"
 #include "Aspen/Shared.hpp"
 
 using namespace Aspen;
@@ -46,4 +48,42 @@ TEST_SUITE("Shared") {
     REQUIRE(b.commit(3) == State::COMPLETE_EVALUATED);
     REQUIRE(b.eval() == 321);
   }
+
+  TEST_CASE("local_shared") {
+    auto s1 = local_shared(Queue<int>());
+    auto s2 = s1;
+    s1->push(1);
+    s1->push(2);
+    REQUIRE(s1.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(s1.eval() == 1);
+    REQUIRE(s2.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(s2.eval() == 1);
+    auto s3 = std::move(s2);
+    REQUIRE(s3.commit(1) == State::EVALUATED);
+    REQUIRE(s3.eval() == 2);
+    s2 = s3;
+    REQUIRE(s2.commit(1) == State::EVALUATED);
+    REQUIRE(s2.eval() == 2);
+  }
+
+  TEST_CASE("local_shared_to_shared_box") {
+    auto c = local_shared(Constant(123));
+    auto b = LocalShared<Box<int>>(c);
+    REQUIRE(b.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(b.eval() == 123);
+    REQUIRE(c.commit(0) == State::COMPLETE_EVALUATED);
+  }
+
+  TEST_CASE("local_shared_many_nodes") {
+    auto queue = local_shared(Queue<int>());
+    auto nodes = std::vector<LocalShared<Box<int>>>();
+    for(auto i = 0; i != 100000; ++i) {
+      nodes.emplace_back(queue);
+    }
+    queue->push(5);
+    for(auto& node : nodes) {
+      REQUIRE(node.commit(0) == State::EVALUATED);
+      REQUIRE(node.eval() == 5);
+    }
+  }
 }
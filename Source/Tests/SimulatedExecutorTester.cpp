@@ -0,0 +1,67 @@
+#include <chrono>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Lift.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+#include "Aspen/SimulatedExecutor.hpp"
+#include "Aspen/Timer.hpp"
+
+using namespace Aspen;
+using namespace std::chrono_literals;
+
+TEST_SUITE("SimulatedExecutor") {
+  TEST_CASE("events") {
+    auto queue = Shared(Queue<int>());
+    auto results = std::vector<int>();
+    auto executor = SimulatedExecutor(
+      lift([&] (int value) {
+        results.push_back(value);
+      }, queue));
+    auto start = executor.get_time();
+    executor.schedule(start + 20ms, [&] { queue->push(2); });
+    executor.schedule(start + 10ms, [&] { queue->push(1); });
+    executor.schedule(start + 20ms, [&] { queue->push(3); });
+    executor.schedule(start + 30ms, [&] { queue->set_complete(4); });
+    executor.run_until_complete();
+    REQUIRE(results == std::vector{1, 2, 3, 4});
+    REQUIRE(executor.get_time() == start + 30ms);
+  }
+
+  TEST_CASE("timers") {
+    auto times = std::vector<TimerWheel::TimePoint>();
+    auto executor = SimulatedExecutor(
+      lift([&] (const TimerWheel::TimePoint& time) {
+        times.push_back(time);
+      }, timer(1h)));
+    executor.run_until_complete();
+    REQUIRE(times.size() == 1);
+    REQUIRE(times.front() == TimerWheel::TimePoint() + 1h);
+    REQUIRE(executor.get_time() == TimerWheel::TimePoint() + 1h);
+  }
+
+  TEST_CASE("reproducible") {
+    auto run = [] {
+      auto queue = Shared(Queue<int>());
+      auto results = std::vector<int>();
+      auto executor = SimulatedExecutor(
+        lift([&] (int value) {
+          results.push_back(value);
+        }, queue));
+      auto start = executor.get_time();
+      auto seed = 7u;
+      for(auto i = 0; i != 100000; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        executor.schedule(start + std::chrono::microseconds(seed % 1000),
+          [&, i] { queue->push(i); });
+      }
+      executor.schedule(start + 1s, [&] { queue->set_complete(); });
+      executor.run_until_complete();
+      return results;
+    };
+    auto first = run();
+    auto second = run();
+    REQUIRE(first.size() == 100000);
+    REQUIRE(first == second);
+  }
+}
@@ -1,3 +1,4 @@
+#include <bitset>
 #include <doctest/doctest.h>
 #include "Aspen/StaticCommitHandler.hpp"
 #include "Aspen/Queue.hpp"
@@ -44,4 +45,37 @@ TEST_SUITE("StaticCommitHandler") {
     REQUIRE(reactor.commit(1) == State::EVALUATED);
     REQUIRE(reactor.commit(2) == State::NONE);
   }
+
+  TEST_CASE("static_constants") {
+    REQUIRE(sizeof(Details::StaticChild<Constant<int>>) == sizeof(int));
+    auto reactor = StaticCommitHandler(constant(1), Queue<int>(), constant(2));
+    REQUIRE(reactor.commit(0) == State::NONE);
+    reactor.get<1>().push(3);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.get<0>().eval() == 1);
+    REQUIRE(reactor.get<2>().eval() == 2);
+    reactor.get<1>().set_complete(4);
+    REQUIRE(reactor.commit(2) == State::COMPLETE_EVALUATED);
+    auto constants = StaticCommitHandler(constant(1), constant(2));
+    REQUIRE(constants.commit(0) == State::COMPLETE_EVALUATED);
+  }
+
+  TEST_CASE("static_evaluations") {
+    auto reactor = StaticCommitHandler(Queue<int>(), constant(5),
+      Queue<int>());
+    reactor.get<0>().push(1);
+    reactor.get<2>().push(2);
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    REQUIRE(reactor.get_evaluations() == std::bitset<3>("101"));
+    reactor.get<2>().push(3);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.get_evaluations() == std::bitset<3>("100"));
+    reactor.get<0>().push(4);
+    reactor.get<0>().set_complete();
+    REQUIRE(reactor.commit(2) == State::EVALUATED);
+    REQUIRE(reactor.get_evaluations() == std::bitset<3>("001"));
+    reactor.get<2>().push(5);
+    REQUIRE(reactor.commit(3) == State::EVALUATED);
+    REQUIRE(reactor.get_evaluations() == std::bitset<3>("100"));
+  }
 }
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Executor.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/Timer.hpp"
+
+using namespace Aspen;
+using namespace std::chrono_literals;
+
+TEST_SUITE("Timer") {
+  TEST_CASE("no_wheel") {
+    auto reactor = timer(1ms);
+    REQUIRE(reactor.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE_THROWS_AS(reactor.eval(), std::runtime_error);
+  }
+
+  TEST_CASE("timer") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    TimerWheel::set_wheel(&wheel);
+    auto signals = 0;
+    auto trigger = Trigger([&] { ++signals; });
+    Trigger::set_trigger(trigger);
+    auto reactor = timer(10ms);
+    REQUIRE(reactor.commit(0) == State::NONE);
+    wheel.advance(start + 5ms);
+    REQUIRE(reactor.commit(1) == State::NONE);
+    REQUIRE(signals == 0);
+    wheel.advance(start + 10ms);
+    REQUIRE(signals == 1);
+    REQUIRE(reactor.commit(2) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == start + 10ms);
+    Trigger::set_trigger(nullptr);
+    TimerWheel::set_wheel(nullptr);
+  }
+
+  TEST_CASE("deadline") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    TimerWheel::set_wheel(&wheel);
+    auto trigger = Trigger([] {});
+    Trigger::set_trigger(trigger);
+    auto expired = deadline(start);
+    REQUIRE(expired.commit(0) == State::COMPLETE_EVALUATED);
+    auto pending = deadline(start + 3ms);
+    REQUIRE(pending.commit(0) == State::NONE);
+    wheel.advance(start + 3ms);
+    REQUIRE(pending.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE(pending.eval() == start + 3ms);
+    Trigger::set_trigger(nullptr);
+    TimerWheel::set_wheel(nullptr);
+  }
+
+  TEST_CASE("interval") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    TimerWheel::set_wheel(&wheel);
+    auto trigger = Trigger([] {});
+    Trigger::set_trigger(trigger);
+    auto reactor = interval(10ms);
+    REQUIRE(reactor.commit(0) == State::NONE);
+    wheel.advance(start + 10ms);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+    REQUIRE(reactor.commit(2) == State::NONE);
+    wheel.advance(start + 35ms);
+    REQUIRE(reactor.commit(3) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 3);
+    wheel.advance(start + 40ms);
+    REQUIRE(reactor.commit(4) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 4);
+    Trigger::set_trigger(nullptr);
+    TimerWheel::set_wheel(nullptr);
+  }
+
+  TEST_CASE("interval_without_wheel") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    TimerWheel::set_wheel(&wheel);
+    auto trigger = Trigger([] {});
+    Trigger::set_trigger(trigger);
+    auto reactor = interval(2ms);
+    REQUIRE(reactor.commit(0) == State::NONE);
+    wheel.advance(start + 2ms);
+    TimerWheel::set_wheel(nullptr);
+    REQUIRE(reactor.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE_THROWS_AS(reactor.eval(), std::runtime_error);
+    Trigger::set_trigger(nullptr);
+  }
+
+  TEST_CASE("executor") {
+    for(auto strategy : {WaitStrategy::BLOCK, WaitStrategy::SPIN,
+        WaitStrategy::YIELD, WaitStrategy::PARK}) {
+      auto results = std::vector<TimerWheel::TimePoint>();
+      auto start = TimerWheel::Clock::now();
+      auto executor = Executor(
+        lift([&] (const auto& value) {
+          results.push_back(value);
+        }, timer(10ms)), strategy);
+      executor.run_until_complete();
+      REQUIRE(results.size() == 1);
+      REQUIRE(TimerWheel::Clock::now() - start >= 10ms);
+    }
+  }
+}
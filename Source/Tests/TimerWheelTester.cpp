@@ -0,0 +1,157 @@
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/TimerWheel.hpp"
+
+using namespace Aspen;
+using namespace std::chrono_literals;
+
+TEST_SUITE("TimerWheel") {
+  TEST_CASE("expire") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    auto signals = 0;
+    auto trigger = Trigger([&] { ++signals; });
+    auto entry = TimerWheel::Entry();
+    REQUIRE(wheel.is_empty());
+    wheel.add(entry, start + 10ms, &trigger);
+    REQUIRE(!wheel.is_empty());
+    REQUIRE(entry.is_pending());
+    REQUIRE(wheel.get_next_expiry() == start + 10ms);
+    wheel.advance(start + 9ms);
+    REQUIRE(signals == 0);
+    REQUIRE(!entry.is_expired());
+    wheel.advance(start + 10ms);
+    REQUIRE(signals == 1);
+    REQUIRE(entry.is_expired());
+    REQUIRE(!entry.is_pending());
+    REQUIRE(wheel.is_empty());
+    REQUIRE(wheel.get_time() == start + 10ms);
+  }
+
+  TEST_CASE("cancel") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    auto signals = 0;
+    auto trigger = Trigger([&] { ++signals; });
+    auto entry = TimerWheel::Entry();
+    wheel.add(entry, start + 5ms, &trigger);
+    {
+      auto temporary = TimerWheel::Entry();
+      wheel.add(temporary, start + 5ms, &trigger);
+    }
+    wheel.remove(entry);
+    REQUIRE(wheel.is_empty());
+    wheel.advance(start + 100ms);
+    REQUIRE(signals == 0);
+    REQUIRE(!entry.is_expired());
+  }
+
+  TEST_CASE("reschedule") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    auto signals = 0;
+    auto trigger = Trigger([&] { ++signals; });
+    auto entry = TimerWheel::Entry();
+    wheel.add(entry, start + 5ms, &trigger);
+    wheel.add(entry, start + 500ms, &trigger);
+    wheel.advance(start + 499ms);
+    REQUIRE(signals == 0);
+    wheel.advance(start + 500ms);
+    REQUIRE(signals == 1);
+  }
+
+  TEST_CASE("many_timers") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    auto expired = std::vector<int>();
+    auto triggers = std::deque<Trigger>();
+    const auto OFFSETS = {1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144,
+      300000, 20000000, 40000000};
+    auto entries = std::vector<TimerWheel::Entry>(OFFSETS.size());
+    auto count = 0;
+    for(auto offset : OFFSETS) {
+      triggers.emplace_back([&expired, offset] {
+        expired.push_back(offset);
+      });
+      wheel.add(entries[count], start + offset * 1ms, &triggers.back());
+      ++count;
+    }
+    for(auto offset : OFFSETS) {
+      wheel.advance(start + (offset - 1) * 1ms);
+      REQUIRE((expired.empty() || expired.back() < offset));
+      wheel.advance(start + offset * 1ms);
+      REQUIRE(!expired.empty());
+      REQUIRE(expired.back() == offset);
+    }
+    REQUIRE(expired.size() == OFFSETS.size());
+    REQUIRE(wheel.is_empty());
+  }
+
+  TEST_CASE("next_expiry") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    auto trigger = Trigger([] {});
+    auto entry = TimerWheel::Entry();
+    REQUIRE(!wheel.get_next_expiry().has_value());
+    wheel.add(entry, start + 1000ms, &trigger);
+    auto expiry = *wheel.get_next_expiry();
+    REQUIRE(expiry > start);
+    REQUIRE(expiry <= start + 1000ms);
+    while(!entry.is_expired()) {
+      wheel.advance(*wheel.get_next_expiry());
+    }
+    REQUIRE(wheel.get_time() == start + 1000ms);
+  }
+
+  TEST_CASE("next_deadline") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    auto trigger = Trigger([] {});
+    auto early = TimerWheel::Entry();
+    auto late = TimerWheel::Entry();
+    REQUIRE(!wheel.get_next_deadline().has_value());
+    wheel.add(late, start + 100000ms, &trigger);
+    wheel.add(early, start + 1000ms, &trigger);
+    REQUIRE(*wheel.get_next_expiry() < start + 1000ms);
+    REQUIRE(wheel.get_next_deadline() == start + 1000ms);
+    wheel.advance(*wheel.get_next_deadline());
+    REQUIRE(early.is_expired());
+    REQUIRE(!late.is_expired());
+    REQUIRE(wheel.get_next_deadline() == start + 100000ms);
+    wheel.advance(*wheel.get_next_deadline());
+    REQUIRE(late.is_expired());
+    REQUIRE(wheel.get_time() == start + 100000ms);
+  }
+
+  TEST_CASE("share") {
+    auto start = TimerWheel::TimePoint();
+    auto wheel = TimerWheel(start, 1ms);
+    auto trigger = Trigger([] {});
+    auto entries = std::deque<TimerWheel::Entry>(1000);
+    wheel.share();
+    auto threads = std::vector<std::thread>();
+    for(auto i = 0; i != 4; ++i) {
+      threads.emplace_back([&, i] {
+        for(auto j = i; j < static_cast<int>(entries.size()); j += 4) {
+          wheel.add(entries[j], start + std::chrono::milliseconds(j + 1),
+            &trigger);
+          if(j % 2 == 1) {
+            wheel.remove(entries[j]);
+          }
+        }
+      });
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+    wheel.unshare();
+    for(auto i = std::size_t(0); i != entries.size(); ++i) {
+      REQUIRE(entries[i].is_pending() == (i % 2 == 0));
+    }
+    wheel.advance(start + 1000ms);
+    REQUIRE(wheel.is_empty());
+  }
+}
@@ -0,0 +1,158 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Cell.hpp"
+#include "Aspen/Executor.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+#include "Aspen/Transaction.hpp"
+
+using namespace Aspen;
+
+TEST_SUITE("Transaction") {
+  TEST_CASE("cells") {
+    auto signals = 0;
+    auto trigger = Trigger([&] { ++signals; });
+    Trigger::set_trigger(trigger);
+    auto a = Shared(Cell(1));
+    auto b = Shared(Cell(2));
+    auto evaluations = 0;
+    auto reactor = lift([&] (int x, int y) {
+      ++evaluations;
+      return x + y;
+    }, a, b);
+    REQUIRE(reactor.commit(0) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 3);
+    auto transaction = Transaction();
+    transaction.set(*a, 10);
+    transaction.set(*b, 20);
+    REQUIRE(signals == 0);
+    transaction.publish();
+    REQUIRE(signals == 1);
+    REQUIRE(reactor.commit(1) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 30);
+    REQUIRE(evaluations == 2);
+    Trigger::set_trigger(nullptr);
+  }
+
+  TEST_CASE("mid_sequence") {
+    auto trigger = Trigger([] {});
+    Trigger::set_trigger(trigger);
+    auto a = Cell(1);
+    auto b = Cell(2);
+    REQUIRE(a.commit(0) == State::EVALUATED);
+    REQUIRE(b.commit(0) == State::EVALUATED);
+    REQUIRE(a.commit(1) == State::NONE);
+    auto transaction = Transaction();
+    transaction.set(a, 10);
+    transaction.set(b, 20);
+    transaction.publish();
+    REQUIRE(b.commit(1) == State::CONTINUE);
+    REQUIRE(b.eval() == 2);
+    REQUIRE(a.commit(2) == State::EVALUATED);
+    REQUIRE(b.commit(2) == State::EVALUATED);
+    REQUIRE(a.eval() == 10);
+    REQUIRE(b.eval() == 20);
+    Trigger::set_trigger(nullptr);
+  }
+
+  TEST_CASE("multiple_executors") {
+    auto first = Trigger([] {});
+    auto second = Trigger([] {});
+    auto a = Cell(1);
+    auto b = Cell(2);
+    Trigger::set_trigger(first);
+    REQUIRE(a.commit(0) == State::EVALUATED);
+    Trigger::set_trigger(second);
+    REQUIRE(b.commit(0) == State::EVALUATED);
+    Trigger::set_trigger(nullptr);
+    auto transaction = Transaction();
+    transaction.set(a, 10);
+    transaction.set(b, 20);
+    REQUIRE_THROWS_AS(transaction.publish(), std::runtime_error);
+    transaction.set(a, 30);
+    Trigger::set_trigger(first);
+    transaction.publish();
+    REQUIRE(a.commit(1) == State::EVALUATED);
+    REQUIRE(a.eval() == 30);
+    REQUIRE(b.commit(1) == State::NONE);
+    REQUIRE(b.eval() == 2);
+    Trigger::set_trigger(nullptr);
+  }
+
+  TEST_CASE("queue_order") {
+    auto trigger = Trigger([] {});
+    Trigger::set_trigger(trigger);
+    auto queue = Queue<int>();
+    REQUIRE(queue.commit(0) == State::NONE);
+    queue.push(1);
+    auto transaction = Transaction();
+    transaction.push(queue, 2);
+    transaction.push(queue, 3);
+    transaction.publish();
+    queue.push(4);
+    auto values = std::vector<int>();
+    for(auto sequence = 1; sequence != 10; ++sequence) {
+      auto state = queue.commit(sequence);
+      if(has_evaluation(state)) {
+        values.push_back(queue.eval());
+      }
+      if(state == State::NONE) {
+        break;
+      }
+    }
+    REQUIRE(values == std::vector{1, 2, 3, 4});
+    Trigger::set_trigger(nullptr);
+  }
+
+  TEST_CASE("unpublished") {
+    auto trigger = Trigger([] {});
+    Trigger::set_trigger(trigger);
+    auto cell = Cell(5);
+    REQUIRE(cell.commit(0) == State::EVALUATED);
+    {
+      auto transaction = Transaction();
+      transaction.set(cell, 6);
+    }
+    REQUIRE(cell.commit(1) == State::NONE);
+    REQUIRE(cell.eval() == 5);
+    Trigger::set_trigger(nullptr);
+  }
+
+  TEST_CASE("atomic_snapshots") {
+    const auto COUNT = 1000;
+    auto a = Shared(Cell(0));
+    auto b = Shared(Cell(0));
+    auto c = Shared(Queue<int>());
+    auto is_consistent = true;
+    auto last = 0;
+    auto executor = Executor(
+      lift([&] (int x, int y, int z) {
+        if(x + y != 0 || z > x) {
+          is_consistent = false;
+        }
+        last = x;
+      }, a, b, c));
+    auto transaction = Transaction();
+    transaction.push(*c, 0);
+    transaction.publish();
+    auto executor_thread = std::thread([&] {
+      executor.run_until_complete();
+    });
+    for(auto i = 1; i <= COUNT; ++i) {
+      transaction.set(*a, i);
+      transaction.set(*b, -i);
+      transaction.push(*c, i);
+      transaction.publish();
+    }
+    a->set_complete();
+    b->set_complete();
+    c->set_complete();
+    executor_thread.join();
+    REQUIRE(is_consistent);
+    REQUIRE(last == COUNT);
+  }
+}
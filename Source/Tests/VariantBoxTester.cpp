@@ -0,0 +1,65 @@
+#include <stdexcept>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Aspen/Constant.hpp"
+#include "Aspen/Lift.hpp"
+#include "Aspen/Queue.hpp"
+#include "Aspen/Shared.hpp"
+#include "Aspen/VariantBox.hpp"
+
+using namespace Aspen;
+
+namespace {
+  auto make_double(Shared<Queue<int>> queue) {
+    return lift([] (int value) {
+      return 2 * value;
+    }, std::move(queue));
+  }
+
+  auto make_negate(Shared<Queue<int>> queue) {
+    return lift([] (int value) {
+      if(value == 0) {
+        throw std::runtime_error("Zero.");
+      }
+      return -value;
+    }, std::move(queue));
+  }
+
+  using Strategy = VariantBox<decltype(make_double(std::declval<
+    Shared<Queue<int>>>())), decltype(make_negate(std::declval<
+    Shared<Queue<int>>>())), Constant<int>>;
+}
+
+TEST_SUITE("VariantBox") {
+  TEST_CASE("constant") {
+    auto reactor = Strategy(Constant(5));
+    REQUIRE(reactor.index() == 2);
+    REQUIRE(reactor.commit(0) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 5);
+  }
+
+  TEST_CASE("strategies") {
+    auto queue = Shared(Queue<int>());
+    auto strategies = std::vector<Strategy>();
+    strategies.emplace_back(make_double(queue));
+    strategies.emplace_back(make_negate(queue));
+    REQUIRE(strategies[0].index() == 0);
+    REQUIRE(strategies[1].index() == 1);
+    queue->push(3);
+    REQUIRE(strategies[0].commit(0) == State::EVALUATED);
+    REQUIRE(strategies[0].eval() == 6);
+    REQUIRE(strategies[1].commit(0) == State::EVALUATED);
+    REQUIRE(strategies[1].eval() == -3);
+    queue->push(0);
+    REQUIRE(strategies[1].commit(1) == State::EVALUATED);
+    REQUIRE(strategies[1].get_error());
+    REQUIRE_THROWS_AS(strategies[1].eval(), std::runtime_error);
+  }
+
+  TEST_CASE("in_place") {
+    auto reactor = VariantBox<Constant<int>, Queue<int>>(
+      std::in_place_type<Queue<int>>);
+    REQUIRE(reactor.index() == 1);
+    REQUIRE(reactor.commit(0) == State::NONE);
+  }
+}
@@ -40,4 +40,21 @@ TEST_SUITE("Weak") {
     REQUIRE(s3.commit(2) == State::COMPLETE);
     REQUIRE(s3.eval() == 10);
   }
+
+  TEST_CASE("weak_local") {
+    auto s1 = std::optional<LocalShared<Queue<int>>>();
+    s1.emplace();
+    auto s2 = Weak(*s1);
+    auto s3 = s2;
+    (*s1)->push(5);
+    (*s1)->push(10);
+    REQUIRE(s2.commit(0) == State::CONTINUE_EVALUATED);
+    REQUIRE(s2.eval() == 5);
+    REQUIRE(s3.lock().has_value());
+    s1 = std::nullopt;
+    REQUIRE(!s3.lock().has_value());
+    REQUIRE(s3.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE(s3.eval() == 5);
+    REQUIRE(s2.commit(1) == State::COMPLETE);
+  }
 }